@@ -0,0 +1,110 @@
+/*
+ * i2cbus.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef INC_I2CBUS_H_
+#define INC_I2CBUS_H_
+
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
+
+#define I2CBUS_QUEUE_SIZE 8        // 우선순위별 대기 큐 크기
+#define I2CBUS_TIMEOUT_MS 20       // 트랜잭션 하나가 이 시간 안에 끝나지 않으면 버스를 복구하고 I2CBUS_TIMEOUT으로 끝냄
+
+// 스케줄러 태스크 주기 (I2CBUS_Task가 타임아웃을 확인하고 버스를 복구하는 주기, ms)
+#define I2CBUS_TASK_PERIOD_MS 10
+
+// 정의하면 버스 복구 때 SCL을 GPIO로 9번 토글해서, 바이트 중간에 멈춰 SDA를 잡고 있는 슬레이브를 풀어줍니다.
+// 정의하지 않으면 I²C 주변장치만 다시 초기화합니다.
+//#define I2CBUS_RECOVERY_PINS
+#define I2CBUS_SCL_PORT GPIOB
+#define I2CBUS_SCL_PIN GPIO_PIN_8
+#define I2CBUS_SDA_PORT GPIOB
+#define I2CBUS_SDA_PIN GPIO_PIN_9
+
+// 우선순위 (높은 쪽 큐가 비어야 낮은 쪽 큐를 시작, 진행 중인 트랜잭션은 끊지 않음)
+typedef enum {
+    I2CBUS_PRIO_HIGH,   // 센서 읽기 등 지연에 민감한 트랜잭션
+    I2CBUS_PRIO_LOW,    // LCD 갱신 등
+    I2CBUS_PRIO_COUNT
+} I2CBUS_Priority;
+
+// 트랜잭션 결과
+typedef enum {
+    I2CBUS_OK,
+    I2CBUS_NACK,        // 슬레이브가 응답하지 않음 (버스는 정상)
+    I2CBUS_BUS_ERROR,   // 버스 오류, arbitration lost 등 (버스를 복구함)
+    I2CBUS_TIMEOUT      // I2CBUS_TIMEOUT_MS 안에 끝나지 않음 (버스를 복구함)
+} I2CBUS_Result;
+
+// 완료 콜백 (인터럽트에서 호출됨, 콜백 안에서 다음 트랜잭션을 요청해도 됨)
+typedef void (*I2CBUS_Callback)(I2CBUS_Result result, void *context);
+
+// 버스 통계
+typedef struct {
+    uint32_t elapsed_ms;      // I2CBUS_Init 또는 I2CBUS_ResetStats 이후 지난 시간
+    uint32_t submitted;       // 큐에 들어간 트랜잭션 수
+    uint32_t completed;       // 정상적으로 끝난 트랜잭션 수
+    uint32_t nacks;
+    uint32_t bus_errors;
+    uint32_t timeouts;
+    uint32_t recoveries;      // 버스 복구 횟수
+    uint32_t dropped;         // 큐가 가득 차서 거절한 요청 수
+    uint32_t bytes;           // 전송한 바이트 수 (주소 바이트 포함, 사용률 = bytes * 9 / (버스 클럭 * elapsed_ms / 1000))
+    uint32_t total_wait_ms;   // 요청부터 전송 시작까지 기다린 시간의 합 (평균 = total_wait_ms / (completed + 실패 수))
+    uint32_t max_wait_ms;
+    uint8_t max_depth[I2CBUS_PRIO_COUNT];  // 우선순위별 최대 대기 트랜잭션 수
+} I2CBUS_Stats;
+
+/**
+ * @brief 버스 관리자 초기화 (같은 핸들로 다시 호출하면 아무것도 하지 않음)
+ * @param hi2c: CubeMX에서 설정한 I²C 핸들 (I2C event/error interrupt 활성화)
+ */
+void I2CBUS_Init(I2C_HandleTypeDef *hi2c);
+
+/**
+ * @brief 쓰기 / 읽기 / 쓰고 나서 반복 시작으로 읽기(레지스터 읽기) 트랜잭션을 큐에 추가
+ * @param addr: 7비트 슬레이브 주소
+ * @param callback: 트랜잭션이 끝나면 호출될 함수 (NULL 가능)
+ * @note 데이터는 복사하지 않으므로 콜백이 호출될 때까지 버퍼를 유지해야 함
+ *       인터럽트에서 호출 가능
+ * @retval HAL_OK: 큐에 추가됨, HAL_BUSY: 큐가 가득 참, HAL_ERROR: 초기화 전이거나 잘못된 인자
+ */
+HAL_StatusTypeDef I2CBUS_Write(uint8_t addr, const uint8_t *data, uint16_t len,
+                               I2CBUS_Priority prio, I2CBUS_Callback callback, void *context);
+HAL_StatusTypeDef I2CBUS_Read(uint8_t addr, uint8_t *data, uint16_t len,
+                              I2CBUS_Priority prio, I2CBUS_Callback callback, void *context);
+HAL_StatusTypeDef I2CBUS_WriteRead(uint8_t addr, const uint8_t *wdata, uint16_t wlen, uint8_t *rdata, uint16_t rlen,
+                                   I2CBUS_Priority prio, I2CBUS_Callback callback, void *context);
+
+/**
+ * @brief blocking 쓰기 (진행 중인 트랜잭션 하나만 끝나기를 기다린 뒤 전송, 인터럽트 없이도 동작)
+ * @note 큐에서 대기 중인 트랜잭션보다 먼저 전송됨
+ *       메인 루프에서만 호출 (초기화 등), 실패하면 다음 I2CBUS_Task에서 버스를 복구함
+ */
+HAL_StatusTypeDef I2CBUS_WriteBlocking(uint8_t addr, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief 진행 중이거나 대기 중인 트랜잭션이 있으면 1
+ */
+uint8_t I2CBUS_IsBusy(void);
+
+/**
+ * @brief 타임아웃 확인, 버스 복구, HAL이 시작을 거절한 트랜잭션 재시도 (스케줄러용 태스크)
+ * @note 반드시 주기적으로 호출해야 함: 버스 오류가 나면 인터럽트에서는 복구를 예약만 하고,
+ *       이 함수가 복구할 때까지 대기 중인 트랜잭션을 시작하지 않음
+ */
+void I2CBUS_Task(void);
+
+// HAL 콜백에서 호출 필요 (다른 I²C 핸들이면 무시)
+void I2CBUS_TxCpltCallback(I2C_HandleTypeDef *hi2c);  // HAL_I2C_MasterTxCpltCallback
+void I2CBUS_RxCpltCallback(I2C_HandleTypeDef *hi2c);  // HAL_I2C_MasterRxCpltCallback
+void I2CBUS_ErrorCallback(I2C_HandleTypeDef *hi2c);   // HAL_I2C_ErrorCallback
+
+void I2CBUS_GetStats(I2CBUS_Stats *stats);
+void I2CBUS_ResetStats(void);
+
+
+#endif /* INC_I2CBUS_H_ */
@@ -13,6 +13,7 @@
   * GPIO Configuration (in STM32CubeMX):
   * Rows (R1-R4) -> PC0, PC1, PC2, PC3 : GPIO_Output, Push-Pull, No pull-up/down
   * Columns (C1-C4) -> PC6, PC7, PC8, PC9 : GPIO_Input, Pull-up
+  *   (KEYPAD16_Init_IT 사용 시: GPIO_EXTI, Falling edge, Pull-up + EXTI9_5 NVIC 활성화)
   *
   ******************************************************************************
   */
@@ -49,6 +50,56 @@
 #define C4_PORT GPIOC
 #define C4_PIN  GPIO_PIN_9
 
+// 행(Row)/열(Column) 핀 전체 마스크, EXTI 라인 번호는 핀 번호와 같습니다.
+#define KEYPAD16_ROW_PINS (R1_PIN | R2_PIN | R3_PIN | R4_PIN)
+#define KEYPAD16_COL_PINS (C1_PIN | C2_PIN | C3_PIN | C4_PIN)
+
+// 행과 열이 모두 같은 포트에 있으면 BSRR/IDR 레지스터를 직접 사용하는 빠른 스캔을 사용합니다.
+// (컴파일 시점에 결정되며, 포트가 나뉘어 있으면 HAL_GPIO 함수를 사용하는 기존 방식으로 스캔합니다.
+//  두 방식을 비교하려면 컴파일 옵션으로 KEYPAD16_SAME_PORT=0을 주어 같은 포트에서도 기존 방식을 사용할 수 있습니다.)
+#ifndef KEYPAD16_SAME_PORT
+#define KEYPAD16_SAME_PORT (R1_PORT == R2_PORT && R1_PORT == R3_PORT && R1_PORT == R4_PORT && \
+                            R1_PORT == C1_PORT && R1_PORT == C2_PORT && R1_PORT == C3_PORT && R1_PORT == C4_PORT)
+#endif
+
+// 스케줄러에 등록할 때의 스캔 주기 (ms, KEYPAD16_Task)
+#define KEYPAD16_TASK_PERIOD_MS 10
+
+// 디바운스: 키 상태가 KEYPAD16_DEBOUNCE_SCANS회 연속 스캔에서 같은 값으로 읽혀야 눌림/뗌으로 인정합니다.
+// (2비트 카운터라서 4회로 고정, 인정까지 최대 KEYPAD16_DEBOUNCE_MS: KEYPAD16_TASK_PERIOD_MS 10ms 주기에서 40ms)
+#define KEYPAD16_DEBOUNCE_SCANS 4
+#define KEYPAD16_DEBOUNCE_MS (KEYPAD16_DEBOUNCE_SCANS * KEYPAD16_TASK_PERIOD_MS)
+// 길게 누름/자동 반복 이벤트 시간 (ms)
+#define KEYPAD16_LONG_PRESS_MS 800
+#define KEYPAD16_REPEAT_MS     150
+
+// 키 이벤트 큐 크기 (2의 거듭제곱)
+#define KEYPAD16_EVENT_QUEUE_SIZE 16
+
+// 빠른 스캔에서 행을 바꾼 뒤 열 입력을 읽기 전까지 기다리는 루프 횟수
+// (이전 행에서 LOW였던 열이 풀업 저항으로 HIGH까지 올라오는 시간, 84MHz 기준 약 1us)
+#define KEYPAD16_SETTLE_LOOPS 20
+
+
+/**
+ * @brief 키 이벤트 종류입니다.
+ */
+typedef enum {
+    KEYPAD16_EVENT_PRESS,       // 키가 눌림 (디바운스 후)
+    KEYPAD16_EVENT_RELEASE,     // 키가 떼짐 (디바운스 후)
+    KEYPAD16_EVENT_LONG_PRESS,  // 키를 KEYPAD16_LONG_PRESS_MS 동안 누르고 있음 (한 번)
+    KEYPAD16_EVENT_REPEAT       // 길게 누른 뒤 KEYPAD16_REPEAT_MS 마다 반복
+} KEYPAD16_EventType;
+
+/**
+ * @brief 키 이벤트입니다. KEYPAD16_Get_Event로 읽어옵니다.
+ */
+typedef struct {
+    char key;                  // 키 문자
+    KEYPAD16_EventType type;   // 이벤트 종류
+    uint32_t tick;             // 이벤트가 감지된 시점의 HAL_GetTick() 값
+} KEYPAD16_Event;
+
 
 /**
  * @brief 키패드 드라이버를 초기화합니다.
@@ -57,6 +108,35 @@
  */
 void KEYPAD16_Init(void);
 
+/**
+ * @brief 키패드 드라이버를 인터럽트 구동 방식으로 초기화합니다.
+ * @param htim 키가 눌려있는 동안 주기적으로 스캔할 타이머 (10-20ms 주기로 설정)
+ * @note  키가 눌리지 않은 동안에는 모든 행을 LOW로 두고 열 핀의 EXTI 인터럽트만 기다리므로,
+ *        메인 루프에서 스캔할 필요가 없고 MCU가 sleep할 수 있습니다.
+ *        키가 눌리면 타이머로 스캔을 시작하고, 모든 키가 떼지면 타이머를 멈추고 다시 EXTI 대기 상태로 돌아갑니다.
+ *        이 방식을 사용할 때는 KEYPAD16_Scan()을 직접 호출하면 안 됩니다.
+ */
+void KEYPAD16_Init_IT(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 열 핀의 EXTI 인터럽트를 처리합니다.
+ * @note  HAL_GPIO_EXTI_Callback 안에서 호출해야 합니다.
+ * @param GPIO_Pin HAL_GPIO_EXTI_Callback이 넘겨준 핀 번호
+ */
+void KEYPAD16_EXTI_Callback(uint16_t GPIO_Pin);
+
+/**
+ * @brief 키가 눌려있는 동안 타이머 주기마다 키패드를 스캔합니다.
+ * @note  HAL_TIM_PeriodElapsedCallback 안에서 KEYPAD16_Init_IT에 넘긴 타이머일 때 호출해야 합니다.
+ */
+void KEYPAD16_TIM_Callback(void);
+
+/**
+ * @brief 인터럽트 구동 방식에서 EXTI 대기(스캔 정지) 상태인지 반환합니다.
+ * @retval uint8_t 1: 대기 중 (MCU sleep 가능), 0: 스캔 중 또는 폴링 방식
+ */
+uint8_t KEYPAD16_IsIdle(void);
+
 /**
  * @brief 키패드 매트릭스를 스캔하여 현재 눌린 키를 감지합니다.
  * @note  이 함수는 main 함수의 while(1) 루프 안에서 주기적으로 호출되어야 합니다.
@@ -65,6 +145,33 @@ void KEYPAD16_Init(void);
  */
 void KEYPAD16_Scan(void);
 
+/**
+ * @brief 스케줄러용 태스크 함수입니다. (KEYPAD16_TASK_PERIOD_MS 주기)
+ * @note  폴링 방식이면 KEYPAD16_Scan을 호출하고, 인터럽트 구동 방식이면 아무것도 하지 않습니다.
+ */
+void KEYPAD16_Task(void);
+
+/**
+ * @brief 키 이벤트 큐에서 가장 오래된 이벤트 하나를 꺼냅니다.
+ * @note  여러 키가 같은 스캔에서 눌리거나, 스캔보다 느리게 읽어가도 이벤트를 놓치지 않습니다.
+ *        큐가 가득 차면 새 이벤트는 버려지며 KEYPAD16_Get_Dropped_Events로 확인할 수 있습니다.
+ * @param event 이벤트를 받을 구조체 포인터
+ * @retval uint8_t 1: 이벤트를 꺼냄, 0: 큐가 비어있음
+ */
+uint8_t KEYPAD16_Get_Event(KEYPAD16_Event *event);
+
+/**
+ * @brief 키 이벤트 큐가 가득 차서 버려진 이벤트 수를 반환합니다.
+ */
+uint32_t KEYPAD16_Get_Dropped_Events(void);
+
+/**
+ * @brief 디바운스된 현재 눌림 상태를 16비트 비트맵으로 반환합니다.
+ * @note  비트 번호는 (행 * 4 + 열)이며, 예를 들어 '1'은 bit 0, 'D'는 bit 15입니다.
+ * @retval uint16_t 눌린 키 비트맵 (1: 눌림)
+ */
+uint16_t KEYPAD16_Get_Key_Bits(void);
+
 /**
  * @brief 현재 '계속 누르고 있는' 키의 문자를 반환합니다.
  * @note  키에서 손을 떼면 NO_KEY_PRESSED를 반환합니다.
@@ -78,6 +185,7 @@ char KEYPAD16_Get_Pressed_Key(void);
  * @brief 키가 '처음 눌리는 순간'에만 한 번 키의 문자를 반환합니다 (Rising Edge 감지).
  * @note  키를 계속 누르고 있어도 두 번째 호출부터는 NO_KEY_PRESSED를 반환합니다.
  *        키에서 손을 뗐다가 다시 눌러야 해당 키의 문자가 다시 반환됩니다.
+ *        감지된 키는 이 함수로 읽어갈 때까지 유지되므로, 스캔이 인터럽트에서 일어나도 놓치지 않습니다.
  * @param None
  * @retval char 새로 눌린 키의 문자. 새로 눌린 키가 없으면 NO_KEY_PRESSED ('\0').
  */
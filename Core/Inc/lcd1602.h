@@ -9,7 +9,7 @@
 #define INC_LCD1602_H_
 
 
-#include "stm32f4xx_hal.h"  // MCU에 맞게 변경
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
 
 // I²C 핸들 (main.c 등에서 extern 선언한 걸 받아옴)
 extern I2C_HandleTypeDef hi2c1;
@@ -17,10 +17,69 @@ extern I2C_HandleTypeDef hi2c1;
 // LCD I²C 주소 (7비트)
 #define LCD_ADDR (0x3C)  // 0x78 >> 1
 
+// 화면 크기 (줄 수, 한 줄의 칸 수)
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// LCD_Flush에서 변경된 구간 사이의 변경 안 된 칸이 이 값 이하이면 두 구간을 하나로 합쳐서 전송
+// (구간을 나누면 트랜잭션마다 I²C 주소 1바이트 + 주소 명령 헤더 3바이트가 추가됨)
+#define LCD_RUN_MERGE_GAP 4
+
+// control 바이트 (Co: 1이면 다음 바이트 뒤에 control 바이트가 또 옴, RS: 0=명령, 1=데이터)
+#define LCD_CTRL_CMD       0x00   // Co=0, RS=0: 이후 바이트는 모두 명령
+#define LCD_CTRL_DATA      0x40   // Co=0, RS=1: 이후 바이트는 모두 데이터
+#define LCD_CTRL_CMD_NEXT  0x80   // Co=1, RS=0: 명령 1바이트 뒤에 control 바이트가 이어짐
+
+// 사용자 정의 문자(CGRAM) 캐시
+#define LCD_MAX_GLYPHS 32    // 등록 가능한 글리프 수 (ID: 0 ~ LCD_MAX_GLYPHS-1)
+#define LCD_CGRAM_SLOTS 8    // LCD의 CGRAM 슬롯 수
+
+// 비동기 모드 설정
+#define LCD_QUEUE_SIZE 16                  // 전송 대기 큐 크기
+#define LCD_OP_MAX_BYTES (3 + LCD_COLS)    // I²C 트랜잭션 하나의 최대 바이트 수 (주소 명령 + 한 줄 데이터)
+#define LCD_WAIT_CLEAR_US 1600    // clear/home 명령 실행 시간 (us)
+#define LCD_WAIT_CMD_US 40        // 그 외 명령 실행 시간 (us), 주소 명령 뒤의 control 바이트 전송 시간이 이보다 짧은 버스 클럭이면 주소 명령을 따로 보내고 기다림
+#define LCD_RETRY_US 100          // I²C 버스 큐(i2cbus)가 가득 찼을 때 재시도 간격 (us)
+
+// 스케줄러 태스크 주기 (LCD_Task가 프레임버퍼를 화면에 반영하는 주기, ms)
+#define LCD_TASK_PERIOD_MS 50
+
 void LCD_Init(void);
-void LCD_SendCommand(uint8_t cmd);
-void LCD_SendData(uint8_t data);
+HAL_StatusTypeDef LCD_SendCommand(uint8_t cmd);
+HAL_StatusTypeDef LCD_SendData(uint8_t data);
 void LCD_DispCGRAM(void);
 void LCD_DispChar(int line, int column, char *dp);
+HAL_StatusTypeDef LCD_WriteBuffer(int line, int column, const uint8_t *data, uint16_t len);
+
+// 프레임버퍼
+// LCD_SetCursor/LCD_Print/LCD_ClearBuffer는 RAM의 프레임버퍼만 수정하고,
+// LCD_Flush가 실제 화면과 달라진 칸만 모아서 전송합니다.
+void LCD_SetCursor(int line, int column);
+void LCD_Print(const char *str);
+void LCD_ClearBuffer(void);
+void LCD_Flush(void);
+void LCD_Invalidate(void);  // LCD_SendData 등으로 화면을 직접 바꾼 경우, 다음 LCD_Flush에서 전체를 다시 전송
+void LCD_PutChar(uint8_t c);  // 프레임버퍼의 커서 위치에 문자 코드 하나를 쓰고 커서를 이동
+
+// 글리프 캐시
+// 8개보다 많은 사용자 정의 문자를 ID로 등록해두고, 그릴 때 LCD_UseGlyph로 CGRAM 슬롯을 배정받습니다.
+// 이미 올라가 있으면 다시 업로드하지 않고, 슬롯이 부족하면 화면(프레임버퍼 포함)에 보이지 않는 슬롯 중
+// 가장 오래전에 사용한 슬롯을 교체합니다.
+HAL_StatusTypeDef LCD_RegisterGlyph(uint8_t id, const uint8_t *bitmap);  // bitmap: 5x8 글리프 8바이트 (포인터만 저장)
+int LCD_UseGlyph(uint8_t id);  // 출력할 문자 코드(0x08~0x0F) 반환, 배정할 슬롯이 없거나 업로드를 큐에 넣지 못하면 -1
+void LCD_GetGlyphStats(uint32_t *hits, uint32_t *misses);
+
+// 비동기 모드
+// LCD_Init 이후 LCD_StartAsync를 호출하면, 이후의 명령/데이터는 큐에 쌓이고 바로 리턴합니다.
+// 큐가 가득 차면 기다리지 않고 HAL_BUSY를 반환하며(버린 수는 LCD_GetDropped), 다음 LCD_Flush에서 화면 전체를 다시 전송합니다.
+// 큐는 I²C 버스 관리자(i2cbus, 낮은 우선순위)의 전송 완료 인터럽트와 타이머(명령 실행 시간 대기)로 처리됩니다.
+// htim: 1MHz로 카운트하도록 Prescaler를 설정한 타이머 (global interrupt 활성화)
+void LCD_StartAsync(TIM_HandleTypeDef *htim);
+void LCD_I2C_TxCpltCallback(void);  // 이전 버전 호환용 (I2CBUS_TxCpltCallback(&hi2c1)과 같음)
+void LCD_TIM_Callback(void);        // HAL_TIM_PeriodElapsedCallback에서 호출 필요 (LCD_StartAsync에 넘긴 타이머일 때)
+uint8_t LCD_IsBusy(void);           // 큐에 처리할 명령이 남아있으면 1
+uint32_t LCD_GetDropped(void);      // 큐가 가득 차서 버린 트랜잭션 수
+void LCD_SetDoneCallback(void (*callback)(void));  // 큐가 모두 처리되면 호출될 함수 (인터럽트에서 호출됨)
+void LCD_Task(void);  // 스케줄러용 태스크 (LCD_TASK_PERIOD_MS 주기로 LCD_Flush, 비동기 모드에서 사용 권장)
 
 #endif
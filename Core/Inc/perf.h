@@ -0,0 +1,84 @@
+/*
+ * perf.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef INC_PERF_H_
+#define INC_PERF_H_
+
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
+
+// 정의하면 드라이버의 PERF_BEGIN/PERF_END 구간 실행 시간을 측정합니다.
+// 정의하지 않으면 측정 매크로는 아무 코드도 만들지 않습니다. (perf.c도 빌드할 필요 없음)
+//#define PERF_ENABLE
+
+#define PERF_HIST_BUCKETS 24  // log2 히스토그램 칸 수 (0클럭, 1클럭, 2~3클럭, ... 2^22클럭 이상)
+
+// 측정 구간 번호
+typedef enum {
+    PERF_KEYPAD16_SCAN,     // KEYPAD16_Scan
+    PERF_SEG7ARRAY_CYCLE,   // SEG7ARRAY_Cycle (폴링 방식) 또는 SEG7ARRAY_TIM_Callback (타이머 방식)
+    PERF_LCD_DISPCHAR,      // LCD_DispChar
+    PERF_U2C_PROCESS,       // U2C_process
+    PERF_SPEAKER_LOOP,      // SPEAKER_Loop (타이머 인터럽트)
+    PERF_SPEAKER_DDS_FILL,  // SPEAKER_DDS 블록 하나(SPEAKER_DDS_BLOCK 샘플) 합성
+    PERF_USER0,             // 사용자 코드용
+    PERF_USER1,
+    PERF_USER2,
+    PERF_USER3,
+    PERF_PROBE_COUNT
+} PERF_Probe;
+
+// 구간별 통계 (단위: 보드에서는 CPU 클럭, DWT가 없는 PC 빌드에서는 ns)
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;                        // 평균 계산용 합계
+    uint16_t hist[PERF_HIST_BUCKETS];      // 칸 b: 2^(b-1) 이상 2^b 미만 (마지막 칸은 그 이상 전부, 65535에서 멈춤)
+} PERF_Stats;
+
+#ifdef PERF_ENABLE
+
+#ifdef DWT
+#define PERF_NOW() (DWT->CYCCNT)
+#else
+#define PERF_NOW() PERF_HostNow()
+uint32_t PERF_HostNow(void);
+#endif
+
+// 같은 블록 안에서 짝을 맞춰 사용 (사이에서 return하면 그 실행은 기록되지 않음)
+#define PERF_BEGIN(id) uint32_t perf_start_##id = PERF_NOW()
+#define PERF_END(id) PERF_Record((id), PERF_NOW() - perf_start_##id)
+
+/**
+ * @brief 측정 초기화 (DWT 사이클 카운터를 켜고 콘솔에 perf 커맨드 등록)
+ * @note U2C_init 다음에 호출
+ */
+void PERF_Init(void);
+
+/**
+ * @brief 측정값 하나를 기록 (인터럽트에서 호출 가능, 한 구간은 한 곳에서만 기록해야 함)
+ */
+void PERF_Record(PERF_Probe id, uint32_t cycles);
+
+/**
+ * @brief 구간 통계를 복사 (기록 도중의 값이 섞이지 않도록 인터럽트를 잠깐 막음)
+ */
+void PERF_GetStats(PERF_Probe id, PERF_Stats *stats);
+
+/**
+ * @brief 모든 통계 초기화
+ */
+void PERF_Reset(void);
+
+#else
+
+#define PERF_BEGIN(id) ((void)0)
+#define PERF_END(id) ((void)0)
+
+#endif /* PERF_ENABLE */
+
+#endif /* INC_PERF_H_ */
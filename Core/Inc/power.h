@@ -0,0 +1,80 @@
+/*
+ * power.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef INC_POWER_H_
+#define INC_POWER_H_
+
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
+
+// STOP 모드에 들어가기 전에 확인할 드라이버 (사용하지 않는 드라이버는 주석 처리)
+#define POWER_USE_U2C        // 출력 링 버퍼가 비고 마지막 바이트까지 전송되었을 때만
+#define POWER_USE_KEYPAD16   // 인터럽트 구동 방식(KEYPAD16_Init_IT)에서 EXTI 대기 중일 때만 (폴링 방식이면 STOP 안 함)
+#define POWER_USE_LCD        // 비동기 큐가 비었을 때만
+#define POWER_USE_I2CBUS     // 진행 중이거나 대기 중인 I²C 트랜잭션이 없을 때만
+#define POWER_USE_SEG7ARRAY  // 표시 중인 내용이 없을 때만
+#define POWER_USE_SPEAKER    // 재생 중이 아닐 때만
+
+// 정의하면 RTC wakeup 타이머로 다음 태스크 시점에 STOP 모드에서 깨어나고, 자는 동안 지난 시간을 HAL tick에 더합니다.
+// (CubeMX에서 RTC 활성화, Wake Up: Internal WakeUp, NVIC에서 RTC wake-up interrupt 체크 필요)
+// 정의하지 않으면 STOP 모드를 사용하지 않고 SLEEP 모드만 사용합니다.
+// (STOP 모드에서는 SysTick이 멈추므로 RTC 없이는 잔 시간을 알 수 없어 HAL_GetTick이 늦어짐)
+//#define POWER_USE_RTC
+#define POWER_RTC_CLOCK_HZ 32768   // RTC 클럭 (LSE: 32768, LSI: 32000)
+
+#define POWER_STOP_MIN_MS 10       // 다음 태스크까지 이보다 짧으면 STOP 대신 SLEEP (STOP에서 깨어나 클럭을 다시 설정하는 시간 고려)
+
+// UART 수신으로 STOP 모드에서 깨어나기 위한 RX 핀의 EXTI 라인 (USART2 RX: PA3)
+// STOP 모드에서는 UART가 멈추므로 깨어날 때 받은 첫 바이트는 유실될 수 있습니다.
+#define POWER_UART_WAKE_LINE 3      // EXTI 라인 번호 (= 핀 번호)
+#define POWER_UART_WAKE_PORT 0      // SYSCFG EXTICR 포트 번호 (0: GPIOA, 1: GPIOB, 2: GPIOC)
+#define POWER_UART_WAKE_IRQn EXTI3_IRQn
+#define POWER_UART_AWAKE_MS 10000   // UART 수신으로 깨어난 뒤 STOP 모드에 들어가지 않는 시간 (콘솔 입력이 유실되지 않도록)
+
+// 절전 통계
+typedef struct {
+    uint32_t elapsed_ms;   // POWER_Init 또는 POWER_ResetStats 이후 지난 시간
+    uint32_t sleep_ms;     // SLEEP 모드로 보낸 시간
+    uint32_t stop_ms;      // STOP 모드로 보낸 시간
+    uint32_t sleeps;       // SLEEP 모드 진입 횟수
+    uint32_t stops;        // STOP 모드 진입 횟수
+    uint32_t uart_wakes;   // UART 수신으로 STOP 모드에서 깨어난 횟수
+} POWER_Stats;
+
+/**
+ * @brief 절전 관리 초기화
+ * @param restore_clock: STOP 모드에서 깨어난 뒤 시스템 클럭을 다시 설정할 함수 (보통 CubeMX가 만든 SystemClock_Config)
+ *                       HSI 기준으로 SysTick을 다시 켜고 인터럽트를 허용한 상태에서 호출되므로 HAL_GetTick/HAL_Delay를 써도 됨
+ *                       NULL이거나 POWER_USE_RTC를 정의하지 않았으면 STOP 모드를 사용하지 않고 SLEEP 모드만 사용
+ */
+void POWER_Init(void (*restore_clock)(void));
+
+/**
+ * @brief 다음 태스크 시점(SCHED_TimeToNext)까지 절전
+ * @note  main 루프에서 SCHED_Run 다음에 호출
+ *        - POWER_USE_RTC를 정의했고 모든 드라이버가 쉬고 있으면 STOP 모드 (SysTick 정지, 키패드 EXTI/UART 수신/RTC로 깨어남)
+ *        - 그 외에는 SysTick 인터럽트를 다음 태스크 시점까지 미루고 SLEEP 모드 (모든 인터럽트로 깨어남)
+ *        인터럽트로 일찍 깨어나면 지난 시간만큼 HAL tick을 맞추고 리턴
+ */
+void POWER_Idle(void);
+
+/**
+ * @brief STOP 모드 사용 여부 (0: SLEEP 모드만 사용, 디버거 연결 중 등)
+ */
+void POWER_SetStopAllowed(uint8_t allowed);
+
+/**
+ * @brief 절전 통계 (sleep_ms + stop_ms를 elapsed_ms로 나누면 절전 비율)
+ */
+void POWER_GetStats(POWER_Stats *stats);
+
+/**
+ * @brief 절전 통계 초기화
+ */
+void POWER_ResetStats(void);
+
+
+#endif /* INC_POWER_H_ */
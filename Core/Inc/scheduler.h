@@ -0,0 +1,90 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
+
+// 등록할 수 있는 최대 태스크 수
+#define SCHED_MAX_TASKS 16
+
+// 태스크 함수 (실행이 끝나면 리턴해야 함, 안에서 HAL_Delay 등으로 기다리지 말 것)
+typedef void (*SCHED_TaskFunc)(void);
+
+// 태스크별 통계
+typedef struct {
+    uint32_t runs;           // 실행 횟수
+    uint32_t max_cycles;     // 최장 실행 시간 (CPU 클럭 수)
+    uint32_t max_lateness;   // 실행 가능해진 시점부터 실제 실행까지 최대 지연 (ms)
+    uint32_t missed;         // 데드라인을 넘겨서 끝난 횟수 (주기 태스크는 건너뛴 주기 포함)
+} SCHED_Stats;
+
+/**
+ * @brief 스케줄러 초기화 (등록된 태스크를 모두 지우고, 실행 시간 측정용 DWT 사이클 카운터를 켬)
+ */
+void SCHED_Init(void);
+
+/**
+ * @brief 주기 태스크 등록
+ * @param period_ms: 실행 주기 (ms, 1 이상)
+ * @param deadline_ms: 실행 가능해진 시점부터 실행이 끝나야 하는 시간 (0이면 period_ms)
+ * @retval 태스크 번호, 등록할 수 없으면 -1
+ */
+int SCHED_AddPeriodic(const char *name, SCHED_TaskFunc func, uint32_t period_ms, uint32_t deadline_ms);
+
+/**
+ * @brief 이벤트 태스크 등록 (SCHED_Wake 또는 SCHED_After로 깨울 때만 한 번 실행)
+ * @retval 태스크 번호, 등록할 수 없으면 -1
+ */
+int SCHED_AddEvent(const char *name, SCHED_TaskFunc func, uint32_t deadline_ms);
+
+/**
+ * @brief 태스크를 바로 실행 가능 상태로 만듦
+ * @note 인터럽트(UART 수신, 타이머 등)에서 호출 가능
+ */
+void SCHED_Wake(int id);
+
+/**
+ * @brief delay_ms 후에 태스크를 한 번 실행 (일회성 타이머)
+ */
+void SCHED_After(int id, uint32_t delay_ms);
+
+/**
+ * @brief 실행 가능한 태스크를 데드라인이 빠른 순서대로 모두 실행
+ * @note main 루프에서 계속 호출
+ */
+void SCHED_Run(void);
+
+/**
+ * @brief 다음 태스크가 실행 가능해질 때까지 남은 시간 (ms)
+ * @retval 0이면 지금 실행할 태스크가 있음, 0xFFFFFFFF이면 예정된 태스크 없음 (깨우기만 기다림)
+ */
+uint32_t SCHED_TimeToNext(void);
+
+/**
+ * @brief 태스크 통계 (잘못된 번호이면 NULL)
+ */
+const SCHED_Stats *SCHED_GetStats(int id);
+
+/**
+ * @brief 태스크 이름 (잘못된 번호이면 NULL)
+ */
+const char *SCHED_GetName(int id);
+
+/**
+ * @brief 등록된 태스크 수
+ */
+int SCHED_GetTaskCount(void);
+
+/**
+ * @brief 모든 태스크 통계 초기화
+ */
+void SCHED_ResetStats(void);
+
+
+#endif /* INC_SCHEDULER_H_ */
@@ -2,26 +2,133 @@
 #ifndef INC_SEG7ARRAY_H_
 #define INC_SEG7ARRAY_H_
 
-#include "seg7array.h"
-#include "stm32f4xx_hal.h"
-#include "main.h"
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더, SEGx 핀 정의 포함)
+
+// 타이머 모드의 화면 갱신 주기 (4자리 전체를 한 번 표시하는 횟수/초, 500 ~ 2000 권장)
+// 타이머 인터럽트는 이 값의 4배 주기로 발생하며, 타이머는 1 MHz(1 tick = 1us)로 설정되어 있어야 함
+#define SEG7ARRAY_REFRESH_HZ 1000
+#define SEG7ARRAY_DIGIT_TICKS (1000000 / (SEG7ARRAY_REFRESH_HZ * 4))  // 한 자리를 표시하는 시간 (타이머 tick)
+
+// 스케줄러 태스크 주기 (SEG7ARRAY_Task, ms)
+// 폴링 방식에서는 호출될 때마다 한 자리씩 표시하므로 1ms이면 4ms마다 한 프레임 (250Hz)
+#define SEG7ARRAY_TASK_PERIOD_MS 1
+
+// 문자열 출력 설정
+#define SEG7ARRAY_TEXT_MAX 32   // SEG7ARRAY_ShowText로 출력할 수 있는 최대 글자 수 ('.' 제외)
+#define SEG7ARRAY_SCROLL_MS 300 // 4자보다 긴 문자열이 한 칸 스크롤되는 시간
+
+// 밝기 단계 (0: 꺼짐 ~ SEG7ARRAY_BRIGHTNESS_MAX: 최대)
+#define SEG7ARRAY_BRIGHTNESS_MAX 15
 
 /**
  * @brief 초기화 함수
+ * @note 모든 자리와 세그먼트를 끈 상태로 시작
  */
 void SEG7ARRAY_Init(void);
 
 /**
- * @brief 입력받은 position의 cathode 비트를 수정
+ * @brief 타이머 인터럽트 방식으로 초기화
+ * @note 타이머 인터럽트마다 한 자리씩 표시하므로 메인 루프에서 SEG7ARRAY_Cycle을 호출할 필요가 없음
+ *       HAL_TIM_PeriodElapsedCallback에서 SEG7ARRAY_TIM_Callback을 호출해야 함
+ *       밝기는 0(꺼짐)과 최대만 구분됨 (단계별 밝기는 SEG7ARRAY_Init_IT_Brightness 사용)
+ */
+void SEG7ARRAY_Init_IT(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 타이머 인터럽트 방식 + 밝기 조절로 초기화
+ * @note SEG7ARRAY_Init_IT에 더해 HAL_TIM_OC_DelayElapsedCallback에서 SEG7ARRAY_TIM_OC_Callback을 호출해야 함
+ *       channel: 밝기 조절에 사용할 같은 타이머의 Output Compare 채널 (TIM_CHANNEL_x)
+ */
+void SEG7ARRAY_Init_IT_Brightness(TIM_HandleTypeDef *htim, uint32_t channel);
+
+/**
+ * @brief 전체 밝기 설정 (0 ~ SEG7ARRAY_BRIGHTNESS_MAX)
+ * @note SEG7ARRAY_Init_IT_Brightness로 초기화한 경우에만 단계별로 동작, 자리별 밝기와 곱해져서 적용됨
+ */
+void SEG7ARRAY_Set_brightness(uint8_t level);
+
+/**
+ * @brief 입력받은 position(1~4)의 밝기 설정 (0 ~ SEG7ARRAY_BRIGHTNESS_MAX)
+ */
+void SEG7ARRAY_Set_digit_brightness(uint8_t pos, uint8_t level);
+
+/**
+ * @brief 입력받은 position(1~4)의 cathode 비트를 수정
  * @note 1이 불켜짐, 0이 불꺼짐
+ *       타이머 모드에서는 다음 프레임 시작부터 반영되므로, 한 프레임 안에서 자리가 섞여 보이지 않음
  */
 void SEG7ARRAY_Set_cathode(uint8_t pos, uint8_t cathode_bits);
 
+/**
+ * @brief 4자리의 cathode 비트를 한 번에 수정
+ * @note 여러 자리를 바꿀 때 중간 상태가 한 프레임도 표시되지 않음
+ */
+void SEG7ARRAY_Set_all(const uint8_t cathode_bits[4]);
+
+/**
+ * @brief 정수 출력 (-999 ~ 9999, 오른쪽 정렬, 범위를 넘으면 "----")
+ * @note 이 함수들은 이전과 같은 값이면 아무것도 하지 않고, 표시가 바뀔 때만 cathode 비트를 수정함
+ */
+void SEG7ARRAY_ShowInt(int32_t value);
+
+/**
+ * @brief 16진수 4자리 출력
+ */
+void SEG7ARRAY_ShowHex(uint16_t value);
+
+/**
+ * @brief 고정 소수점 출력 (value / 10^decimals, decimals: 0~3)
+ * @note 예) SEG7ARRAY_ShowFixed(1234, 2) -> "12.34", SEG7ARRAY_ShowFixed(-5, 1) -> "-0.5"
+ */
+void SEG7ARRAY_ShowFixed(int32_t value, uint8_t decimals);
+
+/**
+ * @brief 문자열 출력 ('.'은 앞 글자의 소수점으로 표시)
+ * @note 4자보다 길면 SEG7ARRAY_SCROLL_MS마다 한 칸씩 스크롤되며, 메인 루프에서 SEG7ARRAY_Update를 호출해야 함
+ */
+void SEG7ARRAY_ShowText(const char *text);
+
+/**
+ * @brief 문자열 스크롤 진행
+ * @note while문 같이 빠르게 반복되는 곳에 입력 필요
+ */
+void SEG7ARRAY_Update(void);
+
+/**
+ * @brief 표시 중인 내용이 없는지 반환 (모든 자리가 꺼져 있고 스크롤 중이 아님)
+ * @note 절전 관리에서 STOP 모드에 들어가도 되는지 확인할 때 사용
+ */
+uint8_t SEG7ARRAY_IsBlank(void);
+
+/**
+ * @brief 문자에 해당하는 cathode 비트 반환 (표시할 수 없는 문자는 0)
+ */
+uint8_t SEG7ARRAY_Glyph(char c);
+
 /**
  * @brief 자리를 순회하며 불빛을 켬
  * @note while문 같이 빠르게 반복되는 곳에 입력 필요
+ *       HAL_Delay(1)로 자리마다 메인 루프를 멈추는 기존 방식이며, 타이머 모드에서는 아무 동작도 하지 않음
  */
 void SEG7ARRAY_Cycle(void);
 
+/**
+ * @brief 스케줄러용 태스크 함수 (SEG7ARRAY_TASK_PERIOD_MS 주기)
+ * @note 폴링 방식이면 HAL_Delay 없이 호출될 때마다 한 자리씩 표시를 넘기고, 문자열 스크롤(SEG7ARRAY_Update)을 진행함
+ */
+void SEG7ARRAY_Task(void);
+
+/**
+ * @brief 타이머 모드에서 한 자리씩 표시를 넘김
+ * @note HAL_TIM_PeriodElapsedCallback에서 호출
+ */
+void SEG7ARRAY_TIM_Callback(void);
+
+/**
+ * @brief 타이머 모드에서 밝기에 맞춰 현재 자리를 끔
+ * @note HAL_TIM_OC_DelayElapsedCallback에서 호출
+ */
+void SEG7ARRAY_TIM_OC_Callback(void);
+
 
 #endif /* INC_SEG7ARRAY_H_ */
@@ -2,15 +2,70 @@
 #ifndef INC_SPEAKER_H_
 #define INC_SPEAKER_H_
 
-#include "main.h"
-#include "stm32f4xx_hal.h" // 자신의 MCU에 맞는 HAL 드라이버 헤더로 변경하세요.
+#include "main.h" // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더, Speaker 핀 정의 포함)
+
+// 타이머 출력(PWM) 방식에서 사용하는 타이머의 입력 클럭 (APB 타이머 클럭, Hz)
+#define SPEAKER_TIM_CLOCK_HZ 84000000
+
+// 스케줄러 태스크 주기 (SPEAKER_Task, ms)
+#define SPEAKER_TASK_PERIOD_MS 1
+
+// 멜로디 큐에 넣을 수 있는 음 수 (실제로는 1 작은 수만큼 저장)
+#define SPEAKER_QUEUE_SIZE 64
+
+// DDS(파형 합성) 방식 설정
+#define SPEAKER_DDS_SAMPLE_RATE 40000  // 샘플링 주파수 = PWM 주파수 (Hz, 20000 ~ 40000)
+#define SPEAKER_DDS_VOICES 4           // 동시에 재생할 수 있는 목소리 수 (2의 거듭제곱)
+#define SPEAKER_DDS_VOICES_SHIFT 2     // log2(SPEAKER_DDS_VOICES)
+#define SPEAKER_DDS_BLOCK 64           // DMA 절반 버퍼의 샘플 수 (인터럽트 1번에 채우는 양)
+
+// 1이면 두 목소리를 SMLAD 한 번으로 곱해서 누적 (Cortex-M4 DSP 명령이 있으면 기본 1, 0으로 정의하면 C 루프로 비교 가능)
+#ifndef SPEAKER_DDS_USE_SMLAD
+#if defined(__ARM_FEATURE_DSP) && (SPEAKER_DDS_VOICES % 2 == 0)
+#define SPEAKER_DDS_USE_SMLAD 1
+#else
+#define SPEAKER_DDS_USE_SMLAD 0
+#endif
+#endif
+
+// DDS 파형
+typedef enum {
+    SPEAKER_WAVE_SQUARE,
+    SPEAKER_WAVE_TRIANGLE,
+    SPEAKER_WAVE_SINE
+} SPEAKER_Wave;
+
+// 멜로디의 음 하나
+typedef struct {
+    uint16_t frequency;    // 주파수 (Hz, 0이면 쉼표)
+    uint16_t duration_ms;  // 소리 나는 시간 (ms)
+    uint16_t gap_ms;       // 다음 음까지 쉬는 시간 (ms)
+} SPEAKER_Note;
 
 /**
  * @brief  스피커 모듈을 초기화하고 타이머를 지정합니다.
- * @param  htim: 스피커 제어에 사용할 타이머의 핸들러
+ * @param  htim: 스피커 제어에 사용할 타이머의 핸들러 (100kHz 주기로 SPEAKER_Loop 호출)
+ * @note   타이머 인터럽트는 재생 중에만 발생합니다.
  */
 void SPEAKER_Init(TIM_HandleTypeDef *htim);
 
+/**
+ * @brief  타이머 채널이 스피커 핀을 직접 구동하는 방식으로 초기화합니다.
+ * @param  htim: 스피커 핀이 연결된 타이머의 핸들러
+ * @param  channel: 스피커 핀의 PWM 채널 (TIM_CHANNEL_x)
+ * @note   재생 중 인터럽트가 발생하지 않으며, 재생 시간은 SPEAKER_Update에서 처리합니다.
+ */
+void SPEAKER_Init_PWM(TIM_HandleTypeDef *htim, uint32_t channel);
+
+/**
+ * @brief  여러 음을 합성해서 PWM duty로 출력하는 방식으로 초기화합니다.
+ * @param  htim: 스피커 핀이 연결된 타이머의 핸들러 (PWM 채널에 순환 모드 DMA 설정 필요)
+ * @param  channel: 스피커 핀의 PWM 채널 (TIM_CHANNEL_x)
+ * @note   DMA 절반/전체 전송 완료 콜백에서 SPEAKER_DMA_HalfCpltCallback, SPEAKER_DMA_CpltCallback을 호출해야 합니다.
+ *         SPEAKER_Start와 멜로디는 0번 목소리를 사용하며, 재생 시간은 SPEAKER_Update에서 처리합니다.
+ */
+void SPEAKER_Init_DDS(TIM_HandleTypeDef *htim, uint32_t channel);
+
 /**
  * @brief  지정된 주파수로 지정된 시간만큼 스피커 재생을 시작합니다. (논블로킹)
  * @param  frequency: 재생할 주파수 (Hz)
@@ -20,19 +75,90 @@ void SPEAKER_Start(uint32_t frequency, uint32_t play_time_ms);
 
 /**
  * @brief 스피커 재생을 즉시 중지합니다.
+ * @note  멜로디 큐도 비웁니다.
  */
 void SPEAKER_Stop(void);
 
+/**
+ * @brief  멜로디 큐에 음들을 추가합니다. 재생 중이 아니면 바로 재생을 시작합니다. (논블로킹)
+ * @param  notes: 추가할 음 배열 (큐에 복사되므로 리턴 후 바뀌어도 됨)
+ * @param  count: 음 개수
+ * @retval 큐에 추가된 음 개수 (큐가 가득 차면 count보다 작음)
+ * @note   음 사이의 전환은 타이머 인터럽트(타이머 출력 방식은 SPEAKER_Update)에서 처리되므로 메인 루프 지연과 무관합니다.
+ */
+uint16_t SPEAKER_Enqueue(const SPEAKER_Note *notes, uint16_t count);
+
+/**
+ * @brief  큐에 있는 음들을 반복 재생할지 설정합니다.
+ * @param  enable: 1이면 마지막 음 다음에 큐의 처음부터 다시 재생
+ */
+void SPEAKER_SetLoop(uint8_t enable);
+
+/**
+ * @brief  재생 속도를 설정합니다. (다음 음부터 적용)
+ * @param  percent: 100이면 원래 속도, 200이면 2배 빠르게 (최소 10)
+ */
+void SPEAKER_SetTempo(uint16_t percent);
+
+/**
+ * @brief  음량을 서서히 줄이며 재생을 중지합니다. (논블로킹)
+ * @param  fade_ms: 음량이 0이 될 때까지의 시간 (ms)
+ */
+void SPEAKER_FadeOut(uint32_t fade_ms);
+
+/**
+ * @brief  RTTTL 문자열을 음 배열로 변환합니다.
+ * @param  rtttl: "이름:d=4,o=5,b=120:8c6,8p,e,g.,..." 형식의 문자열
+ * @param  notes: 변환된 음을 저장할 배열
+ * @param  max_notes: notes 배열의 크기
+ * @retval 변환된 음 개수 (형식이 잘못되었으면 0)
+ * @note   초기화할 때 한 번 변환해두고 SPEAKER_Enqueue로 재생하세요.
+ *         옥타브는 4 ~ 8이며, 옥타브 8보다 높아지는 음(b#8)은 옥타브 8로 제한됩니다.
+ *         음 하나(쉼 포함)의 길이는 최대 65535ms로 제한됩니다. (b=4의 점온음표 등)
+ */
+uint16_t SPEAKER_ParseRTTTL(const char *rtttl, SPEAKER_Note *notes, uint16_t max_notes);
+
 /**
  * @brief  타이머 콜백 함수에서 주기적으로 호출될 함수. 실제 재생 로직을 처리합니다.
  */
 void SPEAKER_Loop(void);
 
 /**
- * @brief  스피커가 현재 재생 중인지 상태를 반환합니다.
+ * @brief  타이머 출력 방식에서 재생 시간, 음 전환, 페이드를 처리합니다.
+ * @note   SysTick_Handler 같은 1ms 주기 인터럽트에서 호출 (메인 루프에서 호출하면 음 전환이 루프 지연만큼 늦어짐)
+ */
+void SPEAKER_Update(void);
+
+/**
+ * @brief  스케줄러용 태스크 함수입니다. (SPEAKER_TASK_PERIOD_MS 주기로 SPEAKER_Update 호출)
+ */
+void SPEAKER_Task(void);
+
+/**
+ * @brief  스피커가 현재 재생 중인지 상태를 반환합니다. (SPEAKER_DDS_Play로 켠 목소리 포함)
  * @retval 0: 정지, 1: 재생 중
  */
 uint8_t SPEAKER_IsPlaying(void);
 
+/**
+ * @brief  DDS 방식에서 목소리 하나의 재생을 시작하거나 바꿉니다. (재생 시간 없이 SPEAKER_DDS_Stop까지 계속)
+ * @param  voice: 목소리 번호 (0 ~ SPEAKER_DDS_VOICES-1, 0번은 SPEAKER_Start/멜로디와 공유)
+ * @param  frequency: 주파수 (Hz, 샘플링 주파수의 절반 미만)
+ * @param  wave: 파형
+ * @param  level: 음량 (0 ~ 255)
+ */
+void SPEAKER_DDS_Play(uint8_t voice, uint32_t frequency, SPEAKER_Wave wave, uint8_t level);
+
+/**
+ * @brief  DDS 방식에서 목소리 하나의 재생을 중지합니다. 모든 목소리가 꺼지면 DMA 출력도 멈춥니다.
+ */
+void SPEAKER_DDS_Stop(uint8_t voice);
+
+/**
+ * @brief  DMA 콜백에서 호출될 함수. 재생이 끝난 절반 버퍼를 다시 합성합니다.
+ */
+void SPEAKER_DMA_HalfCpltCallback(void);
+void SPEAKER_DMA_CpltCallback(void);
+
 
 #endif /* INC_SPEAKER_H_ */
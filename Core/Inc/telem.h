@@ -0,0 +1,82 @@
+/*
+ * telem.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef INC_TELEM_H_
+#define INC_TELEM_H_
+
+#include "main.h"  // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
+
+#define TELEM_MAX_VARS 16          // 등록 가능한 변수 수
+#define TELEM_RECORD_MAX 64        // 레코드 하나의 최대 바이트 수 (머리 8바이트 포함)
+
+// U2C 바이너리 프레임의 msg_id (콘솔 출력 사이에 섞여서 전송됨)
+#define TELEM_FRAME_ID_SCHEMA 0x53   // 'S': 변수 목록 (시작할 때, "telem schema"로 다시 요청)
+#define TELEM_FRAME_ID_RECORD 0x54   // 'T': 레코드 하나
+
+// 변수 형식 (레코드 안에서는 모두 little-endian)
+typedef enum {
+    TELEM_U8,
+    TELEM_I8,
+    TELEM_U16,
+    TELEM_I16,
+    TELEM_U32,
+    TELEM_I32,
+    TELEM_F32,
+    TELEM_TYPE_COUNT
+} TELEM_Type;
+
+// 텔레메트리 통계
+typedef struct {
+    uint32_t samples;     // 타이머에서 만든 레코드 수 (= 마지막 레코드 순번 + 1)
+    uint32_t sent;        // 송신 링 버퍼에 넣은 레코드 수
+    uint32_t overruns;    // 보내기 전에 새 레코드로 덮어써서 잃은 레코드 수
+    uint32_t tx_busy;     // 송신 링 버퍼가 가득 차서 바로 넣지 못한 횟수
+} TELEM_Stats;
+
+/**
+ * @brief 텔레메트리 초기화 (콘솔에 telem 커맨드 등록)
+ * @param htim: 1MHz로 카운트하도록 Prescaler를 설정한 타이머 (global interrupt 활성화)
+ * @note U2C_init 다음에 호출
+ */
+void TELEM_Init(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 변수 등록 (레코드에는 등록한 순서대로 들어감)
+ * @param addr: 변수 주소 (count개 배열이면 첫 원소)
+ * @retval HAL_OK, HAL_ERROR: 자리 또는 레코드 크기 초과, HAL_BUSY: 전송 중에는 등록 불가
+ */
+HAL_StatusTypeDef TELEM_Register(const char *name, const volatile void *addr, TELEM_Type type, uint8_t count);
+
+/**
+ * @brief 값을 함수로 읽는 항목 등록 (KEYPAD16_Get_Key_Bits 등, 반환값의 하위 바이트만 기록)
+ * @note 타이머 인터럽트에서 호출되므로 짧고 기다리지 않는 함수만 사용
+ */
+HAL_StatusTypeDef TELEM_RegisterGetter(const char *name, uint32_t (*getter)(void), TELEM_Type type);
+
+/**
+ * @brief rate_hz 주기로 레코드 만들기 시작 (변수 목록 프레임을 먼저 보냄)
+ * @retval HAL_OK, HAL_ERROR: 초기화 전이거나 rate_hz가 1~10000 밖, 또는 16비트 타이머에서 16Hz 미만 (주기가 ARR을 넘음)
+ */
+HAL_StatusTypeDef TELEM_Start(uint16_t rate_hz);
+void TELEM_Stop(void);
+
+void TELEM_TIM_Callback(void);  // HAL_TIM_PeriodElapsedCallback에서 호출 필요 (TELEM_Init에 넘긴 타이머일 때)
+
+/**
+ * @brief 만들어진 레코드를 U2C 송신 링 버퍼에 넣음 (메인 루프 또는 스케줄러 태스크에서 호출)
+ */
+void TELEM_Task(void);
+
+/**
+ * @brief 레코드가 만들어질 때마다 인터럽트에서 호출할 함수 등록 (TELEM_Task를 이벤트 태스크로 깨우기용)
+ */
+void TELEM_SetReadyHook(void (*hook)(void));
+
+void TELEM_GetStats(TELEM_Stats *stats);
+
+
+#endif /* INC_TELEM_H_ */
@@ -8,7 +8,7 @@
 #ifndef INC_USART2CONSOLE_H_
 #define INC_USART2CONSOLE_H_
 
-#include "stm32f4xx_hal.h"   // MCU에 맞게 변경 필요
+#include "main.h"   // STM32CubeMX가 생성하는 메인 헤더 파일 (MCU에 맞는 HAL 헤더 포함)
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -16,8 +16,30 @@ extern UART_HandleTypeDef huart2;
 #define U2C_USART_CHANNEL &huart2
 
 #define U2C_RX_BUFFER_SIZE 64   // 입력 버퍼 크기
-#define U2C_TX_BUFFER_SIZE 128  // 출력 버퍼 크기
-#define U2C_TX_TIMEOUT_MS 10    // 전송 타임아웃 (ms), U2C_print 함수가 이 시간동안 전송을 재시도
+#define U2C_TX_BUFFER_SIZE 512  // 출력 링 버퍼 크기, U2C_print 호출 시 이 버퍼에 복사된 후 DMA로 전송
+#define U2C_MAX_COMMANDS 64     // 등록 가능한 최대 커맨드 수 (내장 help 포함)
+#define U2C_MAX_ARGS 8          // 커맨드 하나에 허용되는 최대 토큰 수 (커맨드 이름 포함)
+
+// 바이너리 프레임 모드
+// 프레임 구조: 0x00 | COBS( msg_id(1) | payload(n) | CRC16(2, big-endian) ) | 0x00
+// CRC16은 CRC-16/CCITT-FALSE (다항식 0x1021, 초기값 0xFFFF)이며 msg_id와 payload에 대해 계산합니다.
+#define U2C_FRAME_MAX_PAYLOAD (U2C_RX_BUFFER_SIZE - 3)  // 수신 프레임의 최대 payload 길이
+#define U2C_FRAME_ID_TEXT_MODE 0x00                      // 예약된 msg_id: 수신하면 텍스트 모드로 돌아감
+
+// 포맷 출력 옵션
+#define U2C_PRINTF_MAX_ARGS 8   // U2C_printf/U2C_logf 한 번에 넘길 수 있는 최대 인자 수
+// 정의하면 U2C_logf는 포맷 문자열 포인터와 인자만 큐에 넣고, 실제 포맷은 U2C_process에서 합니다. (인터럽트에서도 호출 가능)
+//#define U2C_LOG_DEFERRED
+#define U2C_LOG_QUEUE_SIZE 16   // U2C_LOG_DEFERRED 사용 시 포맷 대기 큐 크기
+
+
+// 스케줄러 태스크 주기 (U2C_Task, 수신 시 U2C_set_rx_hook으로 깨우면 주기와 상관없이 바로 처리)
+#define U2C_TASK_PERIOD_MS 10
+
+// 수신 방식 옵션
+// 정의하면 1바이트 수신 인터럽트 대신 circular DMA + IDLE 라인 감지로 수신합니다. (CubeMX에서 USART2_RX DMA를 Circular로 추가 필요)
+// 정의하지 않으면 기존처럼 1바이트마다 수신 인터럽트를 사용합니다.
+//#define U2C_RX_USE_DMA
 
 
 // 줄바꿈 옵션
@@ -46,14 +68,82 @@ extern UART_HandleTypeDef huart2;
     #define ENTER_CHARACTER "\r"
 #endif
 
+/**
+ * @brief 출력 링 버퍼 통계입니다. `U2C_get_tx_stats`로 읽어옵니다.
+ */
+typedef struct {
+    uint32_t bytes_queued;   // 링 버퍼에 들어간 누적 바이트 수
+    uint32_t bytes_dropped;  // 공간 부족으로 버려진 누적 바이트 수
+    uint16_t high_water;     // 링 버퍼 최대 사용량 (바이트)
+    uint32_t logs_dropped;   // U2C_LOG_DEFERRED 사용 시 큐가 가득 차서 버려진 U2C_logf 호출 수
+} U2C_TxStats;
+
+/**
+ * @brief 입력 링 버퍼 통계입니다. `U2C_get_rx_stats`로 읽어옵니다.
+ */
+typedef struct {
+    uint32_t bytes_dropped;  // 입력 버퍼가 가득 차서 버려진(덮어써진) 누적 바이트 수
+    uint32_t errors;         // UART 수신 에러(overrun, framing 등) 누적 횟수
+    uint32_t frames;         // 바이너리 모드에서 정상 수신한 프레임 수
+    uint32_t frame_errors;   // 바이너리 모드에서 CRC/COBS 오류나 길이 초과로 버려진 프레임 수
+} U2C_RxStats;
+
+/**
+ * @brief 콘솔 동작 모드입니다.
+ */
+typedef enum {
+    U2C_MODE_TEXT,    // 사람이 입력하는 줄 편집 콘솔 (에코, 백스페이스, 커맨드 처리)
+    U2C_MODE_BINARY   // COBS + CRC16 바이너리 프레임 (에코 없음)
+} U2C_Mode;
+
+/**
+ * @brief 커맨드 처리 함수 형식입니다.
+ * @param argc `argv`에 담긴 토큰 수 (커맨드 이름 포함)
+ * @param argv 공백으로 나눈 토큰들, `argv[0]`은 커맨드 이름입니다.
+ * @note `argv`는 내부 커맨드 버퍼를 가리키므로, 함수가 리턴된 후에는 사용하면 안 됩니다.
+ */
+typedef void (*U2C_CommandHandler)(int argc, char *argv[]);
+
+/**
+ * @brief 바이너리 프레임 처리 함수 형식입니다.
+ * @param msg_id 프레임의 메시지 ID
+ * @param payload payload 시작 포인터
+ * @param length payload 길이
+ * @note `payload`는 내부 버퍼를 가리키므로, 함수가 리턴된 후에는 사용하면 안 됩니다.
+ */
+typedef void (*U2C_FrameHandler)(uint8_t msg_id, const uint8_t *payload, uint16_t length);
+
+/**
+ * @brief 긴 출력을 나눠서 이어가는 함수 형식입니다. (`U2C_set_continuation`으로 등록)
+ * @retval true: 출력을 모두 마침 (등록 해제), false: 다음 `U2C_process` 호출 때 다시 호출
+ */
+typedef bool (*U2C_Continuation)(void);
+
 void U2C_init(void);
+HAL_StatusTypeDef U2C_register_command(const char *name, U2C_CommandHandler handler, const char *help);
+
+void U2C_set_mode(U2C_Mode mode);
+U2C_Mode U2C_get_mode(void);
+void U2C_register_frame_handler(U2C_FrameHandler handler);
+HAL_StatusTypeDef U2C_send_frame(uint8_t msg_id, const uint8_t *payload, uint16_t length);
 HAL_StatusTypeDef U2C_print(uint8_t *pString, uint16_t length);
 HAL_StatusTypeDef U2C_println(uint8_t *pString, uint16_t length);
+HAL_StatusTypeDef U2C_printf(const char *format, ...);
+HAL_StatusTypeDef U2C_logf(const char *format, ...);
 
 void U2C_RxCpltCallback(void);  // HAL_UART_RxCpltCallback에서 호출 필요
+void U2C_RxEventCallback(uint16_t size);  // U2C_RX_USE_DMA 사용 시 HAL_UARTEx_RxEventCallback에서 호출 필요
+void U2C_ErrorCallback(void);   // HAL_UART_ErrorCallback에서 호출 필요
 void U2C_process(void);         // main 루프에서 주기적으로 호출
 
 void U2C_TxCpltCallback(void);  // HAL_UART_TxCpltCallback에서 호출 필요
+void U2C_get_tx_stats(U2C_TxStats *stats);
+void U2C_get_rx_stats(U2C_RxStats *stats);
+uint16_t U2C_get_tx_free(void);  // 출력 링 버퍼에 지금 쓸 수 있는 바이트 수
+HAL_StatusTypeDef U2C_set_continuation(U2C_Continuation fn);  // 출력 링 버퍼 공간이 생길 때마다 U2C_process에서 호출할 함수 등록 (help처럼 긴 출력용, 다른 함수가 출력 중이면 HAL_BUSY)
+
+void U2C_set_rx_hook(void (*hook)(void));  // 데이터를 수신할 때마다 인터럽트에서 호출할 함수 등록 (스케줄러 태스크 깨우기용)
+void U2C_Task(void);            // 스케줄러용 태스크 (U2C_process 호출)
 
 
 #endif /* INC_USART2CONSOLE_H_ */
@@ -0,0 +1,431 @@
+/*
+ * i2cbus.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 여러 드라이버가 I²C 버스 하나를 나눠 쓰기 위한 비동기 트랜잭션 큐
+ *   - 우선순위별 고정 크기 큐, 높은 우선순위 큐부터 한 번에 트랜잭션 하나씩 인터럽트 방식으로 전송
+ *   - 완료/오류 인터럽트에서 요청한 쪽의 콜백을 호출하고 바로 다음 트랜잭션을 시작
+ *   - 버스 오류나 타임아웃이 나면 I²C 주변장치를 다시 초기화해서 복구 (선택: SCL 9클럭)
+ *     복구는 I2CBUS_Task(메인 루프)에서 하고, 인터럽트에서는 recover_pending만 표시함
+ */
+
+#include "i2cbus.h"
+
+typedef enum {
+    I2CBUS_KIND_WRITE,
+    I2CBUS_KIND_READ,
+    I2CBUS_KIND_WRITE_READ
+} I2CBUS_Kind;
+
+// 트랜잭션 하나
+typedef struct {
+    uint8_t kind;
+    uint8_t addr;               // 7비트 주소
+    const uint8_t *wdata;
+    uint16_t wlen;
+    uint8_t *rdata;
+    uint16_t rlen;
+    I2CBUS_Callback callback;
+    void *context;
+    uint32_t submit_tick;       // 큐에 들어간 시점 (대기 시간 통계용)
+} I2CBUS_Xfer;
+
+static I2C_HandleTypeDef *bus_hi2c = NULL;
+
+// 우선순위별 대기 큐 (생산자: 메인 루프/인터럽트, 소비자: I²C 인터럽트)
+// 맨 앞 트랜잭션은 끝날 때까지 큐에 남아 있음 (active가 가리킴)
+static I2CBUS_Xfer queues[I2CBUS_PRIO_COUNT][I2CBUS_QUEUE_SIZE];
+static volatile uint8_t q_head[I2CBUS_PRIO_COUNT];
+static volatile uint8_t q_tail[I2CBUS_PRIO_COUNT];
+
+static I2CBUS_Xfer *volatile active = NULL;  // 진행 중인 트랜잭션 (NULL이면 버스가 쉬는 중)
+static uint8_t active_prio = 0;
+static uint8_t active_started = 0;   // 0이면 HAL이 시작을 거절해서 I2CBUS_Task에서 재시도
+static uint8_t active_phase = 0;     // WRITE_READ에서 1이면 읽기 단계
+static uint32_t active_start = 0;    // 전송을 시작한 시점 (타임아웃 기준)
+static volatile uint8_t bus_blocking = 0;  // I2CBUS_WriteBlocking이 버스를 사용 중
+static volatile uint8_t recover_pending = 0;  // 버스 복구가 필요함 (I2CBUS_Task에서 복구할 때까지 다음 트랜잭션을 시작하지 않음)
+
+static I2CBUS_Stats stats;
+static uint32_t stats_start = 0;
+
+
+void I2CBUS_Init(I2C_HandleTypeDef *hi2c)
+{
+    if (bus_hi2c == hi2c)
+    {
+        return;
+    }
+    bus_hi2c = hi2c;
+    for (int p = 0; p < I2CBUS_PRIO_COUNT; p++)
+    {
+        q_head[p] = 0;
+        q_tail[p] = 0;
+    }
+    active = NULL;
+    bus_blocking = 0;
+    recover_pending = 0;
+    I2CBUS_ResetStats();
+}
+
+// 버스 복구: 주변장치를 껐다가 다시 초기화 (HAL 상태와 BUSY 플래그도 함께 초기화됨)
+// 메인 루프에서만 호출 (HAL_I2C_DeInit/Init은 MSP 설정을 다시 하므로 인터럽트에서 부르지 않음)
+static void I2CBUS_Recover(void)
+{
+    stats.recoveries++;
+    HAL_I2C_DeInit(bus_hi2c);
+
+#ifdef I2CBUS_RECOVERY_PINS
+    // 바이트 중간에 멈춘 슬레이브가 SDA를 놓을 때까지 SCL을 최대 9번 토글한 뒤 STOP 조건을 만듦
+    // (100kHz 기준 반 클럭 5us를 대충 맞춘 지연, 인터럽트를 막은 상태에서도 호출되므로 HAL_Delay를 쓰지 않음)
+    volatile uint32_t d;
+    const uint32_t half = SystemCoreClock / 800000;
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_SET);
+    gpio.Pin = I2CBUS_SCL_PIN;
+    HAL_GPIO_Init(I2CBUS_SCL_PORT, &gpio);
+    gpio.Pin = I2CBUS_SDA_PIN;
+    HAL_GPIO_Init(I2CBUS_SDA_PORT, &gpio);
+
+    for (int i = 0; i < 9 && HAL_GPIO_ReadPin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN) == GPIO_PIN_RESET; i++)
+    {
+        HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_RESET);
+        for (d = 0; d < half; d++);
+        HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_SET);
+        for (d = 0; d < half; d++);
+    }
+    // STOP: SCL이 high일 때 SDA low -> high
+    HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_RESET);
+    for (d = 0; d < half; d++);
+    HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_SET);
+    for (d = 0; d < half; d++);
+#endif
+
+    HAL_I2C_Init(bus_hi2c);  // HAL_I2C_MspInit이 핀을 다시 I²C로 설정
+}
+
+// 진행 중인 트랜잭션의 전송 시작 (WRITE_READ는 쓰기 단계)
+static HAL_StatusTypeDef I2CBUS_Start_xfer(I2CBUS_Xfer *xfer)
+{
+    uint16_t dev = (uint16_t)xfer->addr << 1;
+    switch (xfer->kind)
+    {
+    case I2CBUS_KIND_WRITE:
+        return HAL_I2C_Master_Transmit_IT(bus_hi2c, dev, (uint8_t *)xfer->wdata, xfer->wlen);
+    case I2CBUS_KIND_READ:
+        return HAL_I2C_Master_Receive_IT(bus_hi2c, dev, xfer->rdata, xfer->rlen);
+    default:
+        // STOP 없이 끝내고 읽기 단계에서 반복 시작 조건을 보냄
+        return HAL_I2C_Master_Seq_Transmit_IT(bus_hi2c, dev, (uint8_t *)xfer->wdata, xfer->wlen, I2C_FIRST_FRAME);
+    }
+}
+
+// [인터럽트 또는 인터럽트 차단 상태에서 호출] 버스가 쉬고 있으면 가장 높은 우선순위 큐의 맨 앞 트랜잭션 시작
+static void I2CBUS_Start_next(void)
+{
+    if (active != NULL || bus_blocking || recover_pending)
+    {
+        return;
+    }
+    for (int p = 0; p < I2CBUS_PRIO_COUNT; p++)
+    {
+        if (q_tail[p] == q_head[p])
+        {
+            continue;
+        }
+
+        I2CBUS_Xfer *xfer = &queues[p][q_tail[p]];
+        active = xfer;
+        active_prio = p;
+        active_phase = 0;
+        active_start = HAL_GetTick();
+
+        uint32_t wait = active_start - xfer->submit_tick;
+        stats.total_wait_ms += wait;
+        if (wait > stats.max_wait_ms)
+        {
+            stats.max_wait_ms = wait;
+        }
+
+        // 다른 코드가 같은 핸들을 직접 사용 중이면 HAL이 거절하므로 I2CBUS_Task에서 다시 시도
+        active_started = (I2CBUS_Start_xfer(xfer) == HAL_OK);
+        return;
+    }
+}
+
+// [인터럽트 또는 인터럽트 차단 상태에서 호출] 진행 중인 트랜잭션을 큐에서 빼고 콜백 호출, 다음 트랜잭션 시작
+static void I2CBUS_Finish(I2CBUS_Result result)
+{
+    I2CBUS_Xfer *xfer = active;
+    I2CBUS_Callback callback = xfer->callback;
+    void *context = xfer->context;
+
+    switch (result)
+    {
+    case I2CBUS_OK:
+        stats.completed++;
+        stats.bytes += xfer->wlen + xfer->rlen + ((xfer->kind == I2CBUS_KIND_WRITE_READ) ? 2 : 1);
+        break;
+    case I2CBUS_NACK:
+        stats.nacks++;
+        break;
+    case I2CBUS_BUS_ERROR:
+        stats.bus_errors++;
+        break;
+    default:
+        stats.timeouts++;
+        break;
+    }
+
+    // 콜백에서 새 트랜잭션을 요청할 수 있도록 먼저 자리를 비움
+    q_tail[active_prio] = (q_tail[active_prio] + 1) % I2CBUS_QUEUE_SIZE;
+    active = NULL;
+    if (callback != NULL)
+    {
+        callback(result, context);
+    }
+    I2CBUS_Start_next();
+}
+
+static HAL_StatusTypeDef I2CBUS_Submit(const I2CBUS_Xfer *xfer, I2CBUS_Priority prio)
+{
+    if (bus_hi2c == NULL || prio >= I2CBUS_PRIO_COUNT)
+    {
+        return HAL_ERROR;
+    }
+
+    // 메인 루프와 인터럽트(다른 트랜잭션의 완료 콜백 등)가 동시에 요청할 수 있으므로 자리를 잡는 동안 인터럽트를 막습니다.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t next_head = (q_head[prio] + 1) % I2CBUS_QUEUE_SIZE;
+    if (next_head == q_tail[prio])
+    {
+        stats.dropped++;
+        __set_PRIMASK(primask);
+        return HAL_BUSY;
+    }
+    queues[prio][q_head[prio]] = *xfer;
+    queues[prio][q_head[prio]].submit_tick = HAL_GetTick();
+    q_head[prio] = next_head;
+    stats.submitted++;
+
+    uint8_t depth = (q_head[prio] + I2CBUS_QUEUE_SIZE - q_tail[prio]) % I2CBUS_QUEUE_SIZE;
+    if (depth > stats.max_depth[prio])
+    {
+        stats.max_depth[prio] = depth;
+    }
+
+    I2CBUS_Start_next();
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef I2CBUS_Write(uint8_t addr, const uint8_t *data, uint16_t len,
+                               I2CBUS_Priority prio, I2CBUS_Callback callback, void *context)
+{
+    if (len == 0)
+    {
+        return HAL_ERROR;
+    }
+    I2CBUS_Xfer xfer = {I2CBUS_KIND_WRITE, addr, data, len, NULL, 0, callback, context, 0};
+    return I2CBUS_Submit(&xfer, prio);
+}
+
+HAL_StatusTypeDef I2CBUS_Read(uint8_t addr, uint8_t *data, uint16_t len,
+                              I2CBUS_Priority prio, I2CBUS_Callback callback, void *context)
+{
+    if (len == 0)
+    {
+        return HAL_ERROR;
+    }
+    I2CBUS_Xfer xfer = {I2CBUS_KIND_READ, addr, NULL, 0, data, len, callback, context, 0};
+    return I2CBUS_Submit(&xfer, prio);
+}
+
+HAL_StatusTypeDef I2CBUS_WriteRead(uint8_t addr, const uint8_t *wdata, uint16_t wlen, uint8_t *rdata, uint16_t rlen,
+                                   I2CBUS_Priority prio, I2CBUS_Callback callback, void *context)
+{
+    if (wlen == 0 || rlen == 0)
+    {
+        return HAL_ERROR;
+    }
+    I2CBUS_Xfer xfer = {I2CBUS_KIND_WRITE_READ, addr, wdata, wlen, rdata, rlen, callback, context, 0};
+    return I2CBUS_Submit(&xfer, prio);
+}
+
+HAL_StatusTypeDef I2CBUS_WriteBlocking(uint8_t addr, const uint8_t *data, uint16_t len)
+{
+    if (bus_hi2c == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    // 진행 중인 트랜잭션이 끝나면 버스를 차지 (대기 중인 트랜잭션은 blocking 전송 뒤로 미룸)
+    uint32_t primask;
+    while (1)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (active == NULL && !recover_pending)
+        {
+            bus_blocking = 1;
+            __set_PRIMASK(primask);
+            break;
+        }
+        __set_PRIMASK(primask);
+        I2CBUS_Task();  // 인터럽트가 오지 않아도 타임아웃으로 빠져나오고, 대기 중인 복구도 여기서 진행
+    }
+
+    HAL_StatusTypeDef status = HAL_I2C_Master_Transmit(bus_hi2c, (uint16_t)addr << 1, (uint8_t *)data, len, I2CBUS_TIMEOUT_MS);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    stats.submitted++;
+    if (status == HAL_OK)
+    {
+        stats.completed++;
+        stats.bytes += len + 1;
+    }
+    else if (HAL_I2C_GetError(bus_hi2c) == HAL_I2C_ERROR_AF)
+    {
+        stats.nacks++;
+    }
+    else
+    {
+        if (status == HAL_TIMEOUT)
+        {
+            stats.timeouts++;
+        }
+        else
+        {
+            stats.bus_errors++;
+        }
+        recover_pending = 1;  // 인터럽트를 막은 채로 복구하지 않도록 I2CBUS_Task에 맡김
+    }
+    bus_blocking = 0;
+    I2CBUS_Start_next();
+    __set_PRIMASK(primask);
+    return status;
+}
+
+uint8_t I2CBUS_IsBusy(void)
+{
+    if (active != NULL || bus_blocking || recover_pending)
+    {
+        return 1;
+    }
+    for (int p = 0; p < I2CBUS_PRIO_COUNT; p++)
+    {
+        if (q_tail[p] != q_head[p])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void I2CBUS_Task(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (active != NULL)
+    {
+        if (HAL_GetTick() - active_start >= I2CBUS_TIMEOUT_MS)
+        {
+            // 완료 인터럽트가 오지 않음 (SDA가 잡혀 있는 등): 전송을 끊고 아래에서 버스를 복구
+            recover_pending = 1;
+            I2CBUS_Finish(I2CBUS_TIMEOUT);
+        }
+        else if (!active_started)
+        {
+            active_started = (I2CBUS_Start_xfer(active) == HAL_OK);
+        }
+    }
+    __set_PRIMASK(primask);
+
+    if (!recover_pending)
+    {
+        return;
+    }
+    // 진행 중인 트랜잭션이 없고 recover_pending이 새 트랜잭션 시작을 막고 있으므로, 인터럽트를 켠 채로 복구
+    I2CBUS_Recover();
+    primask = __get_PRIMASK();
+    __disable_irq();
+    recover_pending = 0;
+    I2CBUS_Start_next();
+    __set_PRIMASK(primask);
+}
+
+void I2CBUS_TxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != bus_hi2c || active == NULL || !active_started)
+    {
+        return;
+    }
+
+    if (active->kind == I2CBUS_KIND_WRITE_READ && active_phase == 0)
+    {
+        // 쓰기 단계 끝: 반복 시작 조건으로 읽기 단계를 시작하고, 마지막에 STOP
+        active_phase = 1;
+        if (HAL_I2C_Master_Seq_Receive_IT(bus_hi2c, (uint16_t)active->addr << 1, active->rdata, active->rlen,
+                                          I2C_LAST_FRAME) != HAL_OK)
+        {
+            recover_pending = 1;  // I2CBUS_Task에서 복구
+            I2CBUS_Finish(I2CBUS_BUS_ERROR);
+        }
+        return;
+    }
+    I2CBUS_Finish(I2CBUS_OK);
+}
+
+void I2CBUS_RxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != bus_hi2c || active == NULL || !active_started)
+    {
+        return;
+    }
+    I2CBUS_Finish(I2CBUS_OK);
+}
+
+void I2CBUS_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != bus_hi2c || active == NULL || !active_started)
+    {
+        return;
+    }
+
+    if (HAL_I2C_GetError(hi2c) == HAL_I2C_ERROR_AF)
+    {
+        // NACK: HAL이 STOP 조건을 보내고 끝내므로 버스는 정상
+        I2CBUS_Finish(I2CBUS_NACK);
+    }
+    else
+    {
+        recover_pending = 1;  // I2CBUS_Task에서 복구
+        I2CBUS_Finish(I2CBUS_BUS_ERROR);
+    }
+}
+
+void I2CBUS_GetStats(I2CBUS_Stats *out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    out->elapsed_ms = HAL_GetTick() - stats_start;
+    __set_PRIMASK(primask);
+}
+
+void I2CBUS_ResetStats(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats = (I2CBUS_Stats){0};
+    stats_start = HAL_GetTick();
+    __set_PRIMASK(primask);
+}
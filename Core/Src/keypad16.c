@@ -8,7 +8,7 @@
   */
 
 #include "keypad16.h"
-#include <string.h> // memset, memcpy 함수 사용을 위해 포함
+#include "perf.h"
 
 /* Private-like variables (static) */
 
@@ -28,15 +28,35 @@ static const uint16_t row_pins[4] = {R1_PIN, R2_PIN, R3_PIN, R4_PIN};
 static GPIO_TypeDef* col_ports[4] = {C1_PORT, C2_PORT, C3_PORT, C4_PORT};
 static const uint16_t col_pins[4] = {C1_PIN, C2_PIN, C3_PIN, C4_PIN};
 
-// 현재 키패드의 물리적인 눌림 상태를 저장하는 변수 (0: 안눌림, 1: 눌림)
-static uint8_t key_state[4][4];
-// 이전 스캔 시점의 키패드 상태를 저장하는 변수 (Rising Edge 감지를 위함)
-static uint8_t last_key_state[4][4];
+// 디바운스된 키패드 눌림 상태를 저장하는 비트맵 (bit (r*4 + c), 0: 안눌림, 1: 눌림)
+static volatile uint16_t key_bits;
+// 마지막 스캔에서 읽은 디바운스 전 상태 비트맵
+static uint16_t raw_bits;
+// 키별 디바운스 카운터 (2비트 카운터 16개를 비트 평면 2개로 저장: 16개 키를 비트 연산으로 한 번에 처리)
+static uint16_t debounce_cnt0;
+static uint16_t debounce_cnt1;
+
+// 키별 눌린 시점과 다음 길게 누름/반복 이벤트 시점 (HAL_GetTick 기준)
+static uint32_t hold_deadline[16];
+// 길게 누름 이벤트를 이미 보낸 키 비트맵 (이후에는 반복 이벤트를 보냄)
+static uint16_t long_press_bits;
+
+// 키 이벤트 큐 (생산자: KEYPAD16_Scan, 소비자: KEYPAD16_Get_Event)
+// head는 생산자만, tail은 소비자만 바꾸므로 스캔이 인터럽트에서 일어나도 잠금 없이 사용할 수 있습니다.
+static KEYPAD16_Event event_queue[KEYPAD16_EVENT_QUEUE_SIZE];
+static volatile uint16_t event_head = 0;
+static volatile uint16_t event_tail = 0;
+static volatile uint32_t dropped_events = 0;
 
 // 스캔을 통해 확인된 '계속 눌리고 있는' 키
-static char pressed_key = NO_KEY_PRESSED;
-// 스캔을 통해 확인된 '새롭게 눌린' 키
-static char triggered_key = NO_KEY_PRESSED;
+static volatile char pressed_key = NO_KEY_PRESSED;
+// 스캔을 통해 확인된 '새롭게 눌린' 키 (KEYPAD16_Get_Triggered_Key로 읽어갈 때까지 유지)
+static volatile char triggered_key = NO_KEY_PRESSED;
+
+// 인터럽트 구동 방식에서 스캔에 사용할 타이머 (NULL이면 폴링 방식)
+static TIM_HandleTypeDef *keypad_htim = NULL;
+// 인터럽트 구동 방식에서 EXTI 대기 상태인지 여부
+static volatile uint8_t is_idle = 0;
 
 
 /**
@@ -45,24 +65,161 @@ static char triggered_key = NO_KEY_PRESSED;
 void KEYPAD16_Init(void)
 {
     // 모든 키 상태를 '안눌림'으로 초기화합니다.
-    memset(key_state, 0, sizeof(key_state));
-    memset(last_key_state, 0, sizeof(last_key_state));
+    key_bits = 0;
+    raw_bits = 0;
+    debounce_cnt0 = 0;
+    debounce_cnt1 = 0;
+    long_press_bits = 0;
+    event_head = 0;
+    event_tail = 0;
+    dropped_events = 0;
     pressed_key = NO_KEY_PRESSED;
     triggered_key = NO_KEY_PRESSED;
 }
 
 /**
- * @brief 키패드 매트릭스를 스캔하여 현재 눌린 키를 감지합니다.
+ * @brief 모든 행을 LOW로 두고 열 핀의 EXTI 인터럽트를 기다리는 대기 상태로 들어갑니다.
  */
-void KEYPAD16_Scan(void)
+static void KEYPAD16_Enter_Idle(void)
 {
-    // 스캔 시작 전, 현재 키 상태를 이전 상태로 복사합니다.
-    // 이를 통해 현재 스캔과 이전 스캔을 비교하여 '새롭게 눌린 키'를 감지할 수 있습니다.
-    memcpy(last_key_state, key_state, sizeof(key_state));
+    // 모든 행을 LOW로 두면, 어떤 키가 눌려도 해당 열이 LOW가 되어 EXTI(Falling edge)가 발생합니다.
+    HAL_GPIO_WritePin(R1_PORT, R1_PIN, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(R2_PORT, R2_PIN, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(R3_PORT, R3_PIN, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(R4_PORT, R4_PIN, GPIO_PIN_RESET);
 
-    // 이번 스캔 주기의 결과 변수들을 초기화합니다.
-    pressed_key = NO_KEY_PRESSED;
-    triggered_key = NO_KEY_PRESSED;
+    // 스캔 중 행 전환으로 생긴 pending 비트를 지우고 열 핀의 EXTI 인터럽트를 켭니다.
+    __HAL_GPIO_EXTI_CLEAR_IT(KEYPAD16_COL_PINS);
+    is_idle = 1;
+    EXTI->IMR |= KEYPAD16_COL_PINS;
+
+    // EXTI를 켜기 직전에 키가 눌렸다면 Falling edge를 놓쳤을 수 있으므로, 열 상태를 직접 확인합니다.
+    if (HAL_GPIO_ReadPin(C1_PORT, C1_PIN) == GPIO_PIN_RESET ||
+        HAL_GPIO_ReadPin(C2_PORT, C2_PIN) == GPIO_PIN_RESET ||
+        HAL_GPIO_ReadPin(C3_PORT, C3_PIN) == GPIO_PIN_RESET ||
+        HAL_GPIO_ReadPin(C4_PORT, C4_PIN) == GPIO_PIN_RESET)
+    {
+        KEYPAD16_EXTI_Callback(KEYPAD16_COL_PINS);
+    }
+}
+
+/**
+ * @brief 키패드 드라이버를 인터럽트 구동 방식으로 초기화합니다.
+ */
+void KEYPAD16_Init_IT(TIM_HandleTypeDef *htim)
+{
+    KEYPAD16_Init();
+    keypad_htim = htim;
+    KEYPAD16_Enter_Idle();
+}
+
+/**
+ * @brief 열 핀의 EXTI 인터럽트를 처리합니다.
+ */
+void KEYPAD16_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (keypad_htim == NULL || !is_idle || (GPIO_Pin & KEYPAD16_COL_PINS) == 0)
+    {
+        return;
+    }
+
+    // 스캔 중에는 행 전환 때마다 열 핀이 바뀌므로 EXTI 인터럽트를 끄고, 타이머로 스캔을 시작합니다.
+    EXTI->IMR &= ~KEYPAD16_COL_PINS;
+    is_idle = 0;
+    HAL_TIM_Base_Start_IT(keypad_htim);
+}
+
+/**
+ * @brief 키가 눌려있는 동안 타이머 주기마다 키패드를 스캔합니다.
+ */
+void KEYPAD16_TIM_Callback(void)
+{
+    if (keypad_htim == NULL || is_idle)
+    {
+        return;
+    }
+
+    KEYPAD16_Scan();
+
+    // 모든 키가 떼지고 디바운스까지 끝나면 스캔을 멈추고 다시 EXTI 대기 상태로 돌아갑니다.
+    if (key_bits == 0 && raw_bits == 0)
+    {
+        HAL_TIM_Base_Stop_IT(keypad_htim);
+        KEYPAD16_Enter_Idle();
+    }
+}
+
+/**
+ * @brief 인터럽트 구동 방식에서 EXTI 대기(스캔 정지) 상태인지 반환합니다.
+ */
+uint8_t KEYPAD16_IsIdle(void)
+{
+    return is_idle;
+}
+
+/**
+ * @brief 스케줄러용 태스크 함수입니다. 폴링 방식일 때만 스캔합니다.
+ */
+void KEYPAD16_Task(void)
+{
+    if (keypad_htim == NULL)
+    {
+        KEYPAD16_Scan();
+    }
+}
+
+/**
+ * @brief [빠른 스캔] BSRR/IDR 레지스터를 직접 사용하여 키패드 매트릭스를 스캔합니다.
+ * @note  행과 열이 모두 같은 포트에 있을 때만 사용합니다. (KEYPAD16_SAME_PORT)
+ *        행마다 BSRR 쓰기 1번(현재 행만 LOW, 나머지 행 HIGH)과 IDR 읽기 1번으로 4개 키를 한 번에 읽습니다.
+ * @retval uint16_t 눌린 키 비트맵
+ */
+static uint16_t KEYPAD16_Scan_Port(void)
+{
+    GPIO_TypeDef *port = R1_PORT;
+    uint16_t bits = 0;
+
+    for (int r = 0; r < 4; ++r)
+    {
+        // BSRR 하위 16비트는 SET, 상위 16비트는 RESET이므로, 한 번의 쓰기로 현재 행만 LOW로 만듭니다.
+        uint32_t row_pin = row_pins[r];
+        port->BSRR = (KEYPAD16_ROW_PINS & ~row_pin) | (row_pin << 16);
+
+        // 이전 행에서 LOW였던 열이 풀업으로 다시 HIGH가 될 때까지 기다립니다.
+        for (volatile int i = 0; i < KEYPAD16_SETTLE_LOOPS; ++i)
+        {
+        }
+
+        // 눌린 키의 열은 LOW이므로 반전한 뒤 열 핀만 남깁니다.
+        uint32_t cols = ~port->IDR & KEYPAD16_COL_PINS;
+
+        uint16_t row_bits;
+        if (C2_PIN == (C1_PIN << 1) && C3_PIN == (C1_PIN << 2) && C4_PIN == (C1_PIN << 3))
+        {
+            // 열 핀이 연속되어 있으면 시프트 한 번으로 4비트를 꺼냅니다. (C1_PIN은 2의 거듭제곱 상수)
+            row_bits = (uint16_t)(cols / C1_PIN);
+        }
+        else
+        {
+            row_bits = ((cols & C1_PIN) ? 0x1 : 0) | ((cols & C2_PIN) ? 0x2 : 0) |
+                       ((cols & C3_PIN) ? 0x4 : 0) | ((cols & C4_PIN) ? 0x8 : 0);
+        }
+        bits |= row_bits << (r * 4);
+    }
+
+    // 스캔이 끝난 후 모든 행을 다시 HIGH로 설정하여 다음 스캔을 준비합니다.
+    port->BSRR = KEYPAD16_ROW_PINS;
+    return bits;
+}
+
+/**
+ * @brief [기본 스캔] HAL_GPIO 함수로 핀을 하나씩 읽어 키패드 매트릭스를 스캔합니다.
+ * @note  행/열 핀이 여러 포트에 나뉘어 있을 때 사용합니다.
+ * @retval uint16_t 눌린 키 비트맵
+ */
+static uint16_t KEYPAD16_Scan_Pins(void)
+{
+    uint16_t bits = 0;
 
     // 각 행(Row)을 순차적으로 스캔합니다.
     for (int r = 0; r < 4; ++r)
@@ -83,37 +240,165 @@ void KEYPAD16_Scan(void)
             // 만약 키가 눌리면, LOW 신호를 출력 중인 행과 물리적으로 연결되어 LOW 상태가 됩니다.
             if (HAL_GPIO_ReadPin(col_ports[c], col_pins[c]) == GPIO_PIN_RESET)
             {
-                // --- 키 눌림 감지됨 ---
-
-                // 현재 키의 물리적 상태를 '눌림(1)'으로 기록합니다.
-                key_state[r][c] = 1;
-
-                // '계속 눌리고 있는 키' 변수에 현재 키 문자를 저장합니다.
-                // (만약 다른 키가 이어서 눌리면 이 값은 덮어쓰여집니다.)
-                pressed_key = keymap[r][c];
-
-                // '새롭게 눌린 키(Rising Edge)'인지 확인합니다.
-                // 이전 스캔(last_key_state)에서는 '안눌림(0)'이었고,
-                // 현재 스캔(key_state)에서 '눌림(1)'이면 새로운 입력입니다.
-                if (last_key_state[r][c] == 0)
-                {
-                    triggered_key = keymap[r][c];
-                }
-            }
-            else
-            {
-                // --- 키 안눌림 감지됨 ---
-                // 현재 키의 물리적 상태를 '안눌림(0)'으로 기록합니다.
-                key_state[r][c] = 0;
+                bits |= 1u << (r * 4 + c);
             }
         }
     }
-    
+
     // 3. 스캔이 끝난 후 모든 행을 다시 HIGH로 설정하여 다음 스캔을 준비합니다.
     HAL_GPIO_WritePin(R1_PORT, R1_PIN, GPIO_PIN_SET);
     HAL_GPIO_WritePin(R2_PORT, R2_PIN, GPIO_PIN_SET);
     HAL_GPIO_WritePin(R3_PORT, R3_PIN, GPIO_PIN_SET);
     HAL_GPIO_WritePin(R4_PORT, R4_PIN, GPIO_PIN_SET);
+    return bits;
+}
+
+/**
+ * @brief 비트맵에서 스캔 순서상 마지막 키(가장 높은 비트)의 문자를 반환합니다.
+ */
+static char KEYPAD16_Last_Key(uint16_t bits)
+{
+    if (bits == 0)
+    {
+        return NO_KEY_PRESSED;
+    }
+    int idx = 31 - __builtin_clz(bits);
+    return keymap[idx / 4][idx % 4];
+}
+
+/**
+ * @brief 키 이벤트 큐에 이벤트를 넣습니다. (생산자)
+ */
+static void KEYPAD16_Push_Event(int idx, KEYPAD16_EventType type, uint32_t tick)
+{
+    uint16_t head = event_head;
+    uint16_t next_head = (head + 1) & (KEYPAD16_EVENT_QUEUE_SIZE - 1);
+    if (next_head == event_tail)
+    {
+        dropped_events++;
+        return;
+    }
+
+    event_queue[head].key = keymap[idx / 4][idx % 4];
+    event_queue[head].type = type;
+    event_queue[head].tick = tick;
+    event_head = next_head;
+}
+
+/**
+ * @brief 키패드 매트릭스를 스캔하여 현재 눌린 키를 감지합니다.
+ */
+void KEYPAD16_Scan(void)
+{
+    PERF_BEGIN(PERF_KEYPAD16_SCAN);
+
+    // 포트 구성은 컴파일 시점에 정해지므로, 사용하지 않는 쪽 코드는 컴파일러가 제거합니다.
+    uint16_t raw;
+    if (KEYPAD16_SAME_PORT)
+    {
+        raw = KEYPAD16_Scan_Port();
+    }
+    else
+    {
+        raw = KEYPAD16_Scan_Pins();
+    }
+    raw_bits = raw;
+
+    // 디바운스: 읽은 값이 현재 상태와 다른 키만 카운터를 올리고, 같아지면 카운터를 0으로 되돌립니다.
+    // 4회 연속으로 다르게 읽힌 키만 상태가 바뀝니다. (2비트 vertical counter)
+    uint16_t delta = raw ^ key_bits;
+    debounce_cnt1 = (debounce_cnt1 ^ debounce_cnt0) & delta;
+    debounce_cnt0 = ~debounce_cnt0 & delta;
+    uint16_t toggled = delta & ~(debounce_cnt0 | debounce_cnt1);
+
+    uint16_t bits = key_bits ^ toggled;
+    key_bits = bits;
+
+    uint32_t now = HAL_GetTick();
+    uint16_t released = toggled & ~bits;
+    uint16_t pressed = toggled & bits;
+
+    while (released != 0)
+    {
+        int idx = __builtin_ctz(released);
+        released &= released - 1;
+        KEYPAD16_Push_Event(idx, KEYPAD16_EVENT_RELEASE, now);
+    }
+
+    long_press_bits &= bits;
+    uint16_t held = bits & ~pressed;
+    while (held != 0)
+    {
+        // 계속 눌려있는 키는 길게 누름/반복 시점이 되었는지 확인합니다.
+        int idx = __builtin_ctz(held);
+        held &= held - 1;
+        if ((int32_t)(now - hold_deadline[idx]) >= 0)
+        {
+            if (long_press_bits & (1u << idx))
+            {
+                KEYPAD16_Push_Event(idx, KEYPAD16_EVENT_REPEAT, now);
+            }
+            else
+            {
+                long_press_bits |= 1u << idx;
+                KEYPAD16_Push_Event(idx, KEYPAD16_EVENT_LONG_PRESS, now);
+            }
+            hold_deadline[idx] = now + KEYPAD16_REPEAT_MS;
+        }
+    }
+
+    uint16_t new_bits = pressed;
+    while (pressed != 0)
+    {
+        int idx = __builtin_ctz(pressed);
+        pressed &= pressed - 1;
+        hold_deadline[idx] = now + KEYPAD16_LONG_PRESS_MS;
+        KEYPAD16_Push_Event(idx, KEYPAD16_EVENT_PRESS, now);
+    }
+
+    // '계속 눌리고 있는 키'는 스캔 순서상 마지막으로 감지된 키입니다.
+    pressed_key = KEYPAD16_Last_Key(bits);
+
+    // 디바운스 후 새로 눌린 키가 '새롭게 눌린 키(Rising Edge)'입니다.
+    // ('새롭게 눌린 키'는 KEYPAD16_Get_Triggered_Key로 읽어갈 때까지 유지합니다.)
+    if (new_bits != 0)
+    {
+        triggered_key = KEYPAD16_Last_Key(new_bits);
+    }
+
+    PERF_END(PERF_KEYPAD16_SCAN);
+}
+
+/**
+ * @brief 키 이벤트 큐에서 가장 오래된 이벤트 하나를 꺼냅니다. (소비자)
+ */
+uint8_t KEYPAD16_Get_Event(KEYPAD16_Event *event)
+{
+    uint16_t tail = event_tail;
+    if (tail == event_head)
+    {
+        return 0;
+    }
+
+    *event = event_queue[tail];
+    event_tail = (tail + 1) & (KEYPAD16_EVENT_QUEUE_SIZE - 1);
+    return 1;
+}
+
+/**
+ * @brief 키 이벤트 큐가 가득 차서 버려진 이벤트 수를 반환합니다.
+ */
+uint32_t KEYPAD16_Get_Dropped_Events(void)
+{
+    return dropped_events;
+}
+
+/**
+ * @brief 디바운스된 현재 눌림 상태를 16비트 비트맵으로 반환합니다.
+ */
+uint16_t KEYPAD16_Get_Key_Bits(void)
+{
+    return key_bits;
 }
 
 /**
@@ -129,5 +414,11 @@ char KEYPAD16_Get_Pressed_Key(void)
  */
 char KEYPAD16_Get_Triggered_Key(void)
 {
-    return triggered_key;
+    // 인터럽트 구동 방식에서는 읽고 지우는 사이에 스캔이 끼어들지 않도록 합니다.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    char key = triggered_key;
+    triggered_key = NO_KEY_PRESSED;
+    __set_PRIMASK(primask);
+    return key;
 }
\ No newline at end of file
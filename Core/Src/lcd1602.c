@@ -1,17 +1,206 @@
 #include "lcd1602.h"
+#include "i2cbus.h"
+#include "perf.h"
+
+// 비동기 모드의 I²C 트랜잭션 하나
+typedef struct
+{
+    uint8_t len;                    // 전송할 바이트 수
+    uint8_t buf[LCD_OP_MAX_BYTES];  // 전송할 데이터 (control 바이트 포함)
+    uint16_t wait_us;               // 전송 후 LCD가 명령을 실행하는 데 걸리는 시간
+} LCD_Op;
+
+// 비동기 모드 전송 대기 큐 (생산자: 메인 루프, 소비자: I²C/타이머 인터럽트)
+static LCD_Op lcd_queue[LCD_QUEUE_SIZE];
+static volatile uint16_t lcd_head = 0;
+static volatile uint16_t lcd_tail = 0;
+
+// 비동기 모드에서 사용할 타이머 (NULL이면 기존 blocking 방식)
+static TIM_HandleTypeDef *lcd_htim = NULL;
+// 큐의 맨 앞 트랜잭션을 처리 중인지 여부
+static volatile uint8_t lcd_active = 0;
+// 전송을 마치고 명령 실행 시간을 기다리는 중인지 여부 (0이면 타이머는 전송 재시도용)
+static volatile uint8_t lcd_exec_wait = 0;
+// 큐가 모두 처리되면 호출될 함수
+static void (*lcd_done_callback)(void) = NULL;
+// 큐가 가득 차서 버린 트랜잭션 수
+static volatile uint32_t lcd_dropped = 0;
+
+// 프레임버퍼 (애플리케이션이 원하는 화면)
+static uint8_t lcd_fb[LCD_ROWS][LCD_COLS];
+// 마지막으로 LCD에 전송한 화면
+static uint8_t lcd_shown[LCD_ROWS][LCD_COLS];
+// 1이면 lcd_shown을 믿을 수 없으므로 다음 LCD_Flush에서 전체를 전송
+// (전송 실패 시 인터럽트에서도 설정되므로 LCD_Flush는 시작할 때 읽고 지움)
+static volatile uint8_t lcd_invalid = 0;
+// 프레임버퍼 커서 위치 (0부터 시작)
+static int lcd_cursor_row = 0;
+static int lcd_cursor_col = 0;
+
+// 글리프 캐시
+#define LCD_NO_GLYPH 0xFF
+static const uint8_t *lcd_glyphs[LCD_MAX_GLYPHS];      // 등록된 글리프 비트맵
+static uint8_t lcd_slot_glyph[LCD_CGRAM_SLOTS];        // 슬롯별로 올라가 있는 글리프 ID (LCD_NO_GLYPH: 비어있음)
+static uint32_t lcd_slot_last_use[LCD_CGRAM_SLOTS];    // 슬롯별 마지막 사용 순번 (LRU)
+static uint32_t lcd_glyph_use_count = 0;
+static uint32_t lcd_glyph_hits = 0;
+static uint32_t lcd_glyph_misses = 0;
 
 // 내부 함수
-static void LCD_Write(uint8_t control, uint8_t data)
+static HAL_StatusTypeDef LCD_Write(uint8_t control, uint8_t data)
 {
     // control: 0x00=command, 0x40=data
     uint8_t buf[2];
     buf[0] = control;
     buf[1] = data;
-    HAL_I2C_Master_Transmit(&hi2c1, LCD_ADDR<<1, buf, 2, HAL_MAX_DELAY);
+    return I2CBUS_WriteBlocking(LCD_ADDR, buf, 2);
+}
+
+// 타이머로 us 단위 대기를 시작 (대기가 끝나면 LCD_TIM_Callback 호출)
+static void LCD_StartTimer(uint16_t us)
+{
+    __HAL_TIM_SET_AUTORELOAD(lcd_htim, us - 1);
+    __HAL_TIM_SET_COUNTER(lcd_htim, 0);
+    __HAL_TIM_CLEAR_FLAG(lcd_htim, TIM_FLAG_UPDATE);
+    HAL_TIM_Base_Start_IT(lcd_htim);
+}
+
+static void LCD_OpDone(I2CBUS_Result result, void *context);
+
+// [인터럽트 또는 인터럽트 차단 상태에서 호출] 큐의 맨 앞 트랜잭션 전송 시작
+static void LCD_StartOp(void)
+{
+    if (lcd_tail == lcd_head)
+    {
+        lcd_active = 0;
+        if (lcd_done_callback != NULL)
+        {
+            lcd_done_callback();
+        }
+        return;
+    }
+
+    lcd_active = 1;
+    LCD_Op *op = &lcd_queue[lcd_tail];
+    if (I2CBUS_Write(LCD_ADDR, op->buf, op->len, I2CBUS_PRIO_LOW, LCD_OpDone, NULL) != HAL_OK)
+    {
+        // 버스 큐가 가득 찼으면 잠시 후 다시 시도
+        LCD_StartTimer(LCD_RETRY_US);
+    }
+}
+
+// [인터럽트에서 호출] 맨 앞 트랜잭션을 끝내고 다음 트랜잭션 시작
+static void LCD_FinishOp(void)
+{
+    lcd_tail = (lcd_tail + 1) % LCD_QUEUE_SIZE;
+    LCD_StartOp();
+}
+
+// [인터럽트에서 호출] 버스 관리자가 맨 앞 트랜잭션 전송을 마침
+static void LCD_OpDone(I2CBUS_Result result, void *context)
+{
+    (void)context;
+    if (result != I2CBUS_OK)
+    {
+        // 전송에 실패한 내용은 화면에 반영되지 않았으므로 다음 LCD_Flush에서 전체를 다시 전송
+        lcd_invalid = 1;
+        LCD_FinishOp();
+        return;
+    }
+
+    // 명령 실행 시간이 필요하면 타이머로 기다린 뒤 다음 트랜잭션 시작
+    uint16_t wait_us = lcd_queue[lcd_tail].wait_us;
+    if (wait_us > 0)
+    {
+        lcd_exec_wait = 1;
+        LCD_StartTimer(wait_us);
+    }
+    else
+    {
+        LCD_FinishOp();
+    }
+}
+
+// 비동기 모드: 큐에 트랜잭션 추가
+// 큐가 가득 차면 기다리지 않고 버림 (버린 내용은 화면에 반영되지 않았으므로 다음 LCD_Flush에서 전체를 다시 전송)
+static HAL_StatusTypeDef LCD_Enqueue(const uint8_t *buf, uint8_t len, uint16_t wait_us)
+{
+    uint16_t next_head = (lcd_head + 1) % LCD_QUEUE_SIZE;
+    if (next_head == lcd_tail)
+    {
+        lcd_dropped++;
+        lcd_invalid = 1;
+        return HAL_BUSY;
+    }
+
+    LCD_Op *op = &lcd_queue[lcd_head];
+    for (uint8_t i = 0; i < len; i++)
+    {
+        op->buf[i] = buf[i];
+    }
+    op->len = len;
+    op->wait_us = wait_us;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    lcd_head = next_head;
+    if (!lcd_active)
+    {
+        LCD_StartOp();
+    }
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+// 트랜잭션 하나 전송 (비동기 모드면 큐에 추가, 아니면 blocking 전송)
+static HAL_StatusTypeDef LCD_Transmit(const uint8_t *buf, uint8_t len, uint16_t wait_us)
+{
+    if (lcd_htim != NULL)
+    {
+        return LCD_Enqueue(buf, len, wait_us);
+    }
+    HAL_StatusTypeDef status = I2CBUS_WriteBlocking(LCD_ADDR, buf, len);
+    if (wait_us > 0)
+    {
+        HAL_Delay(1);
+    }
+    return status;
+}
+
+// 주소 명령(DDRAM/CGRAM)과 데이터를 전송
+// 보통은 [LCD_CTRL_CMD_NEXT, 주소 명령, LCD_CTRL_DATA, 데이터...]를 트랜잭션 하나로 보내고,
+// 주소 명령 실행 시간은 뒤따르는 control 바이트(9비트) 전송 시간으로 확보함 (100kHz: 90us)
+// 버스 클럭이 빨라서 부족하면 (400kHz: 22.5us) 주소 명령을 따로 보내고 LCD_WAIT_CMD_US만큼 기다림
+static HAL_StatusTypeDef LCD_TransmitAt(uint8_t addr_cmd, const uint8_t *data, uint8_t len)
+{
+    uint8_t buf[LCD_OP_MAX_BYTES];
+    uint8_t n = 0;
+
+    if (9UL * 1000000UL / hi2c1.Init.ClockSpeed < LCD_WAIT_CMD_US)
+    {
+        uint8_t cmd[2] = {LCD_CTRL_CMD, addr_cmd};
+        HAL_StatusTypeDef status = LCD_Transmit(cmd, 2, LCD_WAIT_CMD_US);
+        if (status != HAL_OK)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        buf[n++] = LCD_CTRL_CMD_NEXT;
+        buf[n++] = addr_cmd;
+    }
+    buf[n++] = LCD_CTRL_DATA;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        buf[n++] = data[i];
+    }
+    return LCD_Transmit(buf, n, 0);
 }
 
 void LCD_Init(void)
 {
+    I2CBUS_Init(&hi2c1);
     HAL_Delay(50); // LCD 안정화 대기
 
     // function set
@@ -29,51 +218,376 @@ void LCD_Init(void)
     // entry mode
     LCD_Write(0x00, 0x06);
     HAL_Delay(2);
+
+    // clear display 직후이므로 화면은 모두 공백
+    for (int r = 0; r < LCD_ROWS; r++)
+    {
+        for (int c = 0; c < LCD_COLS; c++)
+        {
+            lcd_fb[r][c] = ' ';
+            lcd_shown[r][c] = ' ';
+        }
+    }
+    lcd_invalid = 0;
+    lcd_cursor_row = 0;
+    lcd_cursor_col = 0;
+
+    // CGRAM 내용은 알 수 없으므로 글리프 캐시를 비움
+    for (int i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        lcd_slot_glyph[i] = LCD_NO_GLYPH;
+        lcd_slot_last_use[i] = 0;
+    }
+}
+
+void LCD_StartAsync(TIM_HandleTypeDef *htim)
+{
+    lcd_htim = htim;
+}
+
+// 이전 버전과의 호환용: 전송 완료는 버스 관리자가 처리
+void LCD_I2C_TxCpltCallback(void)
+{
+    I2CBUS_TxCpltCallback(&hi2c1);
+}
+
+void LCD_TIM_Callback(void)
+{
+    if (lcd_htim == NULL)
+    {
+        return;
+    }
+    HAL_TIM_Base_Stop_IT(lcd_htim);
+
+    if (lcd_exec_wait)
+    {
+        // 명령 실행 시간 대기 완료
+        lcd_exec_wait = 0;
+        LCD_FinishOp();
+    }
+    else
+    {
+        // 버스 큐가 가득 차서 미뤄둔 전송 재시도
+        LCD_StartOp();
+    }
+}
+
+uint8_t LCD_IsBusy(void)
+{
+    return lcd_active;
+}
+
+void LCD_SetDoneCallback(void (*callback)(void))
+{
+    lcd_done_callback = callback;
+}
+
+uint32_t LCD_GetDropped(void)
+{
+    return lcd_dropped;
 }
 
-void LCD_SendCommand(uint8_t cmd)
+HAL_StatusTypeDef LCD_SendCommand(uint8_t cmd)
 {
-    LCD_Write(0x00, cmd);
+    if (lcd_htim != NULL)
+    {
+        uint8_t buf[2] = {0x00, cmd};
+        // clear(0x01)/home(0x02, 0x03)은 실행 시간이 길고, 나머지 명령은 짧음
+        return LCD_Enqueue(buf, 2, (cmd == 0x01 || cmd == 0x02 || cmd == 0x03) ? LCD_WAIT_CLEAR_US : LCD_WAIT_CMD_US);
+    }
+
+    HAL_StatusTypeDef status = LCD_Write(0x00, cmd);
     HAL_Delay(2);
+    return status;
 }
 
-void LCD_SendData(uint8_t data)
+HAL_StatusTypeDef LCD_SendData(uint8_t data)
 {
-    LCD_Write(0x40, data);
+    if (lcd_htim != NULL)
+    {
+        // 데이터 쓰기 시간은 다음 트랜잭션의 주소/control 바이트 전송 시간보다 짧으므로 대기 없음
+        uint8_t buf[2] = {0x40, data};
+        return LCD_Enqueue(buf, 2, 0);
+    }
+
+    return LCD_Write(0x40, data);
 }
 
 void LCD_DispCGRAM(void)
 {
-    // 첫 CGRAM
-    LCD_SendCommand(0x80);
-    LCD_SendCommand(0x40);
+    // CGRAM 0, 1번 슬롯을 직접 덮어쓰므로 글리프 캐시에서 제외
+    lcd_slot_glyph[0] = LCD_NO_GLYPH;
+    lcd_slot_glyph[1] = LCD_NO_GLYPH;
+
+    // DDRAM 주소 명령 하나와 [CGRAM 주소 명령, 데이터 16바이트] 트랜잭션 하나로 보냄
+    // (바이트마다 명령을 보내면 한 번에 36개라서 비동기 큐(LCD_QUEUE_SIZE)에 들어가지 않음)
+    static const uint8_t ddram[2] = {0x80, 0xC0};
+    uint8_t data[16];
     for (int i = 0; i < 16; i++)
     {
-        LCD_SendData(0x01);
+        data[i] = 0x01;
     }
 
-    // 두번째 CGRAM
-    LCD_SendCommand(0xC0);
-    LCD_SendCommand(0x40);
-    for (int i = 0; i < 16; i++)
+    for (int n = 0; n < 2; n++)
     {
-        LCD_SendData(0x01);
+        LCD_SendCommand(ddram[n]);
+        LCD_TransmitAt(0x40, data, sizeof(data));
     }
 }
 
 void LCD_DispChar(int line, int column, char *dp)
 {
-    // DDRAM 주소 설정
-    LCD_SendCommand(0x80 + (line - 1) * 0x40 + (column - 1));
-    // 데이터 전송
+    PERF_BEGIN(PERF_LCD_DISPCHAR);
+    uint8_t buf[LCD_COLS];
     int i;
-    for (i = 0; i < 16 && dp[i] != '\0'; i++)
+    for (i = 0; i < LCD_COLS && dp[i] != '\0'; i++)
     {
-        LCD_SendData((uint8_t)dp[i]);
+        buf[i] = (uint8_t)dp[i];
     }
     // 나머지 공간을 공백으로 채움
-    for (; i < 16; i++)
+    for (; i < LCD_COLS; i++)
     {
-        LCD_SendData(' ');
+        buf[i] = ' ';
+    }
+    LCD_WriteBuffer(line, column, buf, LCD_COLS);
+    PERF_END(PERF_LCD_DISPCHAR);
+}
+
+// DDRAM 주소 설정 명령과 데이터를 I²C 트랜잭션 하나로 전송 (LCD_TransmitAt)
+// 문자마다 START/주소/STOP을 반복하던 것보다 버스 사용 시간이 크게 줄어듦
+// (한 줄 16칸: 트랜잭션 17개 51바이트 -> 트랜잭션 1개 20바이트, 주소 바이트 포함)
+HAL_StatusTypeDef LCD_WriteBuffer(int line, int column, const uint8_t *data, uint16_t len)
+{
+    if (line < 1 || line > LCD_ROWS || column < 1 || column > LCD_COLS)
+    {
+        return HAL_ERROR;
+    }
+    // 줄 끝을 넘어가는 데이터는 잘라냄
+    if (len > LCD_COLS - (column - 1))
+    {
+        len = LCD_COLS - (column - 1);
+    }
+
+    HAL_StatusTypeDef status = LCD_TransmitAt(0x80 + (line - 1) * 0x40 + (column - 1), data, (uint8_t)len); // DDRAM 주소 설정
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        // 화면에 쓴 내용을 프레임버퍼에 반영하고, 전송(비동기 모드는 큐에 추가)에 성공했으면 마지막 전송 화면에도 반영
+        // (비동기 모드에서 나중에 전송이 실패하면 LCD_OpDone이 lcd_invalid를 설정)
+        lcd_fb[line - 1][column - 1 + i] = data[i];
+        if (status == HAL_OK)
+        {
+            lcd_shown[line - 1][column - 1 + i] = data[i];
+        }
+    }
+    if (status != HAL_OK)
+    {
+        lcd_invalid = 1;
+    }
+    return status;
+}
+
+// 프레임버퍼 커서 위치 설정 (line, column은 1부터 시작)
+void LCD_SetCursor(int line, int column)
+{
+    if (line < 1 || line > LCD_ROWS || column < 1 || column > LCD_COLS)
+    {
+        return;
+    }
+    lcd_cursor_row = line - 1;
+    lcd_cursor_col = column - 1;
+}
+
+// 프레임버퍼의 커서 위치에 문자열을 쓰고 커서를 이동 (줄 끝을 넘는 부분은 잘림)
+void LCD_Print(const char *str)
+{
+    while (*str != '\0' && lcd_cursor_col < LCD_COLS)
+    {
+        lcd_fb[lcd_cursor_row][lcd_cursor_col++] = (uint8_t)*str++;
+    }
+}
+
+// 프레임버퍼를 공백으로 채우고 커서를 처음으로 이동
+void LCD_ClearBuffer(void)
+{
+    for (int r = 0; r < LCD_ROWS; r++)
+    {
+        for (int c = 0; c < LCD_COLS; c++)
+        {
+            lcd_fb[r][c] = ' ';
+        }
+    }
+    lcd_cursor_row = 0;
+    lcd_cursor_col = 0;
+}
+
+// 프레임버퍼에서 화면과 달라진 칸만 전송
+// 줄마다 달라진 칸들의 구간을 찾고, 구간 사이의 같은 칸이 LCD_RUN_MERGE_GAP 이하이면
+// 주소 명령을 한 번 더 보내는 것보다 같은 칸을 다시 보내는 쪽이 싸므로 두 구간을 합침
+// 구간 하나는 LCD_WriteBuffer로 주소 명령 1개 + 데이터를 한 트랜잭션에 전송
+void LCD_Flush(void)
+{
+    // 전송 중에 설정된 lcd_invalid를 잃지 않도록 시작할 때 읽고 지움
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t invalid = lcd_invalid;
+    lcd_invalid = 0;
+    __set_PRIMASK(primask);
+
+    for (int r = 0; r < LCD_ROWS; r++)
+    {
+        int start = -1;  // 현재 구간 시작 칸
+        int end = -1;    // 현재 구간의 마지막 달라진 칸
+
+        for (int c = 0; c < LCD_COLS; c++)
+        {
+            if (!invalid && lcd_fb[r][c] == lcd_shown[r][c])
+            {
+                continue;
+            }
+
+            if (start >= 0 && c - end - 1 > LCD_RUN_MERGE_GAP)
+            {
+                // 앞 구간과 멀리 떨어져 있으므로 앞 구간을 먼저 전송
+                LCD_WriteBuffer(r + 1, start + 1, &lcd_fb[r][start], end - start + 1);
+                start = -1;
+            }
+            if (start < 0)
+            {
+                start = c;
+            }
+            end = c;
+        }
+
+        if (start >= 0)
+        {
+            LCD_WriteBuffer(r + 1, start + 1, &lcd_fb[r][start], end - start + 1);
+        }
     }
 }
+
+// 화면을 직접 바꾼 경우 다음 LCD_Flush에서 전체를 다시 전송하도록 표시
+void LCD_Invalidate(void)
+{
+    lcd_invalid = 1;
+}
+
+// 프레임버퍼의 커서 위치에 문자 코드 하나를 쓰고 커서를 이동 (줄 끝을 넘으면 무시)
+void LCD_PutChar(uint8_t c)
+{
+    if (lcd_cursor_col < LCD_COLS)
+    {
+        lcd_fb[lcd_cursor_row][lcd_cursor_col++] = c;
+    }
+}
+
+// 글리프 등록 (bitmap은 포인터만 저장하므로 const 배열처럼 계속 유지되어야 함)
+HAL_StatusTypeDef LCD_RegisterGlyph(uint8_t id, const uint8_t *bitmap)
+{
+    if (id >= LCD_MAX_GLYPHS || bitmap == NULL)
+    {
+        return HAL_ERROR;
+    }
+    lcd_glyphs[id] = bitmap;
+
+    // 같은 ID가 이미 올라가 있으면 새 비트맵이 반영되도록 캐시에서 제외
+    for (int i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        if (lcd_slot_glyph[i] == id)
+        {
+            lcd_slot_glyph[i] = LCD_NO_GLYPH;
+        }
+    }
+    return HAL_OK;
+}
+
+// 화면 또는 프레임버퍼에 사용자 정의 문자로 보이고 있는 슬롯 비트마스크
+// (문자 코드 0x00~0x07과 0x08~0x0F는 같은 CGRAM 슬롯을 가리킴)
+static uint8_t LCD_VisibleSlots(void)
+{
+    uint8_t mask = 0;
+    for (int r = 0; r < LCD_ROWS; r++)
+    {
+        for (int c = 0; c < LCD_COLS; c++)
+        {
+            if (lcd_fb[r][c] < 0x10)
+            {
+                mask |= 1 << (lcd_fb[r][c] & 0x07);
+            }
+            if (lcd_shown[r][c] < 0x10)
+            {
+                mask |= 1 << (lcd_shown[r][c] & 0x07);
+            }
+        }
+    }
+    return mask;
+}
+
+// 글리프에 CGRAM 슬롯을 배정하고 출력할 문자 코드를 반환
+// 0x00은 문자열 끝과 겹치므로 같은 슬롯을 가리키는 0x08~0x0F를 반환
+int LCD_UseGlyph(uint8_t id)
+{
+    if (id >= LCD_MAX_GLYPHS || lcd_glyphs[id] == NULL)
+    {
+        return -1;
+    }
+    lcd_glyph_use_count++;
+
+    // 이미 올라가 있으면 업로드 없이 사용
+    for (int i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        if (lcd_slot_glyph[i] == id)
+        {
+            lcd_slot_last_use[i] = lcd_glyph_use_count;
+            lcd_glyph_hits++;
+            return 0x08 + i;
+        }
+    }
+    lcd_glyph_misses++;
+
+    // 빈 슬롯을 먼저 쓰고, 없으면 보이지 않는 슬롯 중 가장 오래전에 사용한 슬롯을 교체
+    // (보이는 슬롯을 바꾸면 화면의 해당 문자가 즉시 바뀌므로 교체하지 않음)
+    uint8_t visible = LCD_VisibleSlots();
+    int victim = -1;
+    for (int i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        if (lcd_slot_glyph[i] == LCD_NO_GLYPH)
+        {
+            victim = i;
+            break;
+        }
+        if ((visible & (1 << i)) == 0 &&
+            (victim < 0 || lcd_slot_last_use[i] < lcd_slot_last_use[victim]))
+        {
+            victim = i;
+        }
+    }
+    if (victim < 0)
+    {
+        return -1;
+    }
+
+    // CGRAM 주소 설정 명령과 8바이트 비트맵을 트랜잭션 하나로 업로드
+    // 이후 DDRAM 쓰기는 항상 LCD_WriteBuffer가 주소를 먼저 설정하므로 주소를 되돌리지 않음
+    if (LCD_TransmitAt(0x40 | (victim << 3), lcd_glyphs[id], 8) != HAL_OK)
+    {
+        return -1;  // 업로드하지 못했으므로 슬롯은 그대로 둠
+    }
+
+    lcd_slot_glyph[victim] = id;
+    lcd_slot_last_use[victim] = lcd_glyph_use_count;
+    return 0x08 + victim;
+}
+
+// 글리프 캐시 적중/실패(업로드) 횟수
+void LCD_GetGlyphStats(uint32_t *hits, uint32_t *misses)
+{
+    *hits = lcd_glyph_hits;
+    *misses = lcd_glyph_misses;
+}
+
+// 스케줄러용 태스크: 프레임버퍼에서 바뀐 부분을 화면에 반영
+void LCD_Task(void)
+{
+    LCD_Flush();
+}
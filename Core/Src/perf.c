@@ -0,0 +1,206 @@
+/*
+ * perf.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 드라이버 주요 구간의 실행 시간 측정
+ *   - PERF_BEGIN/PERF_END 사이의 DWT 사이클 카운터 차이를 구간별로 기록 (횟수, 최소/최대/평균, log2 히스토그램)
+ *   - 콘솔 커맨드 "perf show"로 표를 출력하고 "perf reset"으로 초기화
+ *   - 표는 송신 링 버퍼에 공간이 있는 만큼만 출력하고 나머지는 다음 U2C_process 호출 때 이어서 출력 (메인 루프가 멈추지 않음)
+ */
+
+#include "perf.h"
+
+#ifdef PERF_ENABLE
+
+#include "usart2console.h"
+#include <string.h>
+
+#ifndef DWT
+#include <time.h>
+#endif
+
+#define PERF_LINE_MAX 80  // 한 번에 출력하는 조각의 최대 길이 (송신 링 버퍼에 이만큼 공간이 있을 때만 출력)
+
+static PERF_Stats probes[PERF_PROBE_COUNT];
+
+static const char *const probe_names[PERF_PROBE_COUNT] = {
+    [PERF_KEYPAD16_SCAN] = "keypad_scan",
+    [PERF_SEG7ARRAY_CYCLE] = "seg7_cycle",
+    [PERF_LCD_DISPCHAR] = "lcd_dispchar",
+    [PERF_U2C_PROCESS] = "u2c_process",
+    [PERF_SPEAKER_LOOP] = "speaker_loop",
+    [PERF_SPEAKER_DDS_FILL] = "speaker_dds",
+    [PERF_USER0] = "user0",
+    [PERF_USER1] = "user1",
+    [PERF_USER2] = "user2",
+    [PERF_USER3] = "user3",
+};
+
+// "perf show" 출력 상태
+// show_probe: -1이면 머리글, PERF_PROBE_COUNT이면 출력할 것 없음
+// show_step: 0이면 통계 줄, 1~PERF_HIST_BUCKETS이면 히스토그램 칸, 그다음은 줄바꿈
+static int8_t show_probe = PERF_PROBE_COUNT;
+static uint8_t show_step = 0;
+static PERF_Stats show_stats;
+
+
+#ifndef DWT
+// DWT가 없는 환경(PC 빌드 등)에서는 C11 timespec_get으로 ns 단위 시간을 사용
+uint32_t PERF_HostNow(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint32_t)ts.tv_sec * 1000000000u + (uint32_t)ts.tv_nsec;
+}
+#endif
+
+void PERF_Record(PERF_Probe id, uint32_t cycles)
+{
+    PERF_Stats *p = &probes[id];
+
+    if (p->count == 0 || cycles < p->min)
+    {
+        p->min = cycles;
+    }
+    if (cycles > p->max)
+    {
+        p->max = cycles;
+    }
+    p->count++;
+    p->total += cycles;
+
+    // 칸 번호 = 유효 비트 수 (0 -> 0, 1 -> 1, 2~3 -> 2, 4~7 -> 3, ...)
+    uint32_t bucket = (cycles == 0) ? 0 : 32 - __builtin_clz(cycles);
+    if (bucket >= PERF_HIST_BUCKETS)
+    {
+        bucket = PERF_HIST_BUCKETS - 1;
+    }
+    if (p->hist[bucket] != 0xFFFF)
+    {
+        p->hist[bucket]++;
+    }
+}
+
+void PERF_GetStats(PERF_Probe id, PERF_Stats *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = probes[id];
+    __set_PRIMASK(primask);
+}
+
+void PERF_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(probes, 0, sizeof(probes));
+    __set_PRIMASK(primask);
+}
+
+// 송신 링 버퍼에 공간이 있는 만큼 표를 출력, 다 출력했으면 true
+static bool PERF_Continue_show(void)
+{
+    while (show_probe < PERF_PROBE_COUNT)
+    {
+        if (U2C_get_tx_free() < PERF_LINE_MAX)
+        {
+            return false;
+        }
+
+        if (show_probe < 0)
+        {
+#ifdef DWT
+            U2C_printf("probe             count        min       mean        max (cycles)" NEWLINE_CHARACTER);
+#else
+            U2C_printf("probe             count        min       mean        max (ns)" NEWLINE_CHARACTER);
+#endif
+            show_probe = 0;
+            show_step = 0;
+        }
+        else if (show_step == 0)
+        {
+            PERF_GetStats((PERF_Probe)show_probe, &show_stats);
+            if (show_stats.count == 0)
+            {
+                show_probe++;
+                continue;
+            }
+            U2C_printf("%-12s %10lu %10lu %10lu %10lu" NEWLINE_CHARACTER "  hist",
+                       probe_names[show_probe],
+                       (unsigned long)show_stats.count,
+                       (unsigned long)show_stats.min,
+                       (unsigned long)(show_stats.total / show_stats.count),
+                       (unsigned long)show_stats.max);
+            show_step = 1;
+        }
+        else if (show_step <= PERF_HIST_BUCKETS)
+        {
+            uint8_t b = show_step - 1;
+            uint16_t n = show_stats.hist[b];
+            if (n != 0)
+            {
+                if (b == 0)
+                {
+                    U2C_printf(" 0:%u", n);
+                }
+                else if (b == PERF_HIST_BUCKETS - 1)
+                {
+                    U2C_printf(" >=%lu:%u", (unsigned long)(1ul << (b - 1)), n);
+                }
+                else
+                {
+                    U2C_printf(" <%lu:%u", (unsigned long)(1ul << b), n);
+                }
+            }
+            show_step++;
+        }
+        else
+        {
+            U2C_printf(NEWLINE_CHARACTER);
+            show_probe++;
+            show_step = 0;
+        }
+    }
+    return true;
+}
+
+// 콘솔 커맨드: perf show | perf reset
+static void PERF_Command(int argc, char *argv[])
+{
+    if (argc == 2 && strcmp(argv[1], "show") == 0)
+    {
+        // 다른 커맨드의 긴 출력이 진행 중이면 섞이지 않도록 시작하지 않음
+        if (U2C_set_continuation(PERF_Continue_show) != HAL_OK)
+        {
+            U2C_printf("perf: busy" NEWLINE_CHARACTER);
+            return;
+        }
+        show_probe = -1;
+        if (PERF_Continue_show())
+        {
+            U2C_set_continuation(NULL);
+        }
+    }
+    else if (argc == 2 && strcmp(argv[1], "reset") == 0)
+    {
+        PERF_Reset();
+    }
+    else
+    {
+        U2C_printf("usage: perf show|reset" NEWLINE_CHARACTER);
+    }
+}
+
+void PERF_Init(void)
+{
+#ifdef DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    PERF_Reset();
+    U2C_register_command("perf", PERF_Command, "perf show|reset");
+}
+
+#endif /* PERF_ENABLE */
@@ -0,0 +1,350 @@
+/*
+ * power.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 스케줄러의 다음 태스크 시점까지 MCU를 재우는 절전 관리
+ *   - SLEEP: SysTick 주기를 다음 태스크 시점까지 늘려서 1ms마다 깨어나지 않음 (tickless)
+ *   - STOP: RTC가 있고(POWER_USE_RTC) 모든 드라이버가 쉬고 있을 때만 (클럭이 멈추므로 타이머, DMA, UART가 동작하지 않음)
+ *   - 일찍 깨어나면 실제로 잔 시간만큼만 HAL tick을 더하므로, HAL_GetTick은 계속 정확함
+ */
+
+#include "power.h"
+#include "scheduler.h"
+#ifdef POWER_USE_U2C
+#include "usart2console.h"
+#endif
+#ifdef POWER_USE_KEYPAD16
+#include "keypad16.h"
+#endif
+#ifdef POWER_USE_LCD
+#include "lcd1602.h"
+#endif
+#ifdef POWER_USE_I2CBUS
+#include "i2cbus.h"
+#endif
+#ifdef POWER_USE_SEG7ARRAY
+#include "seg7array.h"
+#endif
+#ifdef POWER_USE_SPEAKER
+#include "speaker.h"
+#endif
+
+#ifdef POWER_USE_RTC
+extern RTC_HandleTypeDef hrtc;
+#endif
+
+#define POWER_UART_WAKE_MASK (1u << POWER_UART_WAKE_LINE)
+
+static void (*power_restore_clock)(void) = NULL;
+static uint8_t stop_allowed = 1;
+#ifdef POWER_USE_RTC
+static uint32_t uart_awake_until = 0;
+static uint8_t uart_awake = 0;
+#endif
+
+static POWER_Stats stats;
+static uint32_t stats_start = 0;
+static uint64_t sleep_clocks = 0;   // SLEEP 모드로 보낸 시간 (SysTick 클럭 수)
+
+
+void POWER_Init(void (*restore_clock)(void))
+{
+    power_restore_clock = restore_clock;
+    stop_allowed = 1;
+#ifdef POWER_USE_RTC
+    uart_awake = 0;
+#endif
+    POWER_ResetStats();
+}
+
+void POWER_SetStopAllowed(uint8_t allowed)
+{
+    stop_allowed = allowed;
+}
+
+#ifdef POWER_USE_RTC
+// 모든 드라이버가 클럭 없이 기다릴 수 있는 상태인지 확인
+static uint8_t POWER_Can_stop(void)
+{
+    if (!stop_allowed || power_restore_clock == NULL)
+    {
+        return 0;
+    }
+    if (uart_awake)
+    {
+        if ((int32_t)(HAL_GetTick() - uart_awake_until) < 0)
+        {
+            return 0;
+        }
+        uart_awake = 0;
+    }
+#ifdef POWER_USE_U2C
+    if (U2C_get_tx_free() != U2C_TX_BUFFER_SIZE - 1 || !__HAL_UART_GET_FLAG(U2C_USART_CHANNEL, UART_FLAG_TC))
+    {
+        return 0;
+    }
+#endif
+#ifdef POWER_USE_KEYPAD16
+    if (!KEYPAD16_IsIdle())
+    {
+        return 0;
+    }
+#endif
+#ifdef POWER_USE_LCD
+    if (LCD_IsBusy())
+    {
+        return 0;
+    }
+#endif
+#ifdef POWER_USE_I2CBUS
+    if (I2CBUS_IsBusy())
+    {
+        return 0;
+    }
+#endif
+#ifdef POWER_USE_SEG7ARRAY
+    if (!SEG7ARRAY_IsBlank())
+    {
+        return 0;
+    }
+#endif
+#ifdef POWER_USE_SPEAKER
+    if (SPEAKER_IsPlaying())
+    {
+        return 0;
+    }
+#endif
+    return 1;
+}
+#endif /* POWER_USE_RTC */
+
+// [인터럽트 차단 상태에서 호출] 최대 ms만큼 SLEEP 모드, 1 tick 이하면 SysTick을 그대로 두고 WFI
+static void POWER_Sleep(uint32_t ms)
+{
+    uint32_t tick_clocks = SystemCoreClock / 1000;  // HAL tick(1ms) 하나의 SysTick 클럭 수
+    uint32_t max_ms = (SysTick_LOAD_RELOAD_Msk + 1) / tick_clocks;  // 24비트 카운터로 늘릴 수 있는 최대 tick 수 (84MHz: 199)
+
+    if (ms > max_ms)
+    {
+        ms = max_ms;
+    }
+    stats.sleeps++;
+
+    if (ms <= 1)
+    {
+        uint32_t before = SysTick->VAL;
+        __DSB();
+        __WFI();
+        uint32_t after = SysTick->VAL;
+        // 카운터는 내려가므로, 중간에 0을 지났으면 한 주기를 더함
+        sleep_clocks += (after <= before) ? (before - after) : (before + tick_clocks - after);
+        return;
+    }
+
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;
+    // 지금 tick의 남은 클럭 (VAL이 0이면 직전 SLEEP이 0을 쓴 것이고, 다음 클럭에 LOAD부터 다시 세므로 한 주기가 남음)
+    uint32_t val = SysTick->VAL;
+    if (val == 0)
+    {
+        val = SysTick->LOAD + 1;
+    }
+    // 남은 클럭 + 나머지 tick만큼 카운터를 늘림 (VAL에 0을 쓰면 다음 클럭에 reload를 읽으므로 reload + 1 클럭 뒤 0)
+    uint32_t reload = val + (ms - 1) * tick_clocks - 1;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        // 멈추는 사이에 tick이 지났으면 자지 않고 그대로 진행
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return;
+    }
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;
+    uint32_t ticks;
+    uint32_t next_load;
+    if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk)
+    {
+        // 끝까지 잤음: 마지막 tick은 대기 중인 SysTick 인터럽트가 셈
+        // 0을 지난 뒤 다시 reload부터 내려간 만큼을 다음 tick에서 뺌 (아직 0이면 지난 클럭 없음)
+        uint32_t val = SysTick->VAL;
+        uint32_t overrun = (val == 0) ? 0 : reload - val;
+        next_load = (overrun < tick_clocks - 1) ? (tick_clocks - 1 - overrun) : (tick_clocks - 1);
+        ticks = ms - 1;
+        sleep_clocks += reload + 1 + overrun;
+    }
+    else
+    {
+        // 다른 인터럽트로 일찍 깨어남: 지금 tick 시작부터 지난 클럭으로 끝난 tick 수를 계산하고, 남은 부분만큼 다음 tick을 맞춤
+        uint32_t done = ms * tick_clocks - SysTick->VAL;
+        ticks = done / tick_clocks;
+        next_load = (ticks + 1) * tick_clocks - done;
+        sleep_clocks += reload + 1 - SysTick->VAL;
+    }
+    SysTick->LOAD = next_load;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;  // 다음 SysTick 클럭에 next_load를 읽어감
+
+    uwTick += ticks;  // HAL tick 주파수 기본값(1kHz) 기준
+    SysTick->LOAD = tick_clocks - 1;  // 그다음 reload부터 원래 주기
+}
+
+#ifdef POWER_USE_RTC
+// STOP 모드 동안 UART RX 핀의 하강 에지(시작 비트)로 깨어나도록 EXTI 설정
+// 인터럽트를 막은 상태에서 깨어난 직후 해제하므로 EXTI 인터럽트 핸들러는 필요 없음
+static void POWER_Uart_wake_arm(void)
+{
+    uint32_t shift = (POWER_UART_WAKE_LINE & 3) * 4;
+    SYSCFG->EXTICR[POWER_UART_WAKE_LINE >> 2] = (SYSCFG->EXTICR[POWER_UART_WAKE_LINE >> 2] & ~(0xFu << shift)) |
+                                                 ((uint32_t)POWER_UART_WAKE_PORT << shift);
+    EXTI->FTSR |= POWER_UART_WAKE_MASK;
+    EXTI->PR = POWER_UART_WAKE_MASK;
+    EXTI->IMR |= POWER_UART_WAKE_MASK;
+    HAL_NVIC_ClearPendingIRQ(POWER_UART_WAKE_IRQn);
+    HAL_NVIC_EnableIRQ(POWER_UART_WAKE_IRQn);
+}
+
+// UART 수신으로 깨어났으면 1
+static uint8_t POWER_Uart_wake_disarm(void)
+{
+    uint8_t woke = (EXTI->PR & POWER_UART_WAKE_MASK) != 0;
+    EXTI->IMR &= ~POWER_UART_WAKE_MASK;
+    EXTI->FTSR &= ~POWER_UART_WAKE_MASK;
+    EXTI->PR = POWER_UART_WAKE_MASK;
+    HAL_NVIC_DisableIRQ(POWER_UART_WAKE_IRQn);
+    HAL_NVIC_ClearPendingIRQ(POWER_UART_WAKE_IRQn);
+    return woke;
+}
+
+// RTC 시각을 하루 안의 ms로 변환 (정밀도: 1 / (SynchPrediv + 1)초)
+static uint32_t POWER_Rtc_ms(void)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    HAL_RTC_GetTime(&hrtc, &time, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(&hrtc, &date, RTC_FORMAT_BIN);  // GetTime 다음에 읽어야 shadow 레지스터가 갱신됨
+    return (((uint32_t)time.Hours * 60 + time.Minutes) * 60 + time.Seconds) * 1000 +
+           (time.SecondFraction - time.SubSeconds) * 1000 / (time.SecondFraction + 1);
+}
+
+// [인터럽트 차단 상태에서 호출] STOP 모드 (ms가 0xFFFFFFFF이면 깨우기만 기다림)
+// RTC HAL 함수(깨우기 타이머 설정/해제, 동기화 대기)는 HAL_GetTick으로 타임아웃을 재므로,
+// 인터럽트를 막은 채 호출하면 플래그가 서지 않을 때 tick이 멈춰 있어 끝나지 않음 → 인터럽트를 허용하고 호출
+static void POWER_Stop(uint32_t ms)
+{
+    uint32_t start = POWER_Rtc_ms();
+    uint32_t start_tick = uwTick;
+    if (ms != 0xFFFFFFFF)
+    {
+        uint32_t counts = (uint32_t)((uint64_t)ms * (POWER_RTC_CLOCK_HZ / 16) / 1000);
+        if (counts > 0x10000)
+        {
+            counts = 0x10000;
+        }
+        __enable_irq();
+        HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, counts - 1, RTC_WAKEUPCLOCK_RTCCLK_DIV16);
+        __disable_irq();
+
+        // 설정하는 동안 인터럽트가 태스크를 깨웠거나 드라이버가 바빠졌으면 STOP하지 않음
+        if (SCHED_TimeToNext() == 0 || !POWER_Can_stop())
+        {
+            __enable_irq();
+            HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+            __disable_irq();
+            return;
+        }
+    }
+
+    stats.stops++;
+    HAL_SuspendTick();
+    POWER_Uart_wake_arm();
+
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+    uint8_t uart_woke = POWER_Uart_wake_disarm();
+
+    // 깨어나면 HSI로 동작하므로 HSI 기준으로 SysTick을 다시 켠 뒤 인터럽트를 허용하고 RTC를 정리
+    // STOP 모드에서는 RTC shadow 레지스터가 갱신되지 않으므로 동기화를 기다린 뒤 읽음
+    SystemCoreClockUpdate();
+    HAL_InitTick(uwTickPrio);
+    __enable_irq();
+    HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+    __HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+    HAL_RTC_WaitForSynchro(&hrtc);
+    __HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+    __disable_irq();
+
+    uint32_t elapsed = POWER_Rtc_ms() - start;
+    if ((int32_t)elapsed < 0)
+    {
+        elapsed += 24UL * 60 * 60 * 1000;  // 자정을 지남
+    }
+    // 위에서 인터럽트를 허용한 동안 SysTick이 더한 tick도 RTC로 잰 시간에 들어 있으므로, 더하지 않고 STOP 전 tick에서 다시 계산
+    // (그동안 실행된 인터럽트는 STOP 전의 tick을 봄)
+    uwTick = start_tick + elapsed;
+    stats.stop_ms += elapsed;
+    if (uart_woke)
+    {
+        stats.uart_wakes++;
+        uart_awake = 1;
+        uart_awake_until = HAL_GetTick() + POWER_UART_AWAKE_MS;
+    }
+
+    // PLL 등 클럭을 다시 설정
+    // 클럭 설정 함수(SystemClock_Config)는 HAL_GetTick으로 타임아웃을 재므로 인터럽트를 허용한 상태에서 호출해야 멈추지 않음
+    __enable_irq();
+    power_restore_clock();
+    __disable_irq();
+}
+#endif /* POWER_USE_RTC */
+
+void POWER_Idle(void)
+{
+    // 인터럽트를 막은 뒤에 확인해야, 확인 직후 인터럽트가 깨운 태스크를 놓치지 않음
+    // (막은 상태에서도 인터럽트가 발생하면 WFI에서 깨어나고, 아래에서 인터럽트를 풀 때 처리됨)
+    __disable_irq();
+    uint32_t next = SCHED_TimeToNext();
+    if (next == 0)
+    {
+        __enable_irq();
+        return;
+    }
+
+#ifdef POWER_USE_RTC
+    if (next >= POWER_STOP_MIN_MS && POWER_Can_stop())
+    {
+        POWER_Stop(next);
+        __enable_irq();
+        return;
+    }
+#endif
+    // RTC가 없으면 STOP 모드 동안 지난 시간을 알 수 없어 HAL tick이 늦어지므로 SLEEP만 사용
+    POWER_Sleep(next);
+    __enable_irq();
+}
+
+void POWER_GetStats(POWER_Stats *out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    out->elapsed_ms = HAL_GetTick() - stats_start;
+    out->sleep_ms = (uint32_t)(sleep_clocks / (SystemCoreClock / 1000));
+    __set_PRIMASK(primask);
+}
+
+void POWER_ResetStats(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats = (POWER_Stats){0};
+    sleep_clocks = 0;
+    stats_start = HAL_GetTick();
+    __set_PRIMASK(primask);
+}
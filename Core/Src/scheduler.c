@@ -0,0 +1,253 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 실행이 끝날 때까지 다른 태스크가 끼어들지 않는(run-to-completion) 협력형 스케줄러
+ *   - 주기 태스크: next_release마다 실행 가능해짐 (주기가 밀리지 않도록 이전 release에 주기를 더함)
+ *   - 이벤트 태스크: 인터럽트 등에서 SCHED_Wake로 깨우거나, SCHED_After로 예약한 시간에 실행 가능해짐
+ *   - 실행 가능한 태스크 중 데드라인(release + deadline)이 가장 빠른 태스크부터 실행 (EDF)
+ */
+
+#include "scheduler.h"
+
+typedef struct {
+    const char *name;
+    SCHED_TaskFunc func;
+    uint32_t period;                // 0이면 이벤트 태스크
+    uint32_t deadline;
+    uint32_t next_release;          // 주기 태스크 또는 SCHED_After로 예약된 실행 시점
+    uint8_t timed;                  // 1: next_release에 실행 예정
+    volatile uint8_t woken;         // SCHED_Wake로 깨워짐 (인터럽트에서 씀)
+    volatile uint32_t wake_tick;    // 깨운 시점
+    SCHED_Stats stats;
+} SCHED_Task;
+
+static SCHED_Task tasks[SCHED_MAX_TASKS];
+static int task_count = 0;
+
+
+void SCHED_Init(void)
+{
+    task_count = 0;
+
+    // 사이클 카운터는 다른 모듈(perf 등)도 쓰므로 켜기만 하고 값은 건드리지 않음 (차이로만 측정)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static int SCHED_Add(const char *name, SCHED_TaskFunc func, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (task_count == SCHED_MAX_TASKS || func == NULL)
+    {
+        return -1;
+    }
+
+    SCHED_Task *task = &tasks[task_count];
+    *task = (SCHED_Task){0};
+    task->name = name;
+    task->func = func;
+    task->period = period_ms;
+    task->deadline = deadline_ms ? deadline_ms : period_ms;
+    if (period_ms > 0)
+    {
+        task->timed = 1;
+        task->next_release = HAL_GetTick() + period_ms;
+    }
+    return task_count++;
+}
+
+int SCHED_AddPeriodic(const char *name, SCHED_TaskFunc func, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (period_ms == 0)
+    {
+        return -1;
+    }
+    return SCHED_Add(name, func, period_ms, deadline_ms);
+}
+
+int SCHED_AddEvent(const char *name, SCHED_TaskFunc func, uint32_t deadline_ms)
+{
+    return SCHED_Add(name, func, 0, deadline_ms);
+}
+
+void SCHED_Wake(int id)
+{
+    if (id < 0 || id >= task_count)
+    {
+        return;
+    }
+    if (!tasks[id].woken)
+    {
+        tasks[id].wake_tick = HAL_GetTick();
+        tasks[id].woken = 1;
+    }
+}
+
+void SCHED_After(int id, uint32_t delay_ms)
+{
+    if (id < 0 || id >= task_count || tasks[id].period > 0)
+    {
+        return;
+    }
+    tasks[id].next_release = HAL_GetTick() + delay_ms;
+    tasks[id].timed = 1;
+}
+
+// 실행 가능하면 1을 반환하고 release 시점을 돌려줌
+static int SCHED_Is_ready(const SCHED_Task *task, uint32_t now, uint32_t *release)
+{
+    if (task->woken)
+    {
+        *release = task->wake_tick;
+        return 1;
+    }
+    if (task->timed && (int32_t)(now - task->next_release) >= 0)
+    {
+        *release = task->next_release;
+        return 1;
+    }
+    return 0;
+}
+
+void SCHED_Run(void)
+{
+    for (;;)
+    {
+        uint32_t now = HAL_GetTick();
+        int best = -1;
+        uint32_t best_release = 0;
+        uint32_t best_deadline = 0;
+
+        // 선택부터 다음 실행 예약까지 인터럽트를 막음
+        // (그 사이에 SCHED_Wake가 끼어들면 깨우기를 주기 실행으로 잘못 소비하고 next_release를 넘기지 못함)
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+
+        // 실행 가능한 태스크 중 데드라인이 가장 빠른 태스크 선택
+        for (int i = 0; i < task_count; i++)
+        {
+            uint32_t release;
+            if (!SCHED_Is_ready(&tasks[i], now, &release))
+            {
+                continue;
+            }
+            uint32_t deadline = release + tasks[i].deadline;
+            if (best < 0 || (int32_t)(deadline - best_deadline) < 0)
+            {
+                best = i;
+                best_release = release;
+                best_deadline = deadline;
+            }
+        }
+        if (best < 0)
+        {
+            __set_PRIMASK(primask);
+            return;
+        }
+
+        SCHED_Task *task = &tasks[best];
+
+        // 다음 실행 예약 (실행 전에 상태를 바꿔야 태스크 안에서 다시 깨우거나 예약할 수 있음)
+        // 주기 태스크는 깨우기로 실행되더라도 release 시점이 지났으면 항상 다음 주기로 넘김
+        uint8_t woken = task->woken;
+        task->woken = 0;
+        if (task->period > 0)
+        {
+            if ((int32_t)(now - task->next_release) >= 0)
+            {
+                task->next_release += task->period;
+                // 한 주기 이상 밀렸으면 밀린 주기는 건너뜀
+                if ((int32_t)(now - task->next_release) >= 0)
+                {
+                    uint32_t skipped = (now - task->next_release) / task->period + 1;
+                    task->stats.missed += skipped;
+                    task->next_release += skipped * task->period;
+                }
+            }
+        }
+        else if (!woken)
+        {
+            task->timed = 0;
+        }
+        __set_PRIMASK(primask);
+
+        uint32_t lateness = now - best_release;
+        uint32_t start = DWT->CYCCNT;
+        task->func();
+        uint32_t cycles = DWT->CYCCNT - start;
+
+        task->stats.runs++;
+        if (cycles > task->stats.max_cycles)
+        {
+            task->stats.max_cycles = cycles;
+        }
+        if (lateness > task->stats.max_lateness)
+        {
+            task->stats.max_lateness = lateness;
+        }
+        if ((int32_t)(HAL_GetTick() - best_deadline) > 0)
+        {
+            task->stats.missed++;
+        }
+    }
+}
+
+uint32_t SCHED_TimeToNext(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t next = 0xFFFFFFFF;
+
+    for (int i = 0; i < task_count; i++)
+    {
+        if (tasks[i].woken)
+        {
+            return 0;
+        }
+        if (tasks[i].timed)
+        {
+            int32_t remaining = (int32_t)(tasks[i].next_release - now);
+            if (remaining <= 0)
+            {
+                return 0;
+            }
+            if ((uint32_t)remaining < next)
+            {
+                next = (uint32_t)remaining;
+            }
+        }
+    }
+    return next;
+}
+
+const SCHED_Stats *SCHED_GetStats(int id)
+{
+    if (id < 0 || id >= task_count)
+    {
+        return NULL;
+    }
+    return &tasks[id].stats;
+}
+
+const char *SCHED_GetName(int id)
+{
+    if (id < 0 || id >= task_count)
+    {
+        return NULL;
+    }
+    return tasks[id].name;
+}
+
+int SCHED_GetTaskCount(void)
+{
+    return task_count;
+}
+
+void SCHED_ResetStats(void)
+{
+    for (int i = 0; i < task_count; i++)
+    {
+        tasks[i].stats = (SCHED_Stats){0};
+    }
+}
@@ -1,9 +1,34 @@
 
 #include "seg7array.h"
+#include "perf.h"
 
 // 각 자리 별 상태;  abcdefgp 순
 static uint8_t cathodes[4] = {0b00000000, 0b00000000, 0b00000000, 0b00000000};
 
+// 타이머 모드 더블 버퍼
+// frame_next: 메인 루프가 cathodes[]를 묶어서 한 번에 쓰는 다음 프레임 (32비트 쓰기는 원자적이므로 잠금 불필요)
+// frame_shown: 인터럽트가 프레임 시작(1번 자리)마다 frame_next를 복사해서 사용하는 현재 프레임
+static volatile uint32_t frame_next = 0;
+static uint32_t frame_shown = 0;
+
+static TIM_HandleTypeDef *seg_htim = NULL;
+static uint32_t seg_channel = 0;
+static uint8_t seg_use_oc = 0;  // 1이면 seg_channel의 비교 일치로 밝기 조절 (SEG7ARRAY_Init_IT_Brightness)
+static uint8_t seg_pos = 0;  // 타이머 모드 또는 SEG7ARRAY_Task에서 현재 켜져 있는 자리 (0부터 시작)
+
+// 밝기 (0 ~ SEG7ARRAY_BRIGHTNESS_MAX)
+static uint8_t brightness_global = SEG7ARRAY_BRIGHTNESS_MAX;
+static uint8_t brightness_digit[4] = {SEG7ARRAY_BRIGHTNESS_MAX, SEG7ARRAY_BRIGHTNESS_MAX,
+                                      SEG7ARRAY_BRIGHTNESS_MAX, SEG7ARRAY_BRIGHTNESS_MAX};
+
+// 자리별로 켜져 있는 시간 (타이머 tick, 한 자리 주기 이상이면 끄지 않음, 0이면 켜지 않음)
+static volatile uint16_t on_ticks[4];
+
+// 밝기 단계별 켜짐 비율 (1/256 단위, 감마 2.2 보정: 눈에 보이는 밝기가 단계마다 고르게 변함)
+static const uint16_t gamma_table[SEG7ARRAY_BRIGHTNESS_MAX + 1] = {
+	0, 1, 3, 7, 14, 23, 34, 48, 64, 83, 105, 129, 157, 187, 220, 256
+};
+
 static GPIO_TypeDef *catPort[8] = {SEGa_GPIO_Port, SEGb_GPIO_Port, SEGc_GPIO_Port, SEGd_GPIO_Port,
                            SEGe_GPIO_Port, SEGf_GPIO_Port, SEGg_GPIO_Port, SEGp_GPIO_Port};
 
@@ -13,24 +38,442 @@ static const uint16_t catPin[8] = {SEGa_Pin, SEGb_Pin, SEGc_Pin, SEGd_Pin,
 static GPIO_TypeDef *posPort[4] = {SEG1_GPIO_Port, SEG2_GPIO_Port, SEG3_GPIO_Port, SEG4_GPIO_Port};
 static const uint16_t posPin[4] = {SEG1_Pin, SEG2_Pin, SEG3_Pin, SEG4_Pin};
 
+#define SEG7ARRAY_BSRR_SET(pin)   ((uint32_t)(pin))
+#define SEG7ARRAY_BSRR_RESET(pin) ((uint32_t)(pin) << 16)
+
+
+// 렌더링 상태: 마지막으로 그린 값과 같은 값을 다시 그리면 변환 없이 리턴
+typedef enum {
+	RENDER_NONE,
+	RENDER_INT,
+	RENDER_HEX,
+	RENDER_FIXED,
+	RENDER_TEXT,
+	RENDER_MARQUEE
+} SEG7ARRAY_RenderKind;
+
+static SEG7ARRAY_RenderKind render_kind = RENDER_NONE;
+static int32_t render_value = 0;
+static uint8_t render_arg = 0;
+
+// 마키(4자보다 긴 문자열 스크롤) 상태: 글리프로 변환한 문자열 뒤에 공백 4칸을 붙여서 순환
+static uint8_t marquee_glyphs[SEG7ARRAY_TEXT_MAX + 4];
+static uint8_t marquee_len = 0;
+static uint8_t marquee_offset = 0;
+static uint32_t marquee_tick = 0;
+
+
+// 포트별 BSRR 테이블
+// 세그먼트 바이트를 상위 니블(abcd)과 하위 니블(efgp)로 나눠 각 니블 값에 해당하는 set/reset 워드를 미리 계산해두고,
+// 자리 켜기/끄기 워드와 OR해서 포트마다 BSRR에 한 번만 씀 (세그먼트 변경과 자리 전환이 동시에 일어나 잔상이 없음)
+#define SEG7ARRAY_MAX_PORTS 6
+
+typedef struct {
+	GPIO_TypeDef *port;
+	uint32_t seg_hi[16];  // 상위 니블(abcd) 값별 BSRR 워드
+	uint32_t seg_lo[16];  // 하위 니블(efgp) 값별 BSRR 워드
+	uint32_t pos_on[4];   // 자리 켜기 (active-low이므로 reset)
+	uint32_t pos_off[4];  // 자리 끄기 (set)
+} SEG7ARRAY_PortTable;
+
+static SEG7ARRAY_PortTable port_tables[SEG7ARRAY_MAX_PORTS];
+static uint8_t port_count = 0;
+
+
+static SEG7ARRAY_PortTable *SEG7ARRAY_Port_table(GPIO_TypeDef *port) {
+	for (int i = 0; i < port_count; i++) {
+		if (port_tables[i].port == port) return &port_tables[i];
+	}
+	if (port_count == SEG7ARRAY_MAX_PORTS) return NULL;
+
+	SEG7ARRAY_PortTable *table = &port_tables[port_count++];
+	table->port = port;
+	return table;
+}
+
+
+static void SEG7ARRAY_Build_tables(void) {
+	port_count = 0;
+	for (int i = 0; i < SEG7ARRAY_MAX_PORTS; i++) {
+		port_tables[i] = (SEG7ARRAY_PortTable){0};
+	}
+
+	for (int cat = 0; cat < 8; cat++) {
+		SEG7ARRAY_PortTable *table = SEG7ARRAY_Port_table(catPort[cat]);
+		if (table == NULL) continue;
+
+		uint32_t *nibble_table = (cat < 4) ? table->seg_hi : table->seg_lo;
+		int bit = 3 - (cat & 0x03);  // 니블 안에서의 비트 위치 (a, e가 최상위)
+		for (int value = 0; value < 16; value++) {
+			nibble_table[value] |= ((value >> bit) & 1) ? SEG7ARRAY_BSRR_SET(catPin[cat]) : SEG7ARRAY_BSRR_RESET(catPin[cat]);
+		}
+	}
+
+	for (int pos = 0; pos < 4; pos++) {
+		SEG7ARRAY_PortTable *table = SEG7ARRAY_Port_table(posPort[pos]);
+		if (table == NULL) continue;
+
+		table->pos_on[pos] = SEG7ARRAY_BSRR_RESET(posPin[pos]);
+		table->pos_off[pos] = SEG7ARRAY_BSRR_SET(posPin[pos]);
+	}
+}
+
+
+// 포트마다 BSRR 한 번으로 off 자리를 끄고, 세그먼트를 출력하고, on 자리를 켬 (-1이면 해당 동작 없음)
+static void SEG7ARRAY_Output(uint8_t cathode_bits, int off, int on) {
+	for (int i = 0; i < port_count; i++) {
+		const SEG7ARRAY_PortTable *table = &port_tables[i];
+		uint32_t word = table->seg_hi[cathode_bits >> 4] | table->seg_lo[cathode_bits & 0x0F];
+		if (off >= 0) word |= table->pos_off[off];
+		if (on >= 0) word |= table->pos_on[on];
+		table->port->BSRR = word;
+	}
+}
+
+
+// cathodes[]를 32비트로 묶어서 한 번에 게시 (1번 자리가 최하위 바이트)
+static void SEG7ARRAY_Publish(void) {
+	frame_next = (uint32_t)cathodes[0] | ((uint32_t)cathodes[1] << 8) |
+	             ((uint32_t)cathodes[2] << 16) | ((uint32_t)cathodes[3] << 24);
+}
+
+
+void SEG7ARRAY_Init(void) {
+	SEG7ARRAY_Build_tables();
+
+	for (int pos = 0; pos < 4; pos++) {
+		SEG7ARRAY_Output(0, pos, -1);
+	}
+}
+
+
+// 자리별 켜짐 시간을 다시 계산 (밝기가 바뀔 때만 호출되므로 인터럽트에서는 곱셈/나눗셈이 없음)
+static void SEG7ARRAY_Update_on_ticks(void) {
+	const uint32_t period = SEG7ARRAY_DIGIT_TICKS;
+
+	for (int pos = 0; pos < 4; pos++) {
+		uint32_t level = (brightness_global * brightness_digit[pos] + SEG7ARRAY_BRIGHTNESS_MAX / 2) / SEG7ARRAY_BRIGHTNESS_MAX;
+		uint32_t ticks = (period * gamma_table[level]) >> 8;
+		if (ticks == 0 && level > 0) ticks = 1;  // 가장 어두운 단계도 꺼지지 않도록
+		on_ticks[pos] = (uint16_t)ticks;
+	}
+}
+
+
+static void SEG7ARRAY_Start_IT(TIM_HandleTypeDef *htim) {
+	SEG7ARRAY_Init();
+	SEG7ARRAY_Publish();
+	SEG7ARRAY_Update_on_ticks();
+	seg_pos = 3;  // 첫 인터럽트에서 1번 자리부터 시작
+	seg_htim = htim;
+
+	__HAL_TIM_SET_AUTORELOAD(seg_htim, SEG7ARRAY_DIGIT_TICKS - 1);
+	__HAL_TIM_SET_COUNTER(seg_htim, 0);
+	if (seg_use_oc) {
+		__HAL_TIM_SET_COMPARE(seg_htim, seg_channel, SEG7ARRAY_DIGIT_TICKS);  // 한 자리 주기 이상: 비교 일치 없음
+		HAL_TIM_OC_Start_IT(seg_htim, seg_channel);
+	}
+	HAL_TIM_Base_Start_IT(seg_htim);
+}
+
+
+void SEG7ARRAY_Init_IT(TIM_HandleTypeDef *htim) {
+	seg_use_oc = 0;
+	SEG7ARRAY_Start_IT(htim);
+}
+
+
+void SEG7ARRAY_Init_IT_Brightness(TIM_HandleTypeDef *htim, uint32_t channel) {
+	seg_use_oc = 1;
+	seg_channel = channel;
+	SEG7ARRAY_Start_IT(htim);
+}
+
+
+void SEG7ARRAY_Set_brightness(uint8_t level) {
+	if (level > SEG7ARRAY_BRIGHTNESS_MAX) level = SEG7ARRAY_BRIGHTNESS_MAX;
+
+	brightness_global = level;
+	SEG7ARRAY_Update_on_ticks();
+}
+
+
+void SEG7ARRAY_Set_digit_brightness(uint8_t pos, uint8_t level) {
+	if (pos > 4 || pos == 0) return;
+	if (level > SEG7ARRAY_BRIGHTNESS_MAX) level = SEG7ARRAY_BRIGHTNESS_MAX;
+
+	brightness_digit[pos-1] = level;
+	SEG7ARRAY_Update_on_ticks();
+}
+
 
 void SEG7ARRAY_Set_cathode(uint8_t pos, uint8_t cathode_bits) {
-    if (pos > 5 || pos == 0) return;
+    if (pos > 4 || pos == 0) return;
 
+    render_kind = RENDER_NONE;
     cathodes[pos-1] = cathode_bits;
+    SEG7ARRAY_Publish();
+}
+
+
+void SEG7ARRAY_Set_all(const uint8_t cathode_bits[4]) {
+	render_kind = RENDER_NONE;
+	for (int pos = 0; pos < 4; pos++) {
+		cathodes[pos] = cathode_bits[pos];
+	}
+	SEG7ARRAY_Publish();
 }
 
 
 void SEG7ARRAY_Cycle(void) {
+	if (seg_htim != NULL) return;
+	if (port_count == 0) SEG7ARRAY_Build_tables();  // SEG7ARRAY_Init 없이 바로 호출한 기존 코드용
+
+	PERF_BEGIN(PERF_SEG7ARRAY_CYCLE);
+	for (int pos = 0; pos < 4; pos++) {
+		SEG7ARRAY_Output(cathodes[pos], -1, pos);
+
+		HAL_Delay(1);
+
+		SEG7ARRAY_Output(0, pos, -1);
+	}
+	PERF_END(PERF_SEG7ARRAY_CYCLE);
+}
+
+
+// 폴링 방식에서 호출될 때마다 이전 자리를 끄고 다음 자리를 켬 (자리마다 HAL_Delay로 기다리지 않음)
+void SEG7ARRAY_Task(void) {
+	if (seg_htim == NULL) {
+		if (port_count == 0) SEG7ARRAY_Build_tables();
+
+		uint8_t prev = seg_pos;
+		seg_pos = (seg_pos + 1) & 0x03;
+		SEG7ARRAY_Output(cathodes[seg_pos], prev, seg_pos);
+	}
+	SEG7ARRAY_Update();
+}
+
+
+// 상태: seg_pos 자리가 켜져 있음 -> 끄면서 같은 BSRR 쓰기로 다음 자리의 세그먼트를 출력하고 켬
+// 밝기가 최대보다 낮으면 비교 채널을 켜짐 시간에 맞춰두고, 비교 일치 인터럽트에서 자리를 끔
+// (밝기 단계와 상관없이 한 자리당 인터럽트는 최대 2번)
+void SEG7ARRAY_TIM_Callback(void) {
+	if (seg_htim == NULL) return;
+
+	PERF_BEGIN(PERF_SEG7ARRAY_CYCLE);
+	uint8_t prev = seg_pos;
+	seg_pos = (seg_pos + 1) & 0x03;
+	if (seg_pos == 0) {
+		frame_shown = frame_next;
+	}
+
+	uint16_t ticks = on_ticks[seg_pos];
+	if (!seg_use_oc) {
+		if (ticks > 0) ticks = SEG7ARRAY_DIGIT_TICKS;  // 비교 채널이 없으면 밝기 0(꺼짐)과 최대만 구분
+	}
+	else {
+		__HAL_TIM_SET_COMPARE(seg_htim, seg_channel, (ticks > 0 && ticks < SEG7ARRAY_DIGIT_TICKS) ? ticks : SEG7ARRAY_DIGIT_TICKS);
+	}
+	SEG7ARRAY_Output((uint8_t)(frame_shown >> (seg_pos * 8)), prev, ticks > 0 ? seg_pos : -1);
+
+	// 켜짐 시간이 인터럽트 지연보다 짧으면 비교 일치를 놓칠 수 있으므로 바로 끔
+	if (ticks > 0 && ticks < SEG7ARRAY_DIGIT_TICKS && __HAL_TIM_GET_COUNTER(seg_htim) >= ticks) {
+		SEG7ARRAY_Output((uint8_t)(frame_shown >> (seg_pos * 8)), seg_pos, -1);
+	}
+	PERF_END(PERF_SEG7ARRAY_CYCLE);
+}
+
+
+// 켜짐 시간이 끝난 자리를 끔
+void SEG7ARRAY_TIM_OC_Callback(void) {
+	if (seg_htim == NULL || !seg_use_oc) return;
+
+	SEG7ARRAY_Output((uint8_t)(frame_shown >> (seg_pos * 8)), seg_pos, -1);
+}
+
+
+// 7세그먼트 폰트 (' ' ~ '_', 소문자는 대문자로 변환해서 사용, 없는 문자는 공백)
+// B, D, N, O, R, T는 숫자(8, 0)나 다른 글자와 구분되도록 소문자 모양(b, d, n, o, r, t)을 사용하고, V는 소문자 u 모양
+// S/5, Z/2, X/H는 같은 모양 (test_seg7array가 글자끼리 겹치는 모양을 확인)
+static const uint8_t font[64] = {
+	['0' - ' '] = 0xFC, ['1' - ' '] = 0x60, ['2' - ' '] = 0xDA, ['3' - ' '] = 0xF2, ['4' - ' '] = 0x66,
+	['5' - ' '] = 0xB6, ['6' - ' '] = 0xBE, ['7' - ' '] = 0xE0, ['8' - ' '] = 0xFE, ['9' - ' '] = 0xF6,
+	['A' - ' '] = 0xEE, ['B' - ' '] = 0x3E, ['C' - ' '] = 0x9C, ['D' - ' '] = 0x7A, ['E' - ' '] = 0x9E,
+	['F' - ' '] = 0x8E, ['G' - ' '] = 0xBC, ['H' - ' '] = 0x6E, ['I' - ' '] = 0x0C, ['J' - ' '] = 0x78,
+	['K' - ' '] = 0xAE, ['L' - ' '] = 0x1C, ['M' - ' '] = 0xA8, ['N' - ' '] = 0x2A, ['O' - ' '] = 0x3A,
+	['P' - ' '] = 0xCE, ['Q' - ' '] = 0xE6, ['R' - ' '] = 0x0A, ['S' - ' '] = 0xB6, ['T' - ' '] = 0x1E,
+	['U' - ' '] = 0x7C, ['V' - ' '] = 0x38, ['W' - ' '] = 0x54, ['X' - ' '] = 0x6E, ['Y' - ' '] = 0x76,
+	['Z' - ' '] = 0xDA,
+	['-' - ' '] = 0x02, ['_' - ' '] = 0x10, ['=' - ' '] = 0x12, ['"' - ' '] = 0x44, ['\'' - ' '] = 0x04,
+	['[' - ' '] = 0x9C, [']' - ' '] = 0xF0, ['?' - ' '] = 0xCA,
+};
+
+#define SEG7ARRAY_DP 0x01
+#define SEG7ARRAY_MINUS 0x02
+
+
+uint8_t SEG7ARRAY_Glyph(char c) {
+	if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+	if (c < ' ' || c > '_') return 0;
+	return font[c - ' '];
+}
+
+
+// 곱셈으로 10으로 나누기 (n * ceil(2^35 / 10) >> 35, 32비트 전체 범위에서 정확, Cortex-M4에서 UMULL 1개)
+static inline uint32_t SEG7ARRAY_Div10(uint32_t n) {
+	return (uint32_t)(((uint64_t)n * 0xCCCCCCCDu) >> 35);
+}
+
+
+// 렌더링 결과를 cathodes[]와 비교해서 달라진 경우에만 게시
+static void SEG7ARRAY_Show_frame(const uint8_t frame[4]) {
+	if (cathodes[0] == frame[0] && cathodes[1] == frame[1] &&
+	    cathodes[2] == frame[2] && cathodes[3] == frame[3]) return;
+
 	for (int pos = 0; pos < 4; pos++) {
-		for (int cat = 0; cat < 8; cat++) {
-			HAL_GPIO_WritePin(catPort[cat], catPin[cat], (GPIO_PinState)((cathodes[pos] >> (7 - cat)) & 1));
+		cathodes[pos] = frame[pos];
+	}
+	SEG7ARRAY_Publish();
+}
+
+
+// 같은 값을 다시 그리는 경우 1을 반환, 아니면 렌더링 상태를 갱신하고 0을 반환
+static int SEG7ARRAY_Same_render(SEG7ARRAY_RenderKind kind, int32_t value, uint8_t arg) {
+	if (render_kind == kind && render_value == value && render_arg == arg) return 1;
+
+	render_kind = kind;
+	render_value = value;
+	render_arg = arg;
+	return 0;
+}
+
+
+// 부호 있는 정수를 오른쪽 정렬로 변환 (min_digits: 앞을 0으로 채울 최소 자릿수, 범위를 넘으면 "----")
+static void SEG7ARRAY_Render_decimal(uint8_t frame[4], int32_t value, int min_digits) {
+	uint32_t n = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+	int pos = 3;
+
+	for (int i = 0; i < 4; i++) frame[i] = 0;
+
+	do {
+		uint32_t q = SEG7ARRAY_Div10(n);
+		frame[pos--] = font['0' - ' ' + (n - q * 10)];
+		n = q;
+		min_digits--;
+	} while ((n > 0 || min_digits > 0) && pos >= 0);
+
+	if (n > 0 || (value < 0 && pos < 0)) {
+		for (int i = 0; i < 4; i++) frame[i] = SEG7ARRAY_MINUS;
+		return;
+	}
+	if (value < 0) frame[pos] = SEG7ARRAY_MINUS;
+}
+
+
+void SEG7ARRAY_ShowInt(int32_t value) {
+	if (SEG7ARRAY_Same_render(RENDER_INT, value, 0)) return;
+
+	uint8_t frame[4];
+	SEG7ARRAY_Render_decimal(frame, value, 1);
+	SEG7ARRAY_Show_frame(frame);
+}
+
+
+void SEG7ARRAY_ShowHex(uint16_t value) {
+	if (SEG7ARRAY_Same_render(RENDER_HEX, value, 0)) return;
+
+	static const char hex[] = "0123456789ABCDEF";
+	uint8_t frame[4];
+	for (int pos = 3; pos >= 0; pos--) {
+		frame[pos] = SEG7ARRAY_Glyph(hex[value & 0x0F]);
+		value >>= 4;
+	}
+	SEG7ARRAY_Show_frame(frame);
+}
+
+
+void SEG7ARRAY_ShowFixed(int32_t value, uint8_t decimals) {
+	if (decimals > 3) decimals = 3;
+	if (SEG7ARRAY_Same_render(RENDER_FIXED, value, decimals)) return;
+
+	uint8_t frame[4];
+	SEG7ARRAY_Render_decimal(frame, value, decimals + 1);  // 소수점 앞 최소 한 자리 (0.05)
+	if (decimals > 0 && frame[3 - decimals] != SEG7ARRAY_MINUS) {
+		frame[3 - decimals] |= SEG7ARRAY_DP;
+	}
+	SEG7ARRAY_Show_frame(frame);
+}
+
+
+// 문자열을 글리프로 변환 ('.'은 앞 글자의 소수점으로 합침), 변환한 글리프 수 반환
+static uint8_t SEG7ARRAY_Render_text(uint8_t *glyphs, uint8_t max, const char *text) {
+	uint8_t len = 0;
+
+	for (; *text != '\0'; text++) {
+		if (*text == '.' && len > 0 && (glyphs[len - 1] & SEG7ARRAY_DP) == 0) {
+			glyphs[len - 1] |= SEG7ARRAY_DP;
+			continue;
 		}
+		if (len == max) break;
+		glyphs[len++] = (*text == '.') ? SEG7ARRAY_DP : SEG7ARRAY_Glyph(*text);
+	}
+	return len;
+}
 
-		HAL_GPIO_WritePin(posPort[pos], posPin[pos], GPIO_PIN_RESET);
 
-		HAL_Delay(1);
+static void SEG7ARRAY_Show_marquee_window(void) {
+	uint8_t frame[4];
+	uint8_t index = marquee_offset;
+
+	for (int pos = 0; pos < 4; pos++) {
+		frame[pos] = marquee_glyphs[index];
+		if (++index == marquee_len) index = 0;
+	}
+	SEG7ARRAY_Show_frame(frame);
+}
+
+
+void SEG7ARRAY_ShowText(const char *text) {
+	uint8_t glyphs[SEG7ARRAY_TEXT_MAX];
+	uint8_t len = SEG7ARRAY_Render_text(glyphs, SEG7ARRAY_TEXT_MAX, text);
+
+	if (len <= 4) {
+		uint8_t frame[4] = {0, 0, 0, 0};
+		for (int i = 0; i < len; i++) frame[i] = glyphs[i];
+		render_kind = RENDER_TEXT;
+		SEG7ARRAY_Show_frame(frame);
+		return;
+	}
 
-		HAL_GPIO_WritePin(posPort[pos], posPin[pos], GPIO_PIN_SET);
+	// 같은 문자열로 이미 스크롤 중이면 위치를 유지
+	if (render_kind == RENDER_MARQUEE && marquee_len == len + 4) {
+		int same = 1;
+		for (int i = 0; i < len; i++) {
+			if (marquee_glyphs[i] != glyphs[i]) same = 0;
+		}
+		if (same) return;
 	}
+
+	for (int i = 0; i < len; i++) marquee_glyphs[i] = glyphs[i];
+	for (int i = 0; i < 4; i++) marquee_glyphs[len + i] = 0;
+	marquee_len = len + 4;
+	marquee_offset = 0;
+	marquee_tick = HAL_GetTick();
+	render_kind = RENDER_MARQUEE;
+	SEG7ARRAY_Show_marquee_window();
+}
+
+
+void SEG7ARRAY_Update(void) {
+	if (render_kind != RENDER_MARQUEE) return;
+	if (HAL_GetTick() - marquee_tick < SEG7ARRAY_SCROLL_MS) return;
+
+	marquee_tick += SEG7ARRAY_SCROLL_MS;
+	if (++marquee_offset == marquee_len) marquee_offset = 0;
+	SEG7ARRAY_Show_marquee_window();
+}
+
+
+uint8_t SEG7ARRAY_IsBlank(void) {
+	return frame_next == 0 && render_kind != RENDER_MARQUEE;
 }
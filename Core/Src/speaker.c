@@ -1,22 +1,285 @@
 
 #include "speaker.h"
+#include "perf.h"
 
 #define SAMPLING_RATE 100000 // 타이머 콜백 주파수 (100kHz)
 
+// 음량 최대값 (파형 High 구간 = 주기 * volume / 512, 최대일 때 duty 50%)
+#define VOLUME_MAX 256
+
 // ===== 내부 변수 (static으로 선언하여 이 파일 안에서만 접근 가능) =====
 // 이 모듈이 사용할 타이머 핸들러 포인터
 static TIM_HandleTypeDef *speaker_htim;
 
-// 스피커 재생 상태 플래그
+// 스피커 재생 상태 플래그 (단음 또는 큐 재생 중)
 static volatile uint8_t is_playing = 0;
 
-// 주파수 제어용 변수
-static volatile uint32_t toggle_period_ticks = 0;
-static volatile uint32_t toggle_tick_counter = 0;
+// 인터럽트 방식 파형 변수
+static volatile uint32_t period_ticks = 0;   // 한 주기의 샘플 수 (0: 소리 없음)
+static volatile uint32_t high_ticks = 0;     // 한 주기 중 High 구간의 샘플 수 (음량)
+static volatile uint32_t phase_counter = 0;
+static volatile uint32_t ms_counter = 0;     // 1ms마다 페이드 처리용
+
+// 출력 방식
+typedef enum {
+    MODE_TOGGLE,  // 100kHz 타이머 인터럽트에서 핀 토글 (SPEAKER_Init)
+    MODE_PWM,     // 타이머 채널이 핀을 직접 구동 (SPEAKER_Init_PWM)
+    MODE_DDS      // 파형 합성 후 PWM duty를 DMA로 출력 (SPEAKER_Init_DDS)
+} SpeakerMode;
+
+static SpeakerMode speaker_mode = MODE_TOGGLE;
+
+// 타이머 출력(PWM) 방식 변수
+static uint32_t speaker_channel = 0;
+static uint32_t pwm_reload = 0;          // 현재 음의 ARR + 1
+static uint32_t last_update_tick = 0;    // SPEAKER_Update에서 경과 시간 계산용
+
+// DDS 방식 변수
+typedef struct {
+    uint32_t phase;          // 위상 누산기 (상위 6비트가 파형 테이블 인덱스)
+    uint32_t increment;      // 샘플마다 더할 위상 (주파수 * 2^32 / 샘플링 주파수)
+    const int16_t *table;    // 파형 테이블
+    int16_t level;           // 음량 (0 ~ 256)
+} DdsVoice;
+
+static DdsVoice dds_voices[SPEAKER_DDS_VOICES];
+static uint16_t dds_buffer[SPEAKER_DDS_BLOCK * 2];  // DMA 순환 버퍼 (앞/뒤 절반을 번갈아 채움)
+static volatile uint8_t dds_running = 0;
+static const uint16_t dds_center = (SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE) / 2;  // 무음일 때의 duty (ARR의 절반)
+
+// 64단계 파형 테이블 (Q15)
+static const int16_t wave_square[64] = {
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767
+};
+
+static const int16_t wave_triangle[64] = {
+    0, 2048, 4096, 6144, 8192, 10240, 12288, 14336, 16384, 18431, 20479, 22527, 24575, 26623, 28671, 30719,
+    32767, 30719, 28671, 26623, 24575, 22527, 20479, 18431, 16384, 14336, 12288, 10240, 8192, 6144, 4096, 2048,
+    0, -2048, -4096, -6144, -8192, -10240, -12288, -14336, -16384, -18431, -20479, -22527, -24575, -26623, -28671, -30719,
+    -32767, -30719, -28671, -26623, -24575, -22527, -20479, -18431, -16384, -14336, -12288, -10240, -8192, -6144, -4096, -2048
+};
+
+static const int16_t wave_sine[64] = {
+    0, 3212, 6393, 9512, 12539, 15446, 18204, 20787, 23170, 25329, 27245, 28898, 30273, 31356, 32137, 32609,
+    32767, 32609, 32137, 31356, 30273, 28898, 27245, 25329, 23170, 20787, 18204, 15446, 12539, 9512, 6393, 3212,
+    0, -3212, -6393, -9512, -12539, -15446, -18204, -20787, -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609,
+    -32767, -32609, -32137, -31356, -30273, -28898, -27245, -25329, -23170, -20787, -18204, -15446, -12539, -9512, -6393, -3212
+};
+
+// 시퀀서 큐 (메인 루프가 head에 추가, 인터럽트가 pos 위치를 재생하고 tail을 넘김)
+// 반복 재생 중에는 tail을 넘기지 않고 pos만 tail ~ head 사이를 순환
+static SPEAKER_Note note_queue[SPEAKER_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;
+static volatile uint16_t queue_tail = 0;
+static volatile uint16_t queue_pos = 0;
+static volatile uint8_t loop_enabled = 0;
+static volatile uint16_t tempo_percent = 100;
+
+// 현재 음 상태 (시간 단위: 인터럽트 방식은 샘플, 타이머 출력 방식은 ms)
+static volatile uint8_t in_gap = 0;            // 1: 음 뒤의 쉼 구간
+static volatile uint32_t remaining_units = 0;  // 현재 음(또는 쉼)의 남은 시간
+static volatile uint32_t gap_units = 0;        // 현재 음 뒤의 쉼 시간
+
+// 페이드 아웃 (ms 단위, fade_total이 0이면 페이드 중이 아님)
+static volatile uint32_t fade_total = 0;
+static volatile uint32_t fade_remaining = 0;
+static volatile uint32_t volume = VOLUME_MAX;
+
+
+// ===== 내부 함수 =====
+
+// 주파수에 맞는 PSC/ARR을 계산해서 PWM 출력 시작 (duty는 음량에 따라 최대 50%)
+// 분해능을 최대로 하기 위해 ARR이 16비트에 들어가는 가장 작은 PSC를 사용
+static void SPEAKER_Start_PWM(uint32_t frequency) {
+    uint32_t period = (SPEAKER_TIM_CLOCK_HZ + frequency / 2) / frequency;  // 분주 전 주기 (타이머 클럭 수)
+    uint32_t prescaler = (period - 1) / 65536;
+    uint32_t reload = (period + (prescaler + 1) / 2) / (prescaler + 1);     // 반올림
+    if (reload < 2)
+    {
+        reload = 2;
+    }
+    pwm_reload = reload;
+
+    HAL_TIM_PWM_Stop(speaker_htim, speaker_channel);
+    __HAL_TIM_SET_PRESCALER(speaker_htim, prescaler);
+    __HAL_TIM_SET_AUTORELOAD(speaker_htim, reload - 1);
+    __HAL_TIM_SET_COMPARE(speaker_htim, speaker_channel, (reload * volume) >> 9);
+    HAL_TIM_GenerateEvent(speaker_htim, TIM_EVENTSOURCE_UPDATE);  // 프리스케일러 즉시 반영
+    HAL_TIM_PWM_Start(speaker_htim, speaker_channel);
+}
+
+// [인터럽트 또는 인터럽트 차단 상태에서 호출] 목소리 설정 (frequency가 0이면 끔, level: 0 ~ 256)
+static void SPEAKER_DDS_Set_voice(uint8_t voice, uint32_t frequency, SPEAKER_Wave wave, uint32_t level) {
+    static const int16_t *const tables[3] = {wave_square, wave_triangle, wave_sine};
+
+    dds_voices[voice].increment = (uint32_t)(((uint64_t)frequency << 32) / SPEAKER_DDS_SAMPLE_RATE);
+    dds_voices[voice].table = tables[wave];
+    dds_voices[voice].level = (int16_t)(frequency ? level : 0);
+    if (frequency == 0) {
+        dds_voices[voice].phase = 0;
+    }
+}
+
+// [인터럽트 또는 인터럽트 차단 상태에서 호출] DDS 출력 시작 (버퍼를 미리 채우고 DMA 순환 전송 시작)
+static void SPEAKER_DDS_Fill(uint16_t *block);
+
+static void SPEAKER_DDS_Start(void) {
+    if (dds_running) {
+        return;
+    }
+    dds_running = 1;
+    SPEAKER_DDS_Fill(&dds_buffer[0]);
+    SPEAKER_DDS_Fill(&dds_buffer[SPEAKER_DDS_BLOCK]);
+    HAL_TIM_PWM_Start_DMA(speaker_htim, speaker_channel, (uint32_t *)dds_buffer, SPEAKER_DDS_BLOCK * 2);
+}
+
+// 음량이 바뀌었을 때 파형의 High 구간을 다시 계산
+static void SPEAKER_Apply_volume(void) {
+    if (speaker_mode == MODE_PWM) {
+        __HAL_TIM_SET_COMPARE(speaker_htim, speaker_channel, (pwm_reload * volume) >> 9);
+    } else if (speaker_mode == MODE_DDS) {
+        if (dds_voices[0].increment != 0) {
+            dds_voices[0].level = (int16_t)volume;
+        }
+    } else {
+        high_ticks = (period_ticks * volume) >> 9;
+        if (period_ticks && phase_counter >= high_ticks) {
+            // 줄어든 High 구간을 이미 지났으면 SPEAKER_Loop가 내리지 못하고 한 주기 내내 High가 되므로 여기서 내림
+            HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, GPIO_PIN_RESET);
+        }
+    }
+}
+
+static void SPEAKER_Tone_on(uint32_t frequency) {
+    if (speaker_mode == MODE_PWM) {
+        SPEAKER_Start_PWM(frequency);
+        return;
+    }
+    if (speaker_mode == MODE_DDS) {
+        if (frequency < SPEAKER_DDS_SAMPLE_RATE / 2) {
+            SPEAKER_DDS_Set_voice(0, frequency, SPEAKER_WAVE_SQUARE, volume);
+            SPEAKER_DDS_Start();
+        }
+        return;
+    }
+
+    // 반올림하여 주파수 오차를 줄임
+    uint32_t ticks = (SAMPLING_RATE + frequency / 2) / frequency;
+    if (ticks < 2)
+    {
+        ticks = 2;
+    }
+    period_ticks = ticks;
+    high_ticks = (ticks * volume) >> 9;
+    phase_counter = 0;
+    HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, high_ticks ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void SPEAKER_Tone_off(void) {
+    if (speaker_mode == MODE_DDS) {
+        SPEAKER_DDS_Set_voice(0, 0, SPEAKER_WAVE_SQUARE, 0);
+        return;
+    }
+    if (speaker_mode == MODE_PWM) {
+        HAL_TIM_PWM_Stop(speaker_htim, speaker_channel);
+        return;
+    }
+    period_ticks = 0;
+    HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, GPIO_PIN_RESET);
+}
+
+// ms를 시간 단위로 변환 (템포 반영, 최소 1)
+static uint32_t SPEAKER_Units(uint32_t ms) {
+    uint32_t units_per_ms = (speaker_mode == MODE_TOGGLE) ? SAMPLING_RATE / 1000 : 1;
+    uint32_t units = (uint32_t)((uint64_t)ms * units_per_ms * 100 / tempo_percent);
+    return units ? units : 1;
+}
 
-// 재생 시간 제어용 변수
-static volatile uint32_t play_duration_ticks = 0;
-static volatile uint32_t duration_tick_counter = 0;
+static void SPEAKER_Play_note(uint32_t frequency, uint32_t duration_ms, uint32_t gap_ms) {
+    if (frequency == 0) {
+        SPEAKER_Tone_off();
+    } else {
+        SPEAKER_Tone_on(frequency);
+    }
+    remaining_units = SPEAKER_Units(duration_ms);
+    gap_units = gap_ms ? SPEAKER_Units(gap_ms) : 0;
+    in_gap = 0;
+}
+
+// 재생을 모두 끝냄 (큐를 비움)
+static void SPEAKER_Finish(void) {
+    is_playing = 0;
+    queue_tail = queue_pos = queue_head;
+    fade_total = 0;
+    volume = VOLUME_MAX;
+    SPEAKER_Tone_off();
+    if (speaker_mode == MODE_TOGGLE) {
+        HAL_TIM_Base_Stop_IT(speaker_htim);
+    }
+}
+
+// 큐의 다음 음을 재생, 큐가 비었으면 재생 종료
+static void SPEAKER_Next_note(void) {
+    if (!loop_enabled) {
+        queue_tail = queue_pos;
+    }
+    if (queue_pos == queue_head) {
+        SPEAKER_Finish();
+        return;
+    }
+
+    const SPEAKER_Note *note = &note_queue[queue_pos];
+    queue_pos = (queue_pos + 1) % SPEAKER_QUEUE_SIZE;
+    if (loop_enabled && queue_pos == queue_head) {
+        queue_pos = queue_tail;
+    }
+    SPEAKER_Play_note(note->frequency, note->duration_ms, note->gap_ms);
+}
+
+// [인터럽트에서 호출] 재생 시간 진행 (음 -> 쉼 -> 다음 음)
+static void SPEAKER_Advance(uint32_t elapsed) {
+    while (is_playing && elapsed >= remaining_units) {
+        elapsed -= remaining_units;
+        if (!in_gap && gap_units > 0) {
+            in_gap = 1;
+            remaining_units = gap_units;
+            SPEAKER_Tone_off();
+        } else {
+            SPEAKER_Next_note();
+        }
+    }
+    if (is_playing) {
+        remaining_units -= elapsed;
+    }
+}
+
+// [인터럽트에서 호출] 페이드 아웃 진행 (ms 단위)
+static void SPEAKER_Fade(uint32_t elapsed_ms) {
+    if (fade_total == 0) {
+        return;
+    }
+    if (fade_remaining <= elapsed_ms) {
+        SPEAKER_Finish();
+        return;
+    }
+    fade_remaining -= elapsed_ms;
+    volume = (uint32_t)((uint64_t)VOLUME_MAX * fade_remaining / fade_total);
+    SPEAKER_Apply_volume();
+}
+
+// [인터럽트 차단 상태에서 호출] 재생 시작
+static void SPEAKER_Begin(void) {
+    is_playing = 1;
+    if (speaker_mode == MODE_TOGGLE) {
+        ms_counter = 0;
+        HAL_TIM_Base_Start_IT(speaker_htim);
+    } else {
+        last_update_tick = HAL_GetTick();
+    }
+}
 
 
 // ===== 함수 정의 =====
@@ -24,8 +287,29 @@ static volatile uint32_t duration_tick_counter = 0;
 void SPEAKER_Init(TIM_HandleTypeDef *htim) {
     // main.c에서 넘겨받은 타이머 핸들러를 내부 포인터 변수에 저장
     speaker_htim = htim;
-    // 타이머 인터럽트 시작
-    HAL_TIM_Base_Start_IT(speaker_htim);
+    speaker_mode = MODE_TOGGLE;
+    // 타이머 인터럽트는 재생 중에만 켬 (SPEAKER_Start에서 시작, SPEAKER_Stop에서 정지)
+}
+
+void SPEAKER_Init_PWM(TIM_HandleTypeDef *htim, uint32_t channel) {
+    speaker_htim = htim;
+    speaker_channel = channel;
+    speaker_mode = MODE_PWM;
+}
+
+void SPEAKER_Init_DDS(TIM_HandleTypeDef *htim, uint32_t channel) {
+    speaker_htim = htim;
+    speaker_channel = channel;
+    speaker_mode = MODE_DDS;
+
+    for (int v = 0; v < SPEAKER_DDS_VOICES; v++) {
+        dds_voices[v] = (DdsVoice){0, 0, wave_square, 0};
+    }
+
+    // PWM 주기 = 샘플링 주기
+    __HAL_TIM_SET_PRESCALER(speaker_htim, 0);
+    __HAL_TIM_SET_AUTORELOAD(speaker_htim, SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE - 1);
+    HAL_TIM_GenerateEvent(speaker_htim, TIM_EVENTSOURCE_UPDATE);
 }
 
 void SPEAKER_Start(uint32_t frequency, uint32_t play_time_ms) {
@@ -33,46 +317,315 @@ void SPEAKER_Start(uint32_t frequency, uint32_t play_time_ms) {
         return;
     }
 
+    uint32_t primask = __get_PRIMASK();
     __disable_irq();
 
-    uint32_t temp_toggle_ticks = SAMPLING_RATE / (frequency * 2);
-    if (temp_toggle_ticks == 0)
-    {
-        temp_toggle_ticks = 1;
+    // 큐에 남은 음을 지우고 단음 재생
+    queue_tail = queue_pos = queue_head;
+    fade_total = 0;
+    volume = VOLUME_MAX;
+    SPEAKER_Play_note(frequency, play_time_ms, 0);
+    SPEAKER_Begin();
+
+    __set_PRIMASK(primask);
+}
+
+void SPEAKER_Stop(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SPEAKER_Finish();
+    __set_PRIMASK(primask);
+}
+
+uint16_t SPEAKER_Enqueue(const SPEAKER_Note *notes, uint16_t count) {
+    uint16_t queued = 0;
+
+    while (queued < count) {
+        uint16_t next = (queue_head + 1) % SPEAKER_QUEUE_SIZE;
+        if (next == queue_tail) {
+            break;  // 큐가 가득 참
+        }
+        note_queue[queue_head] = notes[queued++];
+        queue_head = next;
     }
-    toggle_period_ticks = temp_toggle_ticks;
 
-    play_duration_ticks = (uint64_t)SAMPLING_RATE * play_time_ms / 1000;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!is_playing && queue_pos != queue_head) {
+        fade_total = 0;
+        volume = VOLUME_MAX;
+        SPEAKER_Next_note();
+        SPEAKER_Begin();
+    }
+    __set_PRIMASK(primask);
 
-    toggle_tick_counter = 0;
-    duration_tick_counter = 0;
-    is_playing = 1;
+    return queued;
+}
 
-    __enable_irq();
+void SPEAKER_SetLoop(uint8_t enable) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!enable && loop_enabled) {
+        queue_tail = queue_pos;  // 이미 재생한 음은 버림
+    }
+    loop_enabled = enable;
+    __set_PRIMASK(primask);
 }
 
-void SPEAKER_Stop(void) {
-    is_playing = 0;
-    HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, GPIO_PIN_RESET);
+void SPEAKER_SetTempo(uint16_t percent) {
+    if (percent < 10) {
+        percent = 10;
+    }
+    tempo_percent = percent;
+}
+
+void SPEAKER_FadeOut(uint32_t fade_ms) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (is_playing) {
+        if (fade_ms == 0) {
+            SPEAKER_Finish();
+        } else {
+            fade_total = fade_remaining = fade_ms;
+        }
+    }
+    __set_PRIMASK(primask);
 }
 
 void SPEAKER_Loop(void) {
+    PERF_BEGIN(PERF_SPEAKER_LOOP);
     if (is_playing) {
-        // 주파수 생성 로직
-        toggle_tick_counter++;
-        if (toggle_tick_counter >= toggle_period_ticks) {
-            HAL_GPIO_TogglePin(Speaker_GPIO_Port, Speaker_Pin);
-            toggle_tick_counter = 0;
+        // 주파수 생성 로직 (주기의 시작에서 High, high_ticks가 지나면 Low)
+        if (period_ticks) {
+            phase_counter++;
+            if (phase_counter == high_ticks) {
+                HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, GPIO_PIN_RESET);
+            }
+            if (phase_counter >= period_ticks) {
+                phase_counter = 0;
+                if (high_ticks) {
+                    HAL_GPIO_WritePin(Speaker_GPIO_Port, Speaker_Pin, GPIO_PIN_SET);
+                }
+            }
         }
 
-        // 재생 시간 카운트 로직
-        duration_tick_counter++;
-        if (duration_tick_counter >= play_duration_ticks) {
-            SPEAKER_Stop();
+        // 재생 시간 카운트 로직 (샘플 단위로 음이 바뀜)
+        SPEAKER_Advance(1);
+
+        // 페이드는 1ms마다 처리
+        if (++ms_counter >= SAMPLING_RATE / 1000) {
+            ms_counter = 0;
+            SPEAKER_Fade(1);
         }
     }
+    PERF_END(PERF_SPEAKER_LOOP);
+}
+
+void SPEAKER_Update(void) {
+    if (speaker_mode == MODE_TOGGLE || !is_playing) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t now = HAL_GetTick();
+    uint32_t elapsed = now - last_update_tick;
+    last_update_tick = now;
+    if (elapsed > 0) {
+        SPEAKER_Fade(elapsed);
+        SPEAKER_Advance(elapsed);
+    }
+    __set_PRIMASK(primask);
+}
+
+void SPEAKER_Task(void) {
+    SPEAKER_Update();
 }
 
 uint8_t SPEAKER_IsPlaying(void) {
-    return is_playing;
+    // DDS 목소리만 켜져 있어도 타이머와 DMA가 동작 중이므로 재생 중으로 봄
+    return is_playing || dds_running;
+}
+
+void SPEAKER_DDS_Play(uint8_t voice, uint32_t frequency, SPEAKER_Wave wave, uint8_t level) {
+    if (voice >= SPEAKER_DDS_VOICES || frequency == 0 || frequency >= SPEAKER_DDS_SAMPLE_RATE / 2 || wave > SPEAKER_WAVE_SINE) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SPEAKER_DDS_Set_voice(voice, frequency, wave, level + (level >> 7));  // 0~255 -> 0~256
+    SPEAKER_DDS_Start();
+    __set_PRIMASK(primask);
+}
+
+void SPEAKER_DDS_Stop(uint8_t voice) {
+    if (voice >= SPEAKER_DDS_VOICES) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SPEAKER_DDS_Set_voice(voice, 0, SPEAKER_WAVE_SQUARE, 0);
+    __set_PRIMASK(primask);
+}
+
+// 한 블록(SPEAKER_DDS_BLOCK 샘플)을 합성해서 PWM duty 값으로 저장
+// 모든 목소리를 같은 비율로 더하므로 SPEAKER_DDS_VOICES개가 모두 최대 음량이어도 넘치지 않음
+static void SPEAKER_DDS_Fill(uint16_t *block) {
+    PERF_BEGIN(PERF_SPEAKER_DDS_FILL);
+    DdsVoice *voices = dds_voices;
+
+#if SPEAKER_DDS_USE_SMLAD
+    // Cortex-M4 DSP: 두 목소리의 16비트 샘플 x 음량을 SMLAD 한 번으로 곱해서 누적
+    uint32_t levels[SPEAKER_DDS_VOICES / 2];
+    for (int v = 0; v < SPEAKER_DDS_VOICES; v += 2) {
+        levels[v / 2] = __PKHBT(voices[v].level, voices[v + 1].level, 16);
+    }
+
+    for (int i = 0; i < SPEAKER_DDS_BLOCK; i++) {
+        int32_t acc = 0;
+        for (int v = 0; v < SPEAKER_DDS_VOICES; v += 2) {
+            int16_t s0 = voices[v].table[voices[v].phase >> 26];
+            int16_t s1 = voices[v + 1].table[voices[v + 1].phase >> 26];
+            voices[v].phase += voices[v].increment;
+            voices[v + 1].phase += voices[v + 1].increment;
+            acc = (int32_t)__SMLAD(__PKHBT(s0, s1, 16), levels[v / 2], (uint32_t)acc);
+        }
+        block[i] = (uint16_t)(dds_center + (((acc >> 8) * dds_center) >> (15 + SPEAKER_DDS_VOICES_SHIFT)));
+    }
+#else
+    for (int i = 0; i < SPEAKER_DDS_BLOCK; i++) {
+        int32_t acc = 0;
+        for (int v = 0; v < SPEAKER_DDS_VOICES; v++) {
+            acc += voices[v].table[voices[v].phase >> 26] * voices[v].level;
+            voices[v].phase += voices[v].increment;
+        }
+        block[i] = (uint16_t)(dds_center + (((acc >> 8) * dds_center) >> (15 + SPEAKER_DDS_VOICES_SHIFT)));
+    }
+#endif
+    PERF_END(PERF_SPEAKER_DDS_FILL);
+}
+
+// [인터럽트에서 호출] 재생이 끝난 절반 블록을 다시 채움, 모든 목소리가 꺼져 있으면 출력 정지
+static void SPEAKER_DDS_Refill(uint16_t *block) {
+    if (!dds_running) {
+        return;
+    }
+    for (int v = 0; v < SPEAKER_DDS_VOICES; v++) {
+        if (dds_voices[v].increment != 0) {
+            SPEAKER_DDS_Fill(block);
+            return;
+        }
+    }
+    HAL_TIM_PWM_Stop_DMA(speaker_htim, speaker_channel);
+    dds_running = 0;
+}
+
+void SPEAKER_DMA_HalfCpltCallback(void) {
+    SPEAKER_DDS_Refill(&dds_buffer[0]);
+}
+
+void SPEAKER_DMA_CpltCallback(void) {
+    SPEAKER_DDS_Refill(&dds_buffer[SPEAKER_DDS_BLOCK]);
+}
+
+// RTTTL 옥타브 8의 음 주파수 (C ~ B, Hz), 낮은 옥타브는 오른쪽 시프트로 계산
+static const uint16_t rtttl_octave8[12] = {
+    4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902
+};
+
+static uint32_t SPEAKER_Parse_number(const char **p) {
+    uint32_t n = 0;
+    while (**p >= '0' && **p <= '9') {
+        n = n * 10 + (uint32_t)(**p - '0');
+        (*p)++;
+    }
+    return n;
+}
+
+uint16_t SPEAKER_ParseRTTTL(const char *rtttl, SPEAKER_Note *notes, uint16_t max_notes) {
+    static const int8_t note_index[7] = {9, 11, 0, 2, 4, 5, 7};  // a b c d e f g
+    uint32_t default_duration = 4, default_octave = 6, bpm = 63;
+    const char *p = rtttl;
+    uint16_t count = 0;
+
+    // 이름
+    while (*p != '\0' && *p != ':') p++;
+    if (*p != ':') return 0;
+    p++;
+
+    // 기본값 (d=4,o=6,b=63)
+    while (*p != '\0' && *p != ':') {
+        char key = *p++;
+        if (*p == '=') {
+            p++;
+            uint32_t value = SPEAKER_Parse_number(&p);
+            if (key == 'd' && value > 0) default_duration = value;
+            if (key == 'o' && value >= 4 && value <= 8) default_octave = value;
+            if (key == 'b' && value > 0) bpm = value;
+        }
+        while (*p != '\0' && *p != ',' && *p != ':') p++;
+        if (*p == ',') p++;
+    }
+    if (*p != ':') return 0;
+    p++;
+
+    uint32_t whole_ms = 240000 / bpm;  // 온음표 길이 (4박)
+
+    // 음표 ([길이]음[#][.][옥타브][.])
+    while (*p != '\0' && count < max_notes) {
+        while (*p == ' ' || *p == ',') p++;
+        if (*p == '\0') break;
+
+        uint32_t duration = SPEAKER_Parse_number(&p);
+        if (duration == 0) duration = default_duration;
+
+        char c = *p++;
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        int index = -1;  // -1: 쉼표
+        if (c == 'h') c = 'b';
+        if (c >= 'a' && c <= 'g') index = note_index[c - 'a'];
+        if (*p == '#') {
+            p++;
+            index++;
+        }
+
+        uint8_t dotted = 0;
+        if (*p == '.') {
+            p++;
+            dotted = 1;
+        }
+        uint32_t octave = default_octave;
+        if (*p >= '4' && *p <= '8') octave = (uint32_t)(*p++ - '0');
+        if (*p == '.') {
+            p++;
+            dotted = 1;
+        }
+        while (*p != '\0' && *p != ',') p++;
+
+        uint32_t ms = whole_ms / duration;
+        if (dotted) ms += ms / 2;
+        if (ms > UINT16_MAX) ms = UINT16_MAX;  // 아주 느린 템포(b=4의 점온음표 = 90000ms)는 SPEAKER_Note에 들어가도록 제한
+
+        uint32_t frequency = 0;
+        if (index >= 0) {
+            // 음 번호(옥타브 * 12 + 음)로 바꾼 뒤 다시 나눠야 b#의 올림이 옥타브에 반영됨
+            uint32_t number = octave * 12 + (uint32_t)index;
+            octave = number / 12;
+            index = (int)(number % 12);
+            if (octave > 8) {  // 표보다 높은 음(b#8)은 옥타브 8로 제한
+                octave = 8;
+            }
+            uint32_t shift = (octave < 8) ? 8 - octave : 0;
+            frequency = shift ? (rtttl_octave8[index] + (1u << (shift - 1))) >> shift : rtttl_octave8[index];
+        }
+
+        // 같은 음이 이어질 때 구분되도록 길이의 1/16을 쉼으로 사용
+        notes[count].frequency = (uint16_t)frequency;
+        notes[count].duration_ms = (uint16_t)(ms - ms / 16);
+        notes[count].gap_ms = (uint16_t)(ms / 16);
+        count++;
+    }
+    return count;
 }
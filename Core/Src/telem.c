@@ -0,0 +1,318 @@
+/*
+ * telem.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 등록한 변수들을 일정 주기로 묶어서 PC로 보내는 바이너리 텔레메트리
+ *   - 타이머 인터럽트에서 변수 값을 레코드 하나로 복사 (더블 버퍼: 메인 루프가 보내는 중인 버퍼는 건드리지 않음)
+ *   - 메인 루프(TELEM_Task)에서 U2C 바이너리 프레임으로 송신 링 버퍼에 넣으면 DMA로 전송됨
+ *   - 프레임은 0x00으로 구분되므로 같은 UART의 콘솔 출력과 섞여도 PC에서 나눠서 읽을 수 있음 (Tools/telemetry_decode.py)
+ *
+ * 레코드 (TELEM_FRAME_ID_RECORD): 순번(2) | 누적 overrun 수(2) | HAL tick(4) | 변수 값들 (등록 순서, little-endian)
+ * 변수 목록 (TELEM_FRAME_ID_SCHEMA): 주기 Hz(2) | { 형식(1) | 개수(1) | 이름 | 0x00 } 반복
+ */
+
+#include "telem.h"
+#include "usart2console.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TELEM_HEADER_BYTES 8
+#define TELEM_NAME_MAX 15    // 변수 목록에 들어가는 이름의 최대 길이 (넘으면 잘림)
+
+typedef struct {
+    const char *name;
+    const volatile uint8_t *addr;   // NULL이면 getter로 읽음
+    uint32_t (*getter)(void);
+    uint8_t type;
+    uint8_t count;
+} TELEM_Var;
+
+static const uint8_t type_size[TELEM_TYPE_COUNT] = {
+    [TELEM_U8] = 1, [TELEM_I8] = 1,
+    [TELEM_U16] = 2, [TELEM_I16] = 2,
+    [TELEM_U32] = 4, [TELEM_I32] = 4, [TELEM_F32] = 4,
+};
+
+static TIM_HandleTypeDef *telem_htim = NULL;
+static TELEM_Var vars[TELEM_MAX_VARS];
+static uint8_t var_count = 0;
+static uint16_t record_len = TELEM_HEADER_BYTES;
+static uint16_t telem_rate = 0;      // 0이면 멈춤
+static uint8_t schema_pending = 0;   // 1이면 TELEM_Task에서 변수 목록부터 보냄
+static void (*ready_hook)(void) = NULL;
+
+// 더블 버퍼 (생산자: 타이머 인터럽트, 소비자: TELEM_Task)
+// 인터럽트는 메인 루프가 보내는 중인 버퍼(reading_idx)가 아닌 쪽에 쓰고, 보내기 전이던 레코드는 새 레코드로 덮어씀
+static uint8_t records[2][TELEM_RECORD_MAX];
+static volatile uint8_t ready = 0;        // 보낼 레코드가 있음
+static volatile uint8_t ready_idx = 0;
+static volatile uint8_t reading = 0;      // TELEM_Task가 records[reading_idx]를 보내는 중
+static volatile uint8_t reading_idx = 0;
+
+static TELEM_Stats stats;
+
+
+static HAL_StatusTypeDef TELEM_Add(const char *name, const volatile void *addr, uint32_t (*getter)(void),
+                                   TELEM_Type type, uint8_t count)
+{
+    if (telem_rate != 0)
+    {
+        return HAL_BUSY;
+    }
+    if (type >= TELEM_TYPE_COUNT || count == 0 || var_count >= TELEM_MAX_VARS ||
+        record_len + type_size[type] * count > TELEM_RECORD_MAX)
+    {
+        return HAL_ERROR;
+    }
+
+    TELEM_Var *v = &vars[var_count++];
+    v->name = name;
+    v->addr = (const volatile uint8_t *)addr;
+    v->getter = getter;
+    v->type = type;
+    v->count = count;
+    record_len += type_size[type] * count;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef TELEM_Register(const char *name, const volatile void *addr, TELEM_Type type, uint8_t count)
+{
+    if (addr == NULL)
+    {
+        return HAL_ERROR;
+    }
+    return TELEM_Add(name, addr, NULL, type, count);
+}
+
+HAL_StatusTypeDef TELEM_RegisterGetter(const char *name, uint32_t (*getter)(void), TELEM_Type type)
+{
+    if (getter == NULL)
+    {
+        return HAL_ERROR;
+    }
+    return TELEM_Add(name, NULL, getter, type, 1);
+}
+
+void TELEM_TIM_Callback(void)
+{
+    if (telem_rate == 0)
+    {
+        return;
+    }
+
+    // 보내는 중인 버퍼가 아닌 쪽에 씀 (보내기 전인 레코드가 있으면 덮어쓰므로 그 레코드는 잃음)
+    uint8_t w = reading ? 1 - reading_idx : ready_idx;
+    if (ready)
+    {
+        stats.overruns++;
+    }
+
+    uint8_t *p = records[w];
+    uint16_t seq = (uint16_t)stats.samples;
+    uint16_t overruns = (uint16_t)stats.overruns;
+    uint32_t tick = HAL_GetTick();
+    memcpy(p, &seq, 2);
+    memcpy(p + 2, &overruns, 2);
+    memcpy(p + 4, &tick, 4);
+    p += TELEM_HEADER_BYTES;
+
+    for (uint8_t i = 0; i < var_count; i++)
+    {
+        const TELEM_Var *v = &vars[i];
+        uint16_t size = type_size[v->type] * v->count;
+        if (v->addr == NULL)
+        {
+            uint32_t value = v->getter();
+            memcpy(p, &value, size);  // little-endian이므로 하위 바이트부터
+        }
+        else
+        {
+            for (uint16_t b = 0; b < size; b++)
+            {
+                p[b] = v->addr[b];
+            }
+        }
+        p += size;
+    }
+
+    stats.samples++;
+    ready_idx = w;
+    ready = 1;
+    if (ready_hook != NULL)
+    {
+        ready_hook();
+    }
+}
+
+// 변수 목록 프레임 전송 (송신 링 버퍼가 가득 차면 다음 TELEM_Task에서 다시 시도)
+static void TELEM_Send_schema(void)
+{
+    static uint8_t buf[2 + TELEM_MAX_VARS * (2 + TELEM_NAME_MAX + 1)];
+    uint16_t len = 0;
+
+    memcpy(buf, &telem_rate, 2);
+    len = 2;
+    for (uint8_t i = 0; i < var_count; i++)
+    {
+        buf[len++] = vars[i].type;
+        buf[len++] = vars[i].count;
+        for (uint8_t c = 0; c < TELEM_NAME_MAX && vars[i].name[c] != '\0'; c++)
+        {
+            buf[len++] = (uint8_t)vars[i].name[c];
+        }
+        buf[len++] = 0x00;
+    }
+
+    if (U2C_send_frame(TELEM_FRAME_ID_SCHEMA, buf, len) == HAL_OK)
+    {
+        schema_pending = 0;
+    }
+}
+
+void TELEM_Task(void)
+{
+    if (schema_pending)
+    {
+        TELEM_Send_schema();
+        if (schema_pending)
+        {
+            return;
+        }
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!ready)
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+    ready = 0;
+    reading = 1;
+    reading_idx = ready_idx;
+    __set_PRIMASK(primask);
+
+    // 프레임으로 인코딩해서 링 버퍼에 복사하는 동안에는 인터럽트가 다른 버퍼에 씀
+    HAL_StatusTypeDef status = U2C_send_frame(TELEM_FRAME_ID_RECORD, records[reading_idx], record_len);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    reading = 0;
+    if (status == HAL_OK)
+    {
+        stats.sent++;
+    }
+    else
+    {
+        stats.tx_busy++;
+        if (ready)
+        {
+            // 그사이 새 레코드가 만들어졌으면 보내지 못한 레코드는 버림
+            stats.overruns++;
+        }
+        else
+        {
+            // 다음 호출에서 다시 시도
+            ready_idx = reading_idx;
+            ready = 1;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+HAL_StatusTypeDef TELEM_Start(uint16_t rate_hz)
+{
+    if (telem_htim == NULL || rate_hz == 0 || rate_hz > 10000)
+    {
+        return HAL_ERROR;
+    }
+
+    // 1MHz 카운트 기준 주기가 ARR에 들어가야 함 (16비트 타이머면 16Hz 이상)
+    uint32_t period = 1000000 / rate_hz - 1;
+    if (period > 0xFFFF && !IS_TIM_32B_COUNTER_INSTANCE(telem_htim->Instance))
+    {
+        return HAL_ERROR;
+    }
+
+    HAL_TIM_Base_Stop_IT(telem_htim);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    telem_rate = rate_hz;
+    ready = 0;
+    stats = (TELEM_Stats){0};
+    __set_PRIMASK(primask);
+    schema_pending = 1;
+
+    __HAL_TIM_SET_AUTORELOAD(telem_htim, period);
+    __HAL_TIM_SET_COUNTER(telem_htim, 0);
+    __HAL_TIM_CLEAR_FLAG(telem_htim, TIM_FLAG_UPDATE);
+    HAL_TIM_Base_Start_IT(telem_htim);
+    return HAL_OK;
+}
+
+void TELEM_Stop(void)
+{
+    if (telem_htim != NULL)
+    {
+        HAL_TIM_Base_Stop_IT(telem_htim);
+    }
+    telem_rate = 0;
+}
+
+void TELEM_SetReadyHook(void (*hook)(void))
+{
+    ready_hook = hook;
+}
+
+void TELEM_GetStats(TELEM_Stats *out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+// 콘솔 커맨드: telem start <hz> | telem stop | telem schema | telem stats
+static void TELEM_Command(int argc, char *argv[])
+{
+    if (argc == 3 && strcmp(argv[1], "start") == 0)
+    {
+        if (TELEM_Start((uint16_t)strtoul(argv[2], NULL, 10)) != HAL_OK)
+        {
+            U2C_printf("telem: rate must be 1~10000 Hz (16~10000 Hz on a 16-bit timer)" NEWLINE_CHARACTER);
+        }
+    }
+    else if (argc == 2 && strcmp(argv[1], "stop") == 0)
+    {
+        TELEM_Stop();
+    }
+    else if (argc == 2 && strcmp(argv[1], "schema") == 0)
+    {
+        schema_pending = 1;
+        TELEM_Task();
+    }
+    else if (argc == 2 && strcmp(argv[1], "stats") == 0)
+    {
+        TELEM_Stats s;
+        TELEM_GetStats(&s);
+        U2C_printf("rate %u Hz, record %u bytes, samples %lu, sent %lu, overruns %lu, tx busy %lu" NEWLINE_CHARACTER,
+                   telem_rate, record_len,
+                   (unsigned long)s.samples, (unsigned long)s.sent,
+                   (unsigned long)s.overruns, (unsigned long)s.tx_busy);
+    }
+    else
+    {
+        U2C_printf("usage: telem start <hz>|stop|schema|stats" NEWLINE_CHARACTER);
+    }
+}
+
+void TELEM_Init(TIM_HandleTypeDef *htim)
+{
+    telem_htim = htim;
+    telem_rate = 0;
+    var_count = 0;
+    record_len = TELEM_HEADER_BYTES;
+    U2C_register_command("telem", TELEM_Command, "telem start <hz>|stop|schema|stats");
+}
@@ -6,21 +6,26 @@
  */
 
 #include "usart2console.h"
+#include "perf.h"
 #include <string.h>
+#include <stdarg.h>
 
 /**
  * @brief UART 수신 데이터를 임시로 저장하는 링 버퍼(Ring Buffer)입니다.
  * @note
  *   - 생산자: UART 수신 인터럽트(`U2C_RxCpltCallback`)가 데이터를 여기에 씁니다.
+ *             `U2C_RX_USE_DMA` 사용 시에는 circular DMA가 직접 여기에 씁니다.
  *   - 소비자: 메인 루프의 `U2C_process` 함수가 여기서 데이터를 읽어갑니다.
  */
 static uint8_t rx_buffer[U2C_RX_BUFFER_SIZE];
 
+#ifndef U2C_RX_USE_DMA
 /**
  * @brief 링 버퍼의 head 인덱스입니다.
  * @note 데이터가 써질 다음 위치를 가리킵니다.
  */
 static volatile uint16_t rx_head = 0;
+#endif
 
 /**
  * @brief 링 버퍼의 tail 인덱스입니다.
@@ -28,11 +33,47 @@ static volatile uint16_t rx_head = 0;
  */
 static uint16_t rx_tail = 0;
 
+#ifndef U2C_RX_USE_DMA
 /**
  * @brief HAL 라이브러리의 UART 수신 함수가 사용할 1바이트 저장 공간입니다.
  * @note 인터럽트가 발생할 때마다 수신된 1바이트 데이터가 여기에 임시로 저장됩니다.
  */
 static uint8_t rx_byte;
+#else
+/**
+ * @brief 마지막 수신 이벤트(IDLE, half-transfer, transfer-complete) 시점의 DMA 쓰기 위치입니다.
+ * @note 이벤트 사이에 들어온 바이트 수를 계산해 버퍼 넘침을 감지하는 데 사용합니다.
+ */
+static uint16_t rx_event_pos = 0;
+
+/**
+ * @brief DMA가 마지막 수신 이벤트까지 쓴 바이트 수(`rx_dma_count`)와 소비자가 읽은 바이트 수(`rx_read_count`)의 누적값입니다.
+ * @note
+ *   - 소비자는 NDTR 위치까지 읽으므로 마지막 이벤트 위치를 앞지를 수 있고, 버퍼 안의 위치만으로는 앞지른 것인지 한 바퀴 뒤처진 것인지 구분할 수 없습니다.
+ *   - 그래서 버퍼 넘침은 두 누적값의 차이로 판단합니다. (`rx_resync_count`는 `rx_resync_pos`에 해당하는 누적값)
+ */
+static uint32_t rx_dma_count = 0;
+static volatile uint32_t rx_read_count = 0;
+static volatile uint32_t rx_resync_count = 0;
+#endif
+
+/**
+ * @brief 소비자가 `rx_tail`을 `rx_resync_pos`로 옮겨야 하는지 나타내는 플래그입니다.
+ * @note `rx_tail`은 소비자만 수정하므로, 인터럽트에서 버퍼 넘침/수신 재시작을 감지하면 이 플래그로 알립니다.
+ */
+static volatile bool rx_resync = false;
+static volatile uint16_t rx_resync_pos = 0;
+
+/**
+ * @brief 입력 링 버퍼 통계입니다.
+ */
+static U2C_RxStats rx_stats;
+
+/**
+ * @brief 데이터를 수신할 때마다 인터럽트에서 호출할 함수입니다. (`U2C_set_rx_hook`, 없으면 NULL)
+ * @note 스케줄러를 사용하는 경우 여기서 콘솔 태스크를 깨우면, 다음 주기를 기다리지 않고 바로 명령어를 처리합니다.
+ */
+static void (*rx_hook)(void) = NULL;
 
 
 
@@ -48,10 +89,257 @@ static uint16_t cmd_idx = 0;
 
 
 /**
- * @brief UART가 현재 전송 중인지 여부를 나타내는 플래그입니다.
- * @note `U2C_print`가 호출될 때 `true`로 설정되고, 전송 완료 콜백(`HAL_UART_TxCpltCallback`)에서 `false`로 설정됩니다.
+ * @brief 커맨드 테이블의 한 항목입니다.
+ */
+typedef struct {
+    const char *name;            // 커맨드 이름 (공백 없는 문자열, 호출자가 계속 유지해야 함)
+    U2C_CommandHandler handler;  // 커맨드 처리 함수
+    const char *help;            // help 커맨드에서 보여줄 설명 (NULL 가능)
+} U2C_Command;
+
+static void cmd_help(int argc, char *argv[]);
+static void cmd_binmode(int argc, char *argv[]);
+static uint16_t rx_write_pos(void);
+#ifdef U2C_LOG_DEFERRED
+static void flush_log_queue(void);
+#endif
+
+/**
+ * @brief 등록된 커맨드 테이블입니다.
+ * @note
+ *   - 이름 순으로 정렬된 상태를 유지하며, `U2C_process`는 이진 탐색으로 커맨드를 찾습니다. (O(log n))
+ *   - 내장 커맨드 `help`가 미리 등록되어 있습니다.
+ */
+static U2C_Command commands[U2C_MAX_COMMANDS] = {
+    {"binmode", cmd_binmode, "Switch to binary frame mode"},
+    {"help", cmd_help, "List registered commands"},
+};
+
+/**
+ * @brief `commands`에 등록된 커맨드 수입니다.
+ */
+static uint16_t command_count = 2;
+
+/**
+ * @brief help 출력 중 다음에 출력할 커맨드 인덱스입니다.
+ * @note 커맨드가 많으면 출력이 송신 링 버퍼보다 길어질 수 있으므로,
+ *       `U2C_set_continuation`으로 등록해 링 버퍼에 공간이 생길 때마다 조금씩 이어서 출력합니다.
+ */
+static uint16_t help_idx = U2C_MAX_COMMANDS;
+
+/**
+ * @brief 커맨드가 등록한, 출력을 이어서 할 함수입니다. (NULL이면 없음)
+ * @note `U2C_process`가 호출할 때마다 링 버퍼에 공간이 있는 만큼만 출력합니다. (내장 help도 이 방식)
+ */
+static U2C_Continuation continuation = NULL;
+
+
+/**
+ * @brief 현재 콘솔 동작 모드입니다.
+ */
+static U2C_Mode mode = U2C_MODE_TEXT;
+
+/**
+ * @brief 바이너리 모드에서 정상 수신한 프레임을 넘겨받을 함수입니다.
+ */
+static U2C_FrameHandler frame_handler = NULL;
+
+/**
+ * @brief 바이너리 모드 수신 프레임의 COBS 디코딩 상태입니다.
+ * @note
+ *   - 링 버퍼에서 읽은 바이트를 하나씩 디코딩하여 바로 `cmd_buffer`에 쓰고, CRC도 함께 갱신합니다.
+ *   - 따라서 프레임이 끝났을 때 별도의 복사/재계산 없이 `cmd_buffer`를 그대로 처리 함수에 넘깁니다.
+ */
+static uint16_t frame_len = 0;        // `cmd_buffer`에 디코딩된 바이트 수
+static uint8_t frame_code = 0;        // 현재 COBS 블록의 코드 바이트
+static uint8_t frame_remaining = 0;   // 현재 COBS 블록에 남은 데이터 바이트 수
+static uint16_t frame_crc = 0xFFFF;   // 지금까지 디코딩된 바이트의 CRC (CRC까지 포함하면 0이 되어야 함)
+static bool frame_overflow = false;   // 프레임이 `cmd_buffer`보다 길었는지 여부
+
+/**
+ * @brief CRC-16/CCITT-FALSE 계산용 테이블입니다. (다항식 0x1021)
+ * @note 바이트당 테이블 조회 한 번으로 CRC를 갱신하며, const로 선언하여 Flash에 저장됩니다.
+ */
+static const uint16_t crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+/**
+ * @brief CRC16에 1바이트를 반영합니다.
+ */
+static inline uint16_t crc16_update(uint16_t crc, uint8_t data) {
+    return (uint16_t)(crc << 8) ^ crc16_table[(uint8_t)(crc >> 8) ^ data];
+}
+
+
+
+/**
+ * @brief UART 송신 데이터를 저장하는 링 버퍼입니다.
+ * @note
+ *   - 생산자: 메인 루프의 `U2C_print`/`U2C_println`이 문자열을 여기에 복사합니다.
+ *   - 소비자: DMA가 `tx_tail`부터 연속된 구간을 전송하고, 전송 완료 콜백(`U2C_TxCpltCallback`)이 다음 구간을 이어서 전송합니다.
+ *   - 호출자의 버퍼를 복사해두므로, 함수가 리턴된 후 호출자가 버퍼를 바로 재사용해도 안전합니다.
+ */
+static uint8_t tx_buffer[U2C_TX_BUFFER_SIZE];
+
+/**
+ * @brief 송신 링 버퍼의 head 인덱스입니다.
+ * @note 다음 데이터가 복사될 위치를 가리키며, 메인 루프에서만 변경됩니다.
+ */
+static volatile uint16_t tx_head = 0;
+
+/**
+ * @brief 송신 링 버퍼의 tail 인덱스입니다.
+ * @note 아직 전송이 끝나지 않은 첫 데이터의 위치를 가리키며, 전송 완료 콜백에서만 변경됩니다.
+ */
+static volatile uint16_t tx_tail = 0;
+
+/**
+ * @brief 현재 DMA로 전송 중인 구간의 길이입니다.
+ * @note 0이면 전송 중이 아니라는 뜻입니다.
+ */
+static volatile uint16_t tx_inflight = 0;
+
+/**
+ * @brief 송신 링 버퍼에 쓰는 중인 위치입니다.
+ * @note `tx_begin`~`tx_commit` 사이에서만 사용되며, `tx_commit`에서 `tx_head`로 공개됩니다.
+ */
+static uint16_t tx_write_idx = 0;
+
+/**
+ * @brief 송신 링 버퍼 통계입니다.
+ */
+static U2C_TxStats tx_stats;
+
+
+
+/**
+ * @brief 송신 링 버퍼에 현재 쌓여있는(전송 대기 + 전송 중) 바이트 수를 반환합니다.
+ */
+static uint16_t tx_used(void) {
+    return (uint16_t)((tx_head + U2C_TX_BUFFER_SIZE - tx_tail) % U2C_TX_BUFFER_SIZE);
+}
+
+/**
+ * @brief 송신 링 버퍼에 새로 쓸 수 있는 바이트 수를 반환합니다.
+ */
+static uint16_t tx_free(void) {
+    // 링 버퍼는 head == tail을 '비어있음'으로 쓰기 때문에 한 칸은 항상 비워둡니다.
+    return (U2C_TX_BUFFER_SIZE - 1) - tx_used();
+}
+
+/**
+ * @brief [ISR 또는 인터럽트 차단 상태에서 호출] 전송 중이 아니라면 링 버퍼의 다음 연속 구간을 DMA로 전송합니다.
+ * @note 링 버퍼 끝에서 wrap-around 되는 데이터는 두 번에 나눠 전송됩니다.
  */
-static volatile bool tx_busy = false;
+static void tx_start_next(void) {
+    if (tx_inflight != 0) {
+        return; // 이미 전송 중이면 전송 완료 콜백에서 이어서 전송합니다.
+    }
+
+    uint16_t head = tx_head;
+    uint16_t tail = tx_tail;
+    if (head == tail) {
+        return; // 보낼 데이터가 없습니다.
+    }
+
+    // tail부터 head까지, 또는 head가 wrap-around 되었다면 버퍼 끝까지가 한 번에 보낼 수 있는 연속 구간입니다.
+    uint16_t length = (head > tail) ? (head - tail) : (U2C_TX_BUFFER_SIZE - tail);
+
+    tx_inflight = length;
+    if (HAL_UART_Transmit_DMA(U2C_USART_CHANNEL, &tx_buffer[tail], length) != HAL_OK) {
+        // 전송을 시작하지 못했다면 데이터는 버퍼에 남겨두고, 다음 U2C_print 호출 때 다시 시도합니다.
+        tx_inflight = 0;
+    }
+}
+
+/**
+ * @brief 송신 링 버퍼에 `length` 바이트를 쓸 공간이 있는지 확인하고 쓰기를 시작합니다.
+ * @retval true: 공간 있음, false: 공간 부족 (버려진 바이트로 집계됨)
+ */
+static bool tx_begin(uint16_t length) {
+    if (length > tx_free()) {
+        tx_stats.bytes_dropped += length;
+        return false;
+    }
+    tx_write_idx = tx_head;
+    return true;
+}
+
+/**
+ * @brief `tx_begin`으로 확보한 공간에 데이터를 복사합니다.
+ */
+static void tx_put(const uint8_t *data, uint16_t length) {
+    // 버퍼 끝에서 wrap-around 되는 경우 두 번에 나눠 복사합니다.
+    uint16_t first = U2C_TX_BUFFER_SIZE - tx_write_idx;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(&tx_buffer[tx_write_idx], data, first);
+    memcpy(&tx_buffer[0], data + first, length - first);
+    tx_write_idx = (tx_write_idx + length) % U2C_TX_BUFFER_SIZE;
+}
+
+/**
+ * @brief `tx_begin`으로 확보한 공간에 1바이트를 쓰고, 쓴 위치를 반환합니다.
+ */
+static uint16_t tx_put_byte(uint8_t data) {
+    uint16_t idx = tx_write_idx;
+    tx_buffer[idx] = data;
+    tx_write_idx = (idx + 1) % U2C_TX_BUFFER_SIZE;
+    return idx;
+}
+
+/**
+ * @brief 복사한 데이터를 소비자에게 공개하고, 전송 중이 아니라면 전송을 시작합니다.
+ */
+static void tx_commit(void) {
+    tx_stats.bytes_queued += (uint16_t)((tx_write_idx + U2C_TX_BUFFER_SIZE - tx_head) % U2C_TX_BUFFER_SIZE);
+    tx_head = tx_write_idx;
+
+    uint16_t used = tx_used();
+    if (used > tx_stats.high_water) {
+        tx_stats.high_water = used;
+    }
+
+    // 전송 완료 콜백과 동시에 전송을 시작하지 않도록 잠시 인터럽트를 막습니다.
+    // (호출자가 이미 인터럽트를 막아둔 상태일 수 있으므로 이전 상태로 되돌립니다.)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tx_start_next();
+    __set_PRIMASK(primask);
+}
 
 
 
@@ -60,9 +348,22 @@ static volatile bool tx_busy = false;
  * @note 이 함수는 main 함수의 `while(1)` 루프 이전에 한 번만 호출되어야 합니다.
  */
 void U2C_init(void) {
+#ifndef U2C_RX_USE_DMA
     // HAL 라이브러리를 통해 UART 채널에서 1바이트 비동기(인터럽트 방식) 수신을 시작합니다.
     // 데이터가 1바이트 수신될 때마다 `HAL_UART_RxCpltCallback`이 호출됩니다.
     HAL_UART_Receive_IT(U2C_USART_CHANNEL, &rx_byte, 1);
+#else
+    // `rx_buffer` 전체를 circular DMA의 목적지로 지정하여 수신을 시작합니다.
+    // 바이트마다 인터럽트가 발생하지 않고, IDLE 라인/버퍼 절반/버퍼 끝에서만 `HAL_UARTEx_RxEventCallback`이 호출됩니다.
+    // DMA가 버퍼 처음부터 쓰므로 소비자도 처음부터 읽도록 합니다. (이미 수신 중이면 HAL_BUSY가 반환되고 그대로 이어집니다.)
+    if (HAL_UARTEx_ReceiveToIdle_DMA(U2C_USART_CHANNEL, rx_buffer, U2C_RX_BUFFER_SIZE) == HAL_OK) {
+        rx_event_pos = 0;
+        rx_dma_count = 0;
+        rx_resync_pos = 0;
+        rx_resync_count = 0;
+        rx_resync = true;
+    }
+#endif
 }
 
 /**
@@ -73,6 +374,7 @@ void U2C_init(void) {
  *   - 중요: 인터럽트 서비스 루틴의 일부이므로, 코드는 **최대한 빠르고 간결해야 합니다.**
  */
 void U2C_RxCpltCallback(void) {
+#ifndef U2C_RX_USE_DMA
     // 1. 링 버퍼에 데이터 저장 (핵심 로직)
 
     // head가 다음으로 이동할 위치를 계산합니다.
@@ -82,9 +384,8 @@ void U2C_RxCpltCallback(void) {
     // 다음 head 위치가 현재 tail 위치와 같은지 확인합니다.
     // 만약 같다면, 이는 링 버퍼가 꽉 찼다는 의미입니다. (소비자가 데이터를 충분히 빨리 읽어가지 못함)
     if (next_head == rx_tail) {
-        // 버퍼가 가득 찼을 때의 처리 정책을 여기에 정의할 수 있습니다.
-        // 예: 에러 카운터를 증가시키거나, 특정 LED를 켜는 등.
-        // 지금은 새로운 데이터를 버려서(무시해서) 버퍼의 내용을 보호합니다.
+        // 새로운 데이터를 버려서(무시해서) 버퍼의 내용을 보호하고, 버려진 바이트 수를 기록합니다.
+        rx_stats.bytes_dropped++;
     }
     else {
         // 버퍼에 공간이 있으므로, 수신된 바이트(`rx_byte`)를 현재 head 위치에 저장합니다.
@@ -97,6 +398,420 @@ void U2C_RxCpltCallback(void) {
 
     // 다음 1바이트를 계속 수신하기 위해 HAL 수신 인터럽트를 다시 활성화합니다.
     HAL_UART_Receive_IT(U2C_USART_CHANNEL, &rx_byte, 1);
+
+    if (rx_hook != NULL) {
+        rx_hook();
+    }
+#endif
+}
+
+/**
+ * @brief [생산자] UART 수신 이벤트 콜백 함수입니다. (`U2C_RX_USE_DMA` 사용 시)
+ * @param size `HAL_UARTEx_RxEventCallback`이 넘겨주는 값으로, 버퍼 시작부터 DMA가 쓴 바이트 수입니다.
+ * @note
+ *   - 이 함수는 `HAL_UARTEx_RxEventCallback` 함수 안에서 호출되어야 합니다.
+ *   - IDLE 라인, half-transfer, transfer-complete 시점에만 호출되므로, 데이터 자체는 DMA가 이미 `rx_buffer`에 써둔 상태입니다.
+ *   - 여기서는 마지막 이벤트 이후 들어온 바이트 수로 버퍼 넘침(읽지 않은 데이터를 DMA가 덮어씀)을 감지합니다.
+ */
+void U2C_RxEventCallback(uint16_t size) {
+#ifdef U2C_RX_USE_DMA
+    uint16_t pos = size % U2C_RX_BUFFER_SIZE;
+
+    // half-transfer/transfer-complete 이벤트가 버퍼 절반마다 발생하므로, 이벤트 사이에 들어온 바이트 수는 버퍼 절반 이하입니다.
+    uint16_t received = (uint16_t)((pos + U2C_RX_BUFFER_SIZE - rx_event_pos) % U2C_RX_BUFFER_SIZE);
+    rx_dma_count += received;
+
+    // 소비자가 아직 읽기 위치를 다시 맞추지 않았다면, 맞출 위치까지 읽은 것으로 계산합니다.
+    uint32_t unread = rx_dma_count - (rx_resync ? rx_resync_count : rx_read_count);
+
+    if (unread > U2C_RX_BUFFER_SIZE - 1) {
+        // 소비자가 읽기 전에 DMA가 데이터를 덮어썼습니다.
+        // 덮어써진 부분은 복구할 수 없으므로, 읽지 않은 바이트를 모두 버리고 소비자가 현재 위치부터 다시 읽도록 합니다.
+        rx_stats.bytes_dropped += unread;
+        rx_resync_pos = pos;
+        rx_resync_count = rx_dma_count;
+        rx_resync = true;
+    }
+
+    rx_event_pos = pos;
+
+    if (rx_hook != NULL) {
+        rx_hook();
+    }
+#else
+    (void)size;
+#endif
+}
+
+/**
+ * @brief UART 에러 콜백 함수입니다.
+ * @note
+ *   - 이 함수는 `HAL_UART_ErrorCallback` 함수 안에서 호출되어야 합니다.
+ *   - overrun 등의 에러가 발생하면 HAL이 수신을 중단하므로, 에러를 기록하고 수신을 다시 시작합니다.
+ *   - framing/noise/parity 에러처럼 HAL이 수신을 멈추지 않은 경우(`RxState`가 여전히 BUSY_RX)에는 다시 시작하지 않습니다.
+ */
+void U2C_ErrorCallback(void) {
+    rx_stats.errors++;
+
+#ifndef U2C_RX_USE_DMA
+    // 수신이 계속 중이면 HAL_BUSY가 반환되므로 그대로 둡니다.
+    HAL_UART_Receive_IT(U2C_USART_CHANNEL, &rx_byte, 1);
+#else
+    if ((U2C_USART_CHANNEL)->RxState == HAL_UART_STATE_BUSY_RX) {
+        // circular DMA는 계속 돌고 있으므로 NDTR의 쓰기 위치도 그대로입니다.
+        // 에러가 난 바이트가 섞인 입력은 버리고, 소비자가 현재 쓰기 위치부터 읽도록 합니다.
+        uint16_t pos = rx_write_pos();
+        rx_dma_count += (uint16_t)((pos + U2C_RX_BUFFER_SIZE - rx_event_pos) % U2C_RX_BUFFER_SIZE);
+        rx_event_pos = pos;
+        rx_resync_pos = pos;
+        rx_resync_count = rx_dma_count;
+        rx_resync = true;
+    }
+    else {
+        // overrun/DMA 에러로 HAL이 수신을 중단했습니다. DMA 수신을 버퍼 처음부터 다시 시작합니다.
+        U2C_init();
+    }
+#endif
+}
+
+/**
+ * @brief 생산자가 다음 데이터를 쓸 위치를 반환합니다.
+ * @note `U2C_RX_USE_DMA` 사용 시에는 DMA의 남은 전송 횟수(NDTR)로 현재 쓰기 위치를 계산합니다.
+ */
+static uint16_t rx_write_pos(void) {
+#ifndef U2C_RX_USE_DMA
+    return rx_head;
+#else
+    return (uint16_t)((U2C_RX_BUFFER_SIZE - __HAL_DMA_GET_COUNTER((U2C_USART_CHANNEL)->hdmarx)) % U2C_RX_BUFFER_SIZE);
+#endif
+}
+
+
+/**
+ * @brief 커맨드를 등록합니다.
+ * @param name 커맨드 이름 (공백 없는 문자열). 포인터만 저장하므로 문자열 리터럴처럼 계속 유지되는 문자열이어야 합니다.
+ * @param handler 커맨드가 입력되었을 때 호출될 함수
+ * @param help help 커맨드에서 보여줄 설명 (NULL 가능)
+ * @retval HAL_OK: 등록 성공, HAL_ERROR: 테이블이 가득 찼거나 같은 이름이 이미 등록됨
+ * @note 테이블을 이름 순으로 정렬된 상태로 유지하기 위해 삽입 위치를 찾아 뒤 항목들을 한 칸씩 밉니다.
+ */
+HAL_StatusTypeDef U2C_register_command(const char *name, U2C_CommandHandler handler, const char *help) {
+    if (name == NULL || handler == NULL || command_count >= U2C_MAX_COMMANDS) {
+        return HAL_ERROR;
+    }
+
+    // 이진 탐색으로 삽입 위치를 찾습니다.
+    uint16_t lo = 0;
+    uint16_t hi = command_count;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        int cmp = strcmp(name, commands[mid].name);
+        if (cmp == 0) {
+            return HAL_ERROR; // 같은 이름의 커맨드가 이미 있습니다.
+        }
+        if (cmp < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+
+    memmove(&commands[lo + 1], &commands[lo], (command_count - lo) * sizeof(U2C_Command));
+    commands[lo].name = name;
+    commands[lo].handler = handler;
+    commands[lo].help = help;
+    command_count++;
+    return HAL_OK;
+}
+
+/**
+ * @brief 이름으로 커맨드를 찾습니다. (이진 탐색)
+ * @retval 찾은 커맨드 항목, 없으면 NULL
+ */
+static const U2C_Command *find_command(const char *name) {
+    uint16_t lo = 0;
+    uint16_t hi = command_count;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        int cmp = strcmp(name, commands[mid].name);
+        if (cmp == 0) {
+            return &commands[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief `cmd_buffer`에 완성된 한 줄을 토큰으로 나누고, 해당 커맨드를 실행합니다.
+ * @note 복사 없이 `cmd_buffer` 안의 공백을 '\0'으로 바꿔 토큰을 나누고, `argv`는 `cmd_buffer` 안을 가리킵니다.
+ */
+static void dispatch_command(void) {
+    char *argv[U2C_MAX_ARGS];
+    int argc = 0;
+    char *p = (char*) cmd_buffer;
+
+    // 문자열 끝 표시 (`cmd_idx`는 항상 U2C_RX_BUFFER_SIZE - 1 보다 작습니다.)
+    cmd_buffer[cmd_idx] = '\0';
+
+    while (*p != '\0') {
+        // 토큰 앞의 공백을 건너뜁니다.
+        while (*p == ' ') {
+            *p++ = '\0';
+        }
+        if (*p == '\0') {
+            break;
+        }
+
+        if (argc == U2C_MAX_ARGS) {
+            U2C_println((uint8_t*)"Too many arguments", 18);
+            return;
+        }
+        argv[argc++] = p;
+
+        // 토큰 끝까지 이동합니다.
+        while (*p != '\0' && *p != ' ') {
+            p++;
+        }
+    }
+
+    if (argc == 0) {
+        return; // 공백만 입력되었습니다.
+    }
+
+    const U2C_Command *cmd = find_command(argv[0]);
+    if (cmd == NULL) {
+        U2C_print((uint8_t*)"Unknown command: ", 17);
+        U2C_println((uint8_t*) argv[0], strlen(argv[0]));
+        return;
+    }
+
+    cmd->handler(argc, argv);
+}
+
+/**
+ * @brief help 출력: 송신 링 버퍼에 공간이 있는 만큼 커맨드 설명을 이어서 출력합니다.
+ * @note 한 줄이 통째로 들어갈 공간이 없으면 다음 `U2C_process` 호출 때 다시 시도하므로, 출력이 잘리거나 메인 루프가 멈추지 않습니다.
+ * @retval true 목록을 끝까지 출력함
+ */
+static bool help_continuation(void) {
+    const uint16_t newline_length = sizeof(NEWLINE_CHARACTER) - 1;
+
+    while (help_idx < command_count) {
+        const U2C_Command *cmd = &commands[help_idx];
+        uint16_t name_length = strlen(cmd->name);
+        uint16_t help_length = (cmd->help != NULL) ? strlen(cmd->help) : 0;
+        uint16_t line_length = name_length + newline_length + ((help_length > 0) ? 3 + help_length : 0);
+
+        if (line_length > tx_free()) {
+            return false; // 링 버퍼에 공간이 생기면 이어서 출력합니다.
+        }
+
+        tx_begin(line_length);
+        tx_put((const uint8_t*) cmd->name, name_length);
+        if (help_length > 0) {
+            tx_put((const uint8_t*)" - ", 3);
+            tx_put((const uint8_t*) cmd->help, help_length);
+        }
+        tx_put((const uint8_t*) NEWLINE_CHARACTER, newline_length);
+        tx_commit();
+
+        help_idx++;
+    }
+    return true;
+}
+
+/**
+ * @brief 내장 커맨드 `help`: 등록된 커맨드 목록을 출력합니다.
+ */
+static void cmd_help(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // 다른 커맨드의 긴 출력(perf show 등)이 진행 중이면 섞이지 않도록 시작하지 않습니다.
+    if (U2C_set_continuation(help_continuation) != HAL_OK) {
+        U2C_printf("help: busy" NEWLINE_CHARACTER);
+        return;
+    }
+    help_idx = 0;
+    if (help_continuation()) {
+        U2C_set_continuation(NULL);
+    }
+}
+
+
+/**
+ * @brief 내장 커맨드 `binmode`: 바이너리 프레임 모드로 전환합니다.
+ * @note 텍스트 모드로 돌아오려면 msg_id가 `U2C_FRAME_ID_TEXT_MODE`인 프레임을 보냅니다.
+ */
+static void cmd_binmode(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    U2C_set_mode(U2C_MODE_BINARY);
+}
+
+/**
+ * @brief 수신 프레임 디코딩 상태를 초기화합니다.
+ */
+static void frame_reset(void) {
+    frame_len = 0;
+    frame_code = 0;
+    frame_remaining = 0;
+    frame_crc = 0xFFFF;
+    frame_overflow = false;
+}
+
+/**
+ * @brief 디코딩된 1바이트를 `cmd_buffer`에 쓰고 CRC를 갱신합니다.
+ */
+static void frame_emit(uint8_t data) {
+    if (frame_len >= U2C_RX_BUFFER_SIZE) {
+        frame_overflow = true;
+        return;
+    }
+    cmd_buffer[frame_len++] = data;
+    frame_crc = crc16_update(frame_crc, data);
+}
+
+/**
+ * @brief 바이너리 모드에서 수신한 1바이트를 COBS 디코딩합니다.
+ * @note 0x00을 받으면 프레임이 끝난 것으로 보고, CRC가 맞으면 프레임 처리 함수를 호출합니다.
+ */
+static void frame_rx_byte(uint8_t c) {
+    if (c == 0x00) {
+        // 프레임 구분자. 빈 프레임(연속된 구분자)은 무시합니다.
+        if (frame_len > 0 || frame_code != 0) {
+            // CRC까지 포함해 계산한 CRC가 0이면 데이터가 온전합니다.
+            if (frame_overflow || frame_remaining != 0 || frame_len < 3 || frame_crc != 0) {
+                rx_stats.frame_errors++;
+            }
+            else {
+                rx_stats.frames++;
+                uint8_t msg_id = cmd_buffer[0];
+                if (msg_id == U2C_FRAME_ID_TEXT_MODE) {
+                    U2C_set_mode(U2C_MODE_TEXT);
+                }
+                else if (frame_handler != NULL) {
+                    frame_handler(msg_id, &cmd_buffer[1], frame_len - 3);
+                }
+            }
+        }
+        frame_reset();
+        return;
+    }
+
+    if (frame_remaining == 0) {
+        // 새 COBS 블록의 코드 바이트입니다.
+        // 이전 블록이 0xFF(254바이트 꽉 찬 블록)가 아니었다면, 블록 사이에 원래 0x00이 있었던 것입니다.
+        if (frame_code != 0 && frame_code != 0xFF) {
+            frame_emit(0x00);
+        }
+        frame_code = c;
+        frame_remaining = c - 1;
+    }
+    else {
+        frame_emit(c);
+        frame_remaining--;
+    }
+}
+
+/**
+ * @brief 콘솔 동작 모드를 변경합니다.
+ * @param new_mode `U2C_MODE_TEXT` 또는 `U2C_MODE_BINARY`
+ * @note 입력 중이던 명령어/프레임은 버려집니다.
+ */
+void U2C_set_mode(U2C_Mode new_mode) {
+    mode = new_mode;
+    cmd_idx = 0;
+    frame_reset();
+}
+
+/**
+ * @brief 현재 콘솔 동작 모드를 반환합니다.
+ */
+U2C_Mode U2C_get_mode(void) {
+    return mode;
+}
+
+/**
+ * @brief 바이너리 모드에서 정상 수신한 프레임을 넘겨받을 함수를 등록합니다.
+ */
+void U2C_register_frame_handler(U2C_FrameHandler handler) {
+    frame_handler = handler;
+}
+
+/**
+ * @brief 바이너리 프레임을 전송합니다. (비동기 방식)
+ * @param msg_id 메시지 ID
+ * @param payload payload 포인터 (`length`가 0이면 NULL 가능)
+ * @param length payload 길이
+ * @note
+ *   - 별도의 인코딩 버퍼 없이 송신 링 버퍼에 바로 COBS 인코딩하며, 모드와 관계없이 사용할 수 있습니다.
+ *   - 프레임 앞뒤에 0x00 구분자를 붙이므로, 텍스트 출력 사이에 섞여도 수신측에서 프레임을 구분할 수 있습니다.
+ *   - 링 버퍼에 공간이 부족하면 프레임 전체를 버리고 `HAL_BUSY`를 반환합니다.
+ */
+HAL_StatusTypeDef U2C_send_frame(uint8_t msg_id, const uint8_t *payload, uint16_t length) {
+    // 인코딩 전 길이: msg_id + payload + CRC16
+    uint16_t raw_length = 1 + length + 2;
+    // COBS 최대 길이(254바이트마다 코드 바이트 1개 추가) + 앞뒤 구분자
+    uint16_t max_length = raw_length + raw_length / 254 + 1 + 2;
+
+    if (!tx_begin(max_length)) {
+        return HAL_BUSY;
+    }
+
+    uint16_t crc = crc16_update(0xFFFF, msg_id);
+    for (uint16_t i = 0; i < length; i++) {
+        crc = crc16_update(crc, payload[i]);
+    }
+
+    tx_put_byte(0x00);
+    uint16_t code_idx = tx_put_byte(0); // 블록이 끝나면 채울 코드 바이트 자리
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < raw_length; i++) {
+        uint8_t data;
+        if (i == 0) {
+            data = msg_id;
+        }
+        else if (i <= length) {
+            data = payload[i - 1];
+        }
+        else if (i == length + 1) {
+            data = (uint8_t)(crc >> 8);
+        }
+        else {
+            data = (uint8_t)crc;
+        }
+
+        if (data == 0x00) {
+            // 0x00은 블록의 끝으로 표현합니다.
+            tx_buffer[code_idx] = code;
+            code_idx = tx_put_byte(0);
+            code = 1;
+        }
+        else {
+            tx_put_byte(data);
+            code++;
+            if (code == 0xFF) {
+                // 254바이트가 꽉 찬 블록은 0x00 없이 끝냅니다.
+                tx_buffer[code_idx] = code;
+                code_idx = tx_put_byte(0);
+                code = 1;
+            }
+        }
+    }
+    tx_buffer[code_idx] = code;
+    tx_put_byte(0x00);
+
+    tx_commit();
+    return HAL_OK;
 }
 
 
@@ -107,10 +822,37 @@ void U2C_RxCpltCallback(void) {
  *   - 역할: 링 버퍼에 쌓인 데이터를 읽어가서, 한 줄의 명령어로 만들고 처리하는 '소비자'의 역할을 합니다.
  */
 void U2C_process(void) {
+    PERF_BEGIN(PERF_U2C_PROCESS);
+
+    // 0. 인터럽트에서 버퍼 넘침/수신 재시작을 알렸다면 읽기 위치를 다시 맞춥니다.
+    if (rx_resync) {
+        rx_resync = false;
+        rx_tail = rx_resync_pos;
+#ifdef U2C_RX_USE_DMA
+        rx_read_count = rx_resync_count;
+#endif
+        cmd_idx = 0; // 중간이 유실된 명령어/프레임은 버립니다.
+        frame_reset();
+    }
+
+    // 커맨드가 등록한 출력이 남아있으면 이어서 출력합니다.
+    if (continuation != NULL && continuation()) {
+        continuation = NULL;
+    }
+
+#ifdef U2C_LOG_DEFERRED
+    // 포맷을 기다리는 로그가 있으면 남는 시간에 포맷합니다.
+    flush_log_queue();
+#endif
+
     // 1. 링 버퍼에 처리할 데이터가 있는지 확인
 
-    // head와 tail이 같지 않다는 것은, 생산자(인터럽트)가 버퍼에 써놓은 데이터가 있다는 의미입니다.
-    while (rx_head != rx_tail) {
+    // head와 tail이 같지 않다는 것은, 생산자(인터럽트 또는 DMA)가 버퍼에 써놓은 데이터가 있다는 의미입니다.
+    uint16_t head = rx_write_pos();
+#ifdef U2C_RX_USE_DMA
+    uint16_t count = (uint16_t)((head + U2C_RX_BUFFER_SIZE - rx_tail) % U2C_RX_BUFFER_SIZE);
+#endif
+    while (head != rx_tail) {
 
         // 2. 링 버퍼에서 데이터 1바이트 읽기
 
@@ -119,6 +861,12 @@ void U2C_process(void) {
         // tail 인덱스를 다음 위치로 업데이트합니다. (wrap-around 처리 포함)
         rx_tail = (rx_tail + 1) % U2C_RX_BUFFER_SIZE;
 
+        // 바이너리 모드에서는 에코나 줄 편집 없이 프레임 디코딩만 합니다.
+        if (mode == U2C_MODE_BINARY) {
+            frame_rx_byte(c);
+            continue;
+        }
+
 
         // 3. 읽어온 문자 종류에 따라 커맨드 라인 편집
 
@@ -138,13 +886,8 @@ void U2C_process(void) {
                 // 터미널에 줄바꿈 문자를 보내 커서를 다음 줄로 내립니다.
                 U2C_print((uint8_t*) NEWLINE_CHARACTER, strlen(NEWLINE_CHARACTER));
 
-                // --- 커맨드 처리 로직 ---
-                // 여기서는 간단히 수신된 명령어를 "CMD: "와 함께 다시 출력합니다.
-                // 실제 애플리케이션에서는 이 부분에서 `strcmp` 등으로 명령어를 비교하여
-                // 특정 동작(예: LED 켜기/끄기)을 수행하는 코드가 들어갑니다.
-                U2C_print((uint8_t*)"CMD: ", 5);
-                U2C_println(cmd_buffer, cmd_idx);
-                // --- 커맨드 처리 로직 끝 ---
+                // `U2C_register_command`로 등록된 커맨드 중 이름이 일치하는 커맨드를 실행합니다.
+                dispatch_command();
 
                 // 다음 명령어를 수신하기 위해 커맨드 버퍼 인덱스를 0으로 리셋합니다.
                 cmd_idx = 0;
@@ -160,7 +903,14 @@ void U2C_process(void) {
                 cmd_buffer[cmd_idx++] = c;
             }
         }
-    } // while (rx_head != rx_tail)
+    } // while (head != rx_tail)
+
+#ifdef U2C_RX_USE_DMA
+    // 다 읽은 뒤에 더해야, 읽는 도중에 DMA가 덮어쓴 경우도 이벤트 콜백이 넘침으로 판단합니다.
+    rx_read_count += count;
+#endif
+
+    PERF_END(PERF_U2C_PROCESS);
 }
 
 
@@ -168,53 +918,486 @@ void U2C_process(void) {
  * @brief U2C 콘솔에 문자열을 출력합니다. (비동기 방식)
  * @param pString 출력할 문자열 포인터
  * @param length 출력할 문자열 길이
+ * @note
+ *   - 문자열을 송신 링 버퍼에 복사한 뒤 바로 리턴하며, 전송이 끝날 때까지 기다리지 않습니다.
+ *   - 링 버퍼에 공간이 부족하면 문자열 전체를 버리고 `HAL_BUSY`를 반환합니다. (일부만 출력되지 않음)
+ *   - 메인 루프에서만 호출해야 합니다. (인터럽트에서 호출 금지)
  */
 HAL_StatusTypeDef U2C_print(uint8_t *pString, uint16_t length) {
-    // 전송이 이미 진행 중인지 확인합니다.
-    // 만약 busy 상태이면, U2C_TX_TIMEOUT_MS 만큼 기다립니다.
-    uint32_t tickstart = HAL_GetTick();
-    while (tx_busy) {
-        if ((HAL_GetTick() - tickstart) > U2C_TX_TIMEOUT_MS) {
-            return HAL_BUSY; // 타임아웃 시간이 지나도 busy 상태이면 에러를 반환합니다.
-        }
+    if (!tx_begin(length)) {
+        return HAL_BUSY;
     }
 
-    tx_busy = true; // 전송 시작을 알리기 위해 플래그를 true로 설정합니다.
-    // HAL 라이브러리를 통해 비동기(인터럽트 방식) UART 전송을 시작합니다.
-    return HAL_UART_Transmit_IT(U2C_USART_CHANNEL, pString, length);
+    tx_put(pString, length);
+    tx_commit();
+    return HAL_OK;
 }
 
 /**
  * @brief U2C 콘솔에 문자열을 출력하고, 자동으로 줄바꿈 문자를 추가합니다.
  * @param pString 출력할 문자열 포인터
  * @param length 출력할 문자열 길이
+ * @note 문자열과 줄바꿈 문자는 한 번에 링 버퍼에 들어가므로, 줄바꿈만 빠지는 일은 없습니다.
  */
 HAL_StatusTypeDef U2C_println(uint8_t *pString, uint16_t length) {
-    // 'static' 키워드를 사용하여 버퍼를 선언합니다.
-    // 이 버퍼는 함수가 리턴되어도 파괴되지 않고 메모리에 계속 남아있습니다.
-    // 따라서 비동기 전송(IT/DMA)이 완료될 때까지 데이터가 안전하게 보존됩니다.
-    static uint8_t println_buffer[U2C_TX_BUFFER_SIZE];
+    const uint16_t newline_length = sizeof(NEWLINE_CHARACTER) - 1;
+
+    if (!tx_begin(length + newline_length)) {
+        return HAL_BUSY;
+    }
+
+    tx_put(pString, length);
+    tx_put((const uint8_t*) NEWLINE_CHARACTER, newline_length);
+    tx_commit();
+    return HAL_OK;
+}
+
+/**
+ * @brief 포맷 문자열의 변환 지정자(`%...`) 하나를 해석한 결과입니다.
+ */
+typedef struct {
+    char conversion;    // 변환 문자 (d, i, u, x, X, c, s, q, %), 지원하지 않으면 '\0'
+    bool left_align;    // '-' 플래그
+    bool zero_pad;      // '0' 플래그
+    bool is_long;       // 'l' 길이 지정자
+    uint8_t width;      // 최소 출력 폭
+    int8_t precision;   // '.' 뒤의 숫자 (없으면 -1), %q에서는 소수점 아래 자릿수, %s에서는 최대 출력 길이
+} U2C_FormatSpec;
+
+/**
+ * @brief `%` 바로 뒤부터 변환 지정자 하나를 해석합니다.
+ * @retval 변환 지정자 다음 문자 위치
+ */
+static const char *parse_format_spec(const char *p, U2C_FormatSpec *spec) {
+    spec->left_align = false;
+    spec->zero_pad = false;
+    spec->is_long = false;
+    spec->width = 0;
+    spec->precision = -1;
 
-    if (length + 2 > U2C_TX_BUFFER_SIZE) {
-        return HAL_ERROR; // 합쳐진 문자열이 버퍼보다 깁니다.
+    for (;; p++) {
+        if (*p == '-') {
+            spec->left_align = true;
+        }
+        else if (*p == '0') {
+            spec->zero_pad = true;
+        }
+        else {
+            break;
+        }
+    }
+    while (*p >= '0' && *p <= '9') {
+        spec->width = spec->width * 10 + (*p++ - '0');
+    }
+    if (*p == '.') {
+        p++;
+        spec->precision = 0;
+        while (*p >= '0' && *p <= '9') {
+            spec->precision = spec->precision * 10 + (*p++ - '0');
+        }
+    }
+    while (*p == 'l') {
+        spec->is_long = true;
+        p++;
     }
 
-    // static 버퍼에 최종 문자열(원본 + \r\n)을 만듭니다.
-    memcpy(println_buffer, pString, length);
-    println_buffer[length] = '\r';
-    println_buffer[length+1] = '\n';
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'x': case 'X':
+        case 'c': case 's': case 'q': case '%':
+            spec->conversion = *p++;
+            break;
+        default:
+            spec->conversion = '\0';
+            break;
+    }
+    return p;
+}
 
-    // U2C_print 함수를 호출합니다.
-    // 이제 전송이 시작된 후 이 함수가 리턴되어도, println_buffer는 메모리에 안전하게 남아있습니다.
-    return U2C_print(println_buffer, length + 2);
+/**
+ * @brief 가변 인자를 포맷 문자열 순서대로 `args` 배열에 옮겨 담습니다.
+ * @retval 옮겨 담은 인자 수
+ * @note 즉시 출력(`U2C_printf`)과 지연 출력(`U2C_logf`)이 같은 포맷 함수를 쓰도록 인자를 배열로 통일합니다.
+ *       실제 문자열 변환은 하지 않고 인자의 타입만 확인하므로 가볍습니다.
+ */
+static uint8_t capture_format_args(const char *format, va_list ap, uintptr_t *args) {
+    uint8_t argc = 0;
+    U2C_FormatSpec spec;
+
+    while (*format != '\0' && argc < U2C_PRINTF_MAX_ARGS) {
+        if (*format++ != '%') {
+            continue;
+        }
+        format = parse_format_spec(format, &spec);
+
+        switch (spec.conversion) {
+            case 's':
+                args[argc++] = (uintptr_t) va_arg(ap, const char*);
+                break;
+            case 'd': case 'i': case 'c': case 'q':
+                args[argc++] = spec.is_long ? (uintptr_t)(intptr_t) va_arg(ap, long) : (uintptr_t)(intptr_t) va_arg(ap, int);
+                break;
+            case 'u': case 'x': case 'X':
+                args[argc++] = spec.is_long ? (uintptr_t) va_arg(ap, unsigned long) : (uintptr_t) va_arg(ap, unsigned int);
+                break;
+            default:
+                break;
+        }
+    }
+    return argc;
+}
+
+/**
+ * @brief 포맷 중인 메시지 하나의 상태입니다.
+ * @note 메시지 전체 길이를 미리 알 수 없으므로, 공간을 넘어서면 길이만 세고 쓰지는 않습니다.
+ */
+typedef struct {
+    uint16_t room;      // 송신 링 버퍼에 쓸 수 있는 바이트 수
+    uint16_t length;    // 지금까지 만든 바이트 수 (room을 넘을 수 있음)
+} U2C_FormatContext;
+
+/**
+ * @brief 포맷 결과 1바이트를 송신 링 버퍼에 씁니다.
+ */
+static void format_putc(U2C_FormatContext *ctx, char c) {
+    if (ctx->length < ctx->room) {
+        tx_put_byte((uint8_t)c);
+    }
+    ctx->length++;
+}
+
+/**
+ * @brief 부호와 숫자 문자열을 폭/정렬 옵션에 맞춰 출력합니다.
+ */
+static void format_padded(U2C_FormatContext *ctx, const U2C_FormatSpec *spec, char sign, const char *digits, uint8_t length) {
+    uint8_t total = length + (sign != '\0');
+    uint8_t pad = (spec->width > total) ? (spec->width - total) : 0;
+
+    if (!spec->left_align && !spec->zero_pad) {
+        while (pad > 0) { format_putc(ctx, ' '); pad--; }
+    }
+    if (sign != '\0') {
+        format_putc(ctx, sign);
+    }
+    if (!spec->left_align && spec->zero_pad) {
+        while (pad > 0) { format_putc(ctx, '0'); pad--; }
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        format_putc(ctx, digits[i]);
+    }
+    while (pad > 0) { format_putc(ctx, ' '); pad--; }
+}
+
+/**
+ * @brief 부호 없는 정수를 문자열로 바꿉니다.
+ * @param buf 최소 11바이트 (32비트 10진수 최대 10자리)
+ * @param min_digits 최소 자릿수 (앞을 0으로 채움)
+ * @retval 문자열 길이
+ */
+static uint8_t format_unsigned(char *buf, uint32_t value, uint8_t base, bool upper, uint8_t min_digits) {
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[11];
+    uint8_t n = 0;
+
+    do {
+        tmp[n++] = hex[value % base];
+        value /= base;
+    } while (value != 0 && n < sizeof(tmp));
+    while (n < min_digits && n < sizeof(tmp)) {
+        tmp[n++] = '0';
+    }
+
+    // 거꾸로 만들어진 숫자를 뒤집습니다.
+    for (uint8_t i = 0; i < n; i++) {
+        buf[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+/**
+ * @brief 포맷 문자열과 인자 배열로 메시지를 만들어 송신 링 버퍼에 씁니다.
+ * @param ctx 만든 메시지 길이를 돌려받을 상태 (공간 부족으로 실패했을 때 버려진 바이트 수 집계용)
+ * @param with_prefix true면 메시지 앞에 "[tick] "을 붙입니다. (`U2C_logf`용, tick이 0이어도 붙임)
+ * @param newline true면 메시지 끝에 줄바꿈 문자를 붙입니다.
+ * @retval HAL_OK: 성공, HAL_BUSY: 링 버퍼에 공간 부족 (아무것도 쓰지 않음)
+ * @note
+ *   - 별도의 포맷 버퍼 없이 송신 링 버퍼에 바로 씁니다. 메시지가 끝까지 들어간 경우에만 공개하므로 일부만 출력되지 않습니다.
+ *   - 지원하는 변환: %d %i %u %x %X %c %s %% 와 고정소수점 %q (`%.2q`에 1234를 넘기면 "12.34")
+ *   - '-', '0' 플래그, 폭, 'l' 길이 지정자를 지원하며, 부동소수점(%f)은 지원하지 않습니다.
+ */
+static HAL_StatusTypeDef format_to_tx(U2C_FormatContext *ctx, const char *format, const uintptr_t *args, uint8_t argc,
+                                      bool with_prefix, uint32_t tick, bool newline) {
+    static const uint32_t pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    U2C_FormatSpec spec;
+    char digits[24];
+    uint8_t arg_idx = 0;
+
+    tx_begin(0);
+    ctx->room = tx_free();
+    ctx->length = 0;
+
+    if (with_prefix) {
+        U2C_FormatSpec tick_spec = {'u', false, false, false, 0, -1};
+        format_putc(ctx, '[');
+        format_padded(ctx, &tick_spec, '\0', digits, format_unsigned(digits, tick, 10, false, 1));
+        format_putc(ctx, ']');
+        format_putc(ctx, ' ');
+    }
+
+    while (*format != '\0') {
+        if (*format != '%') {
+            format_putc(ctx, *format++);
+            continue;
+        }
+        format = parse_format_spec(format + 1, &spec);
+
+        if (spec.conversion == '%') {
+            format_putc(ctx, '%');
+            continue;
+        }
+        if (spec.conversion == '\0' || arg_idx >= argc) {
+            continue; // 지원하지 않는 변환이거나 인자가 부족하면 건너뜁니다.
+        }
+        uintptr_t arg = args[arg_idx++];
+
+        switch (spec.conversion) {
+            case 'd': case 'i': {
+                int32_t value = (int32_t)(intptr_t) arg;
+                uint32_t magnitude = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+                format_padded(ctx, &spec, (value < 0) ? '-' : '\0', digits, format_unsigned(digits, magnitude, 10, false, 1));
+                break;
+            }
+            case 'u':
+                format_padded(ctx, &spec, '\0', digits, format_unsigned(digits, (uint32_t) arg, 10, false, 1));
+                break;
+            case 'x': case 'X':
+                format_padded(ctx, &spec, '\0', digits, format_unsigned(digits, (uint32_t) arg, 16, spec.conversion == 'X', 1));
+                break;
+            case 'c':
+                digits[0] = (char) arg;
+                format_padded(ctx, &spec, '\0', digits, 1);
+                break;
+            case 'q': {
+                // 고정소수점: 정수 값을 10^precision으로 나눈 값으로 출력합니다.
+                int32_t value = (int32_t)(intptr_t) arg;
+                uint32_t magnitude = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+                uint8_t decimals = (spec.precision < 0) ? 2 : (spec.precision > 9) ? 9 : (uint8_t) spec.precision;
+                uint8_t n = format_unsigned(digits, magnitude / pow10[decimals], 10, false, 1);
+                if (decimals > 0) {
+                    digits[n++] = '.';
+                    n += format_unsigned(&digits[n], magnitude % pow10[decimals], 10, false, decimals);
+                }
+                format_padded(ctx, &spec, (value < 0) ? '-' : '\0', digits, n);
+                break;
+            }
+            case 's': {
+                const char *str = (const char*) arg;
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                uint16_t length = strlen(str);
+                if (spec.precision >= 0 && length > (uint16_t) spec.precision) {
+                    length = spec.precision;
+                }
+                uint8_t pad = (spec.width > length) ? (spec.width - length) : 0;
+                if (!spec.left_align) {
+                    while (pad > 0) { format_putc(ctx, ' '); pad--; }
+                }
+                for (uint16_t i = 0; i < length; i++) {
+                    format_putc(ctx, str[i]);
+                }
+                while (pad > 0) { format_putc(ctx, ' '); pad--; }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    if (newline) {
+        for (const char *nl = NEWLINE_CHARACTER; *nl != '\0'; nl++) {
+            format_putc(ctx, *nl);
+        }
+    }
+
+    if (ctx->length > ctx->room) {
+        return HAL_BUSY; // 공개하지 않았으므로 링 버퍼에는 아무것도 추가되지 않습니다.
+    }
+    tx_commit();
+    return HAL_OK;
+}
+
+/**
+ * @brief printf 형식으로 U2C 콘솔에 출력합니다. (비동기 방식)
+ * @param format 포맷 문자열 (%d %i %u %x %X %c %s %% %q 지원, %q는 고정소수점)
+ * @note
+ *   - newlib의 printf/sprintf를 쓰지 않고, 송신 링 버퍼에 바로 포맷합니다.
+ *   - 링 버퍼에 공간이 부족하면 메시지 전체를 버리고 `HAL_BUSY`를 반환합니다.
+ *   - 메인 루프에서만 호출해야 합니다. (인터럽트에서 호출 금지)
+ */
+HAL_StatusTypeDef U2C_printf(const char *format, ...) {
+    uintptr_t args[U2C_PRINTF_MAX_ARGS];
+    va_list ap;
+
+    va_start(ap, format);
+    uint8_t argc = capture_format_args(format, ap, args);
+    va_end(ap);
+
+    U2C_FormatContext ctx;
+    HAL_StatusTypeDef status = format_to_tx(&ctx, format, args, argc, false, 0, false);
+    if (status != HAL_OK) {
+        tx_stats.bytes_dropped += ctx.length;
+    }
+    return status;
+}
+
+#ifdef U2C_LOG_DEFERRED
+/**
+ * @brief 포맷을 기다리는 `U2C_logf` 호출 하나입니다.
+ */
+typedef struct {
+    const char *format;
+    uint32_t tick;
+    uint8_t argc;
+    uintptr_t args[U2C_PRINTF_MAX_ARGS];
+} U2C_LogRecord;
+
+/**
+ * @brief 포맷 대기 큐입니다.
+ * @note
+ *   - 생산자: `U2C_logf` (메인 루프 또는 인터럽트), 소비자: `U2C_process`
+ *   - 포맷 문자열과 %s 인자는 포인터만 저장하므로, 문자열 리터럴처럼 계속 유지되는 문자열이어야 합니다.
+ */
+static U2C_LogRecord log_queue[U2C_LOG_QUEUE_SIZE];
+static volatile uint16_t log_head = 0;
+static volatile uint16_t log_tail = 0;
+
+/**
+ * @brief 포맷 대기 큐에 쌓인 로그를 송신 링 버퍼에 공간이 있는 만큼 포맷합니다.
+ */
+static void flush_log_queue(void) {
+    while (log_tail != log_head) {
+        U2C_LogRecord *record = &log_queue[log_tail];
+        U2C_FormatContext ctx;
+        if (format_to_tx(&ctx, record->format, record->args, record->argc, true, record->tick, true) != HAL_OK) {
+            if (ctx.length <= U2C_TX_BUFFER_SIZE - 1) {
+                return; // 링 버퍼가 비워지면 다음 U2C_process 호출 때 다시 시도합니다.
+            }
+            tx_stats.bytes_dropped += ctx.length; // 링 버퍼보다 긴 메시지는 버립니다.
+        }
+        log_tail = (log_tail + 1) % U2C_LOG_QUEUE_SIZE;
+    }
+}
+#endif
+
+/**
+ * @brief 앞에 "[HAL_GetTick 값] "을, 끝에 줄바꿈 문자를 붙여 printf 형식으로 출력합니다.
+ * @note
+ *   - `U2C_LOG_DEFERRED`를 정의하면 포맷 문자열 포인터와 인자만 큐에 넣고 바로 리턴하며,
+ *     실제 포맷은 `U2C_process`에서 합니다. 이 경우 인터럽트에서도 호출할 수 있고,
+ *     %s 인자는 포맷될 때까지 유지되는 문자열이어야 합니다.
+ *   - 정의하지 않으면 `U2C_printf`처럼 즉시 포맷합니다.
+ */
+HAL_StatusTypeDef U2C_logf(const char *format, ...) {
+    uint32_t tick = HAL_GetTick();
+    uintptr_t args[U2C_PRINTF_MAX_ARGS];
+    va_list ap;
+
+    va_start(ap, format);
+    uint8_t argc = capture_format_args(format, ap, args);
+    va_end(ap);
+
+#ifdef U2C_LOG_DEFERRED
+    // 메인 루프와 인터럽트가 동시에 큐에 넣을 수 있으므로 자리를 잡는 동안 인터럽트를 막습니다.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint16_t next_head = (log_head + 1) % U2C_LOG_QUEUE_SIZE;
+    if (next_head == log_tail) {
+        tx_stats.logs_dropped++;
+        __set_PRIMASK(primask);
+        return HAL_BUSY;
+    }
+    U2C_LogRecord *record = &log_queue[log_head];
+    record->format = format;
+    record->tick = tick;
+    record->argc = argc;
+    memcpy(record->args, args, argc * sizeof(uintptr_t));
+    log_head = next_head;
+    __set_PRIMASK(primask);
+    return HAL_OK;
+#else
+    U2C_FormatContext ctx;
+    HAL_StatusTypeDef status = format_to_tx(&ctx, format, args, argc, true, tick, true);
+    if (status != HAL_OK) {
+        tx_stats.bytes_dropped += ctx.length;
+    }
+    return status;
+#endif
 }
 
 /**
  * @brief UART 전송 완료 콜백 함수입니다.
  * @note
  *   - 이 함수는 `stm32f4xx_it.c` 파일의 `HAL_UART_TxCpltCallback` 함수 안에서 반드시 호출되어야 합니다.
- *   - `HAL_UART_Transmit_IT`로 시작된 데이터 전송이 완료되면 호출됩니다.
+ *   - `HAL_UART_Transmit_DMA`로 시작된 구간의 전송이 완료되면 호출되며, 링 버퍼에 남은 다음 구간을 이어서 전송합니다.
  */
 void U2C_TxCpltCallback(void) {
-    tx_busy = false; // 전송이 끝났으므로 플래그를 false로 설정하여 다른 데이터가 전송될 수 있도록 합니다.
+    // 전송이 끝난 구간만큼 tail을 이동시켜 공간을 반환합니다.
+    tx_tail = (tx_tail + tx_inflight) % U2C_TX_BUFFER_SIZE;
+    tx_inflight = 0;
+
+    tx_start_next();
+}
+
+/**
+ * @brief 출력 링 버퍼 통계를 복사해옵니다.
+ * @param stats 통계를 받을 구조체 포인터
+ */
+void U2C_get_tx_stats(U2C_TxStats *stats) {
+    *stats = tx_stats;
+}
+
+/**
+ * @brief 입력 링 버퍼 통계를 복사해옵니다.
+ * @param stats 통계를 받을 구조체 포인터
+ */
+void U2C_get_rx_stats(U2C_RxStats *stats) {
+    *stats = rx_stats;
+}
+
+/**
+ * @brief 출력 링 버퍼에 지금 쓸 수 있는 바이트 수를 반환합니다.
+ * @note 출력할 내용이 이보다 길면 `U2C_print`/`U2C_printf`는 아무것도 쓰지 않고 `HAL_BUSY`를 반환하므로, 미리 확인하는 데 사용합니다.
+ */
+uint16_t U2C_get_tx_free(void) {
+    return tx_free();
+}
+
+/**
+ * @brief 긴 출력을 나눠서 이어갈 함수를 등록합니다.
+ * @param fn `U2C_process`가 호출할 때마다 링 버퍼에 공간이 있는 만큼만 출력하고, 다 출력했으면 true를 반환하는 함수 (NULL이면 해제)
+ * @retval HAL_OK: 등록(또는 해제)됨, HAL_BUSY: 다른 함수가 아직 출력 중이라 등록하지 않음
+ * @note 한 번에 하나만 등록되며, 이전 함수가 끝나기 전에 다른 함수를 등록하면 두 출력이 섞이므로 거절합니다.
+ *       같은 함수를 다시 등록하는 것은 허용됩니다. 메인 루프에서만 호출해야 합니다.
+ */
+HAL_StatusTypeDef U2C_set_continuation(U2C_Continuation fn) {
+    if (fn != NULL && continuation != NULL && continuation != fn) {
+        return HAL_BUSY;
+    }
+    continuation = fn;
+    return HAL_OK;
+}
+
+/**
+ * @brief 데이터를 수신할 때마다 인터럽트에서 호출할 함수를 등록합니다.
+ * @param hook 호출할 함수 (NULL이면 해제). 인터럽트에서 호출되므로 짧아야 합니다.
+ */
+void U2C_set_rx_hook(void (*hook)(void)) {
+    rx_hook = hook;
+}
+
+/**
+ * @brief 스케줄러용 태스크 함수입니다. (`U2C_TASK_PERIOD_MS` 주기)
+ */
+void U2C_Task(void) {
+    U2C_process();
 }
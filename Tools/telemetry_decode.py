@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+telemetry_decode.py
+
+TELEM 모듈이 USART2로 보내는 바이너리 텔레메트리를 PC에서 풀어서 출력합니다.
+콘솔 텍스트와 섞여서 들어오므로, 0x00으로 나눈 조각 중 CRC가 맞는 U2C 프레임만 텔레메트리로 처리하고
+나머지는 콘솔 출력으로 stderr에 그대로 출력합니다.
+
+사용법:
+    python3 telemetry_decode.py --port COM5 --baud 115200        (pyserial 필요)
+    python3 telemetry_decode.py capture.bin --csv out.csv        (저장해둔 수신 데이터)
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+FRAME_ID_SCHEMA = 0x53
+FRAME_ID_RECORD = 0x54
+
+# telem.h의 TELEM_Type 순서 (struct 형식 문자)
+TYPES = ["B", "b", "H", "h", "I", "i", "f"]
+TYPE_NAMES = ["u8", "i8", "u16", "i16", "u32", "i32", "f32"]
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE (usart2console.c와 같음)"""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(chunk):
+    """(msg_id, payload) 또는 U2C 프레임이 아니면 None"""
+    raw = cobs_decode(chunk)
+    if raw is None or len(raw) < 3:
+        return None
+    if crc16(raw[:-2]) != struct.unpack(">H", raw[-2:])[0]:
+        return None
+    return raw[0], raw[1:-2]
+
+
+class Decoder:
+    def __init__(self, csv_file=None, quiet=False):
+        self.fields = None      # [(이름, 형식, 개수)]
+        self.record_fmt = None
+        self.rate = 0
+        self.csv = csv_file
+        self.quiet = quiet
+        self.buf = bytearray()
+        self.last_seq = None
+        self.records = 0
+        self.lost = 0
+        self.unknown = 0
+        self.start = time.time()
+        self.bytes = 0
+
+    def feed(self, data):
+        self.bytes += len(data)
+        self.buf += data
+        while True:
+            end = self.buf.find(b"\x00")
+            if end < 0:
+                break
+            chunk = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if chunk:
+                self.chunk(chunk)
+
+    def chunk(self, chunk):
+        frame = parse_frame(chunk)
+        if frame is None:
+            # 콘솔 텍스트
+            sys.stderr.write(chunk.decode("ascii", errors="replace"))
+            return
+        msg_id, payload = frame
+        if msg_id == FRAME_ID_SCHEMA:
+            self.schema(payload)
+        elif msg_id == FRAME_ID_RECORD:
+            self.record(payload)
+        else:
+            self.unknown += 1
+
+    def schema(self, payload):
+        self.rate = struct.unpack_from("<H", payload)[0]
+        self.fields = []
+        i = 2
+        while i < len(payload):
+            t, count = payload[i], payload[i + 1]
+            end = payload.index(0, i + 2)
+            self.fields.append((payload[i + 2:end].decode("ascii", errors="replace"), t, count))
+            i = end + 1
+        self.record_fmt = "<HHI" + "".join(
+            (str(count) if count > 1 else "") + TYPES[t] for _, t, count in self.fields)
+        self.last_seq = None
+        header = ["seq", "overruns", "tick"] + [name for name, _, _ in self.fields]
+        if self.csv:
+            self.csv.write(",".join(header) + "\n")
+        if not self.quiet:
+            desc = ", ".join("%s:%s%s" % (name, TYPE_NAMES[t], "[%d]" % count if count > 1 else "")
+                             for name, t, count in self.fields)
+            print("# schema %d Hz, %d bytes: %s" % (self.rate, struct.calcsize(self.record_fmt), desc))
+
+    def record(self, payload):
+        if self.record_fmt is None or len(payload) != struct.calcsize(self.record_fmt):
+            self.unknown += 1  # 변수 목록을 아직 받지 못함 (보드 콘솔에서 "telem schema")
+            return
+        values = struct.unpack(self.record_fmt, payload)
+        seq = values[0]
+        if self.last_seq is not None:
+            self.lost += (seq - self.last_seq - 1) & 0xFFFF
+        self.last_seq = seq
+        self.records += 1
+
+        row = list(values[:3])
+        i = 3
+        for _, _, count in self.fields:
+            row.append(values[i] if count == 1 else list(values[i:i + count]))
+            i += count
+        if self.csv:
+            self.csv.write(",".join(
+                " ".join(str(x) for x in v) if isinstance(v, list) else str(v) for v in row) + "\n")
+        if not self.quiet:
+            print(" ".join("%s=%s" % (name, v) for (name, _, _), v in zip(self.fields, row[3:])),
+                  "(seq %d, tick %d)" % (seq, row[2]))
+
+    def summary(self):
+        elapsed = max(time.time() - self.start, 1e-6)
+        print("# %d records, %d lost (seq gaps), %d unknown frames, %.0f bytes/s, %.1f records/s"
+              % (self.records, self.lost, self.unknown, self.bytes / elapsed, self.records / elapsed),
+              file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="TELEM binary telemetry decoder")
+    parser.add_argument("file", nargs="?", help="저장해둔 수신 데이터 파일 ('-'이면 stdin)")
+    parser.add_argument("--port", help="시리얼 포트 (pyserial 필요)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--csv", help="레코드를 CSV로 저장")
+    parser.add_argument("--quiet", action="store_true", help="레코드를 화면에 출력하지 않음")
+    args = parser.parse_args()
+
+    csv_file = open(args.csv, "w") if args.csv else None
+    dec = Decoder(csv_file, args.quiet)
+    try:
+        if args.port:
+            import serial
+            with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+                while True:
+                    dec.feed(port.read(4096))
+        else:
+            stream = sys.stdin.buffer if args.file in (None, "-") else open(args.file, "rb")
+            while True:
+                data = stream.read(4096)
+                if not data:
+                    break
+                dec.feed(data)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        dec.summary()
+        if csv_file:
+            csv_file.close()
+
+
+if __name__ == "__main__":
+    main()
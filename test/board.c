@@ -0,0 +1,175 @@
+/*
+ * board.c (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * CubeMX가 만드는 main.c / stm32f4xx_it.c 역할
+ *   - 주변장치 핸들 정의 (README의 CubeMX 설정과 같은 클럭/주기)
+ *   - HAL 콜백을 README 안내대로 각 드라이버의 콜백으로 연결
+ */
+
+#include "board.h"
+#include "usart2console.h"
+#include "keypad16.h"
+#include "lcd1602.h"
+#include "i2cbus.h"
+#include "seg7array.h"
+#include "speaker.h"
+#include "telem.h"
+
+UART_HandleTypeDef huart2;
+I2C_HandleTypeDef hi2c1;
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
+TIM_HandleTypeDef htim4;
+TIM_HandleTypeDef htim9;
+TIM_HandleTypeDef htim10;
+TIM_HandleTypeDef htim11;
+RTC_HandleTypeDef hrtc;
+DMA_HandleTypeDef hdma_usart2_rx;
+
+static void BOARD_Tim_init(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t prescaler, uint32_t period)
+{
+    *htim = (TIM_HandleTypeDef){0};
+    htim->Instance = instance;
+    htim->Init.Prescaler = prescaler;
+    htim->Init.Period = period;
+    instance->PSC = prescaler;
+    instance->ARR = period;
+}
+
+void BOARD_Init(void)
+{
+    HOST_Reset();
+
+    huart2 = (UART_HandleTypeDef){0};
+    huart2.Instance = USART2;
+    huart2.Init.BaudRate = 115200;
+    huart2.RxState = HAL_UART_STATE_READY;
+    hdma_usart2_rx = (DMA_HandleTypeDef){0};
+    hdma_usart2_rx.Instance = DMA1_Stream5;  // U2C_RX_USE_DMA: circular 모드
+    huart2.hdmarx = &hdma_usart2_rx;
+
+    hi2c1 = (I2C_HandleTypeDef){0};
+    hi2c1.Instance = I2C1;
+    hi2c1.Init.ClockSpeed = 100000;
+    HAL_I2C_Init(&hi2c1);
+
+    BOARD_Tim_init(&htim2, TIM2, 84 - 1, 0xFFFFFFFF);
+    BOARD_Tim_init(&htim3, TIM3, 84 - 1, 0xFFFF);
+    BOARD_Tim_init(&htim4, TIM4, 84 - 1, 0xFFFF);
+    BOARD_Tim_init(&htim9, TIM9, 8400 - 1, 100 - 1);
+    BOARD_Tim_init(&htim10, TIM10, 84 - 1, 0xFFFF);
+    BOARD_Tim_init(&htim11, TIM11, 0, 840 - 1);
+
+    // MX_GPIO_Init의 출력 초기값: 7세그먼트 자리 핀은 HIGH(꺼짐), 나머지는 LOW
+    HAL_GPIO_WritePin(SEG1_GPIO_Port, SEG1_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SEG2_GPIO_Port, SEG2_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SEG3_GPIO_Port, SEG3_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SEG4_GPIO_Port, SEG4_Pin, GPIO_PIN_SET);
+}
+
+void Error_Handler(void)
+{
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == &huart2)
+    {
+        U2C_TxCpltCallback();
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == &huart2)
+    {
+        U2C_RxCpltCallback();
+    }
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart == &huart2)
+    {
+        U2C_RxEventCallback(Size);
+    }
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == &huart2)
+    {
+        U2C_ErrorCallback();
+    }
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == &htim3)
+    {
+        LCD_TIM_Callback();
+    }
+    else if (htim == &htim4)
+    {
+        SEG7ARRAY_TIM_Callback();
+    }
+    else if (htim == &htim9)
+    {
+        KEYPAD16_TIM_Callback();
+    }
+    else if (htim == &htim10)
+    {
+        TELEM_TIM_Callback();
+    }
+    else if (htim == &htim11)
+    {
+        SPEAKER_Loop();
+    }
+}
+
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == &htim4)
+    {
+        SEG7ARRAY_TIM_OC_Callback();
+    }
+}
+
+void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == &htim11)
+    {
+        SPEAKER_DMA_HalfCpltCallback();
+    }
+}
+
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == &htim11)
+    {
+        SPEAKER_DMA_CpltCallback();
+    }
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2CBUS_TxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2CBUS_RxCpltCallback(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2CBUS_ErrorCallback(hi2c);
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    KEYPAD16_EXTI_Callback(GPIO_Pin);
+}
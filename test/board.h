@@ -0,0 +1,28 @@
+/*
+ * board.h (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ */
+
+#ifndef TEST_BOARD_H_
+#define TEST_BOARD_H_
+
+#include "main.h"
+
+extern UART_HandleTypeDef huart2;
+extern I2C_HandleTypeDef hi2c1;
+extern TIM_HandleTypeDef htim2;   // 32비트, 1MHz
+extern TIM_HandleTypeDef htim3;   // lcd1602 비동기 모드, 1MHz
+extern TIM_HandleTypeDef htim4;   // seg7array 타이머 모드, 1MHz
+extern TIM_HandleTypeDef htim9;   // keypad16 인터럽트 구동 스캔, 10ms
+extern TIM_HandleTypeDef htim10;  // telem, 1MHz (16비트)
+extern TIM_HandleTypeDef htim11;  // speaker (SPEAKER_Loop 100kHz 또는 PWM 출력)
+extern RTC_HandleTypeDef hrtc;     // power (POWER_USE_RTC), RTCCLK 32768Hz
+
+/**
+ * @brief 시뮬레이션을 처음 상태로 되돌리고 CubeMX 설정과 같은 핸들을 준비 (HOST_Reset 포함)
+ */
+void BOARD_Init(void);
+
+#endif /* TEST_BOARD_H_ */
@@ -0,0 +1,48 @@
+/*
+ * host_test.h (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 테스트 파일 하나 = 실행 파일 하나 (드라이버의 static 상태가 테스트 파일끼리 섞이지 않음)
+ * 실패한 CHECK는 위치와 값을 출력하고 계속 진행하며, 하나라도 실패하면 TEST_EXIT()가 1을 반환
+ */
+
+#ifndef TEST_HOST_TEST_H_
+#define TEST_HOST_TEST_H_
+
+#include <stdio.h>
+#include "board.h"
+
+static int host_test_failures = 0;
+
+#define CHECK(cond)                                                                    \
+    do {                                                                               \
+        if (!(cond)) {                                                                 \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);   \
+            host_test_failures++;                                                      \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                     \
+    do {                                                                               \
+        long long actual_ = (long long)(actual);                                       \
+        long long expected_ = (long long)(expected);                                   \
+        if (actual_ != expected_) {                                                    \
+            fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",          \
+                    __FILE__, __LINE__, #actual, #expected, actual_, expected_);       \
+            host_test_failures++;                                                      \
+        }                                                                              \
+    } while (0)
+
+// 시뮬레이션과 보드 핸들을 초기화한 뒤 테스트 함수 실행
+#define RUN_TEST(fn)                 \
+    do {                             \
+        printf("[ RUN  ] %s\n", #fn); \
+        BOARD_Init();                \
+        fn();                        \
+    } while (0)
+
+#define TEST_EXIT() (host_test_failures == 0 ? (printf("OK\n"), 0) : (printf("%d check(s) failed\n", host_test_failures), 1))
+
+#endif /* TEST_HOST_TEST_H_ */
@@ -0,0 +1,29 @@
+# keypad_scan_compare.cmake
+#   test_keypad16(BSRR/IDR 빠른 스캔)과 test_keypad16_pins(HAL_GPIO 방식)를 실행해서 스캔 비용을 나란히 출력
+#   cmake -DTEST_PORT=<실행 파일> -DTEST_PINS=<실행 파일> -P keypad_scan_compare.cmake
+
+set(lines "")
+foreach(exe ${TEST_PORT} ${TEST_PINS})
+    execute_process(COMMAND ${exe} RESULT_VARIABLE result OUTPUT_VARIABLE output)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${exe} failed: ${result}\n${output}")
+    endif()
+    if(NOT output MATCHES "keypad scan \\(([A-Z_/]+)\\): ([0-9]+) HAL_GPIO calls/scan, ([0-9]+) ns/scan")
+        message(FATAL_ERROR "${exe} printed no scan cost:\n${output}")
+    endif()
+    list(APPEND lines "${CMAKE_MATCH_1}: ${CMAKE_MATCH_2} HAL_GPIO calls, ${CMAKE_MATCH_3} ns/scan")
+    list(APPEND ns ${CMAKE_MATCH_3})
+endforeach()
+
+list(GET lines 0 port_line)
+list(GET lines 1 pins_line)
+list(GET ns 0 port_ns)
+list(GET ns 1 pins_ns)
+if(NOT port_ns EQUAL 0)
+    math(EXPR ratio_x10 "${pins_ns} * 10 / ${port_ns}")
+    math(EXPR ratio_int "${ratio_x10} / 10")
+    math(EXPR ratio_frac "${ratio_x10} % 10")
+    message("keypad scan on this PC: ${port_line} | ${pins_line} | HAL_GPIO/BSRR = ${ratio_int}.${ratio_frac}x")
+else()
+    message("keypad scan on this PC: ${port_line} | ${pins_line}")
+endif()
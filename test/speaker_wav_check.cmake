@@ -0,0 +1,32 @@
+# speaker_wav_check.cmake
+#   test_speaker(C 코드)와 test_speaker_smlad(SMLAD 경로)가 같은 화음을 합성해서 저장한 WAV 파일 비교
+#   cmake -DTEST_C=<실행 파일> -DTEST_SMLAD=<실행 파일> -DWORK_DIR=<디렉터리> -P speaker_wav_check.cmake
+
+set(wav_c ${WORK_DIR}/speaker_dds_c.wav)
+set(wav_smlad ${WORK_DIR}/speaker_dds_smlad.wav)
+
+foreach(pair "${TEST_C}|${wav_c}" "${TEST_SMLAD}|${wav_smlad}")
+    string(REPLACE "|" ";" pair "${pair}")
+    list(GET pair 0 exe)
+    list(GET pair 1 wav)
+    file(REMOVE ${wav})
+    execute_process(COMMAND ${exe} ${wav} RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${exe} failed: ${result}")
+    endif()
+endforeach()
+
+# 머리 44바이트 + 16비트 모노 0.5초 (40kHz)
+file(SIZE ${wav_c} size)
+if(NOT size EQUAL 40044)
+    message(FATAL_ERROR "unexpected WAV size: ${size}")
+endif()
+file(READ ${wav_c} header LIMIT 16 HEX)
+if(NOT header MATCHES "^52494646........57415645666d7420$")  # "RIFF" ???? "WAVEfmt "
+    message(FATAL_ERROR "not a WAV header: ${header}")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${wav_c} ${wav_smlad} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "C and SMLAD synthesis differ: ${wav_c} ${wav_smlad}")
+endif()
@@ -0,0 +1,1148 @@
+/*
+ * hal_stub.c (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * stm32f4xx_hal.h에 선언한 HAL 함수와 주변장치 시뮬레이션
+ *   - 시간은 HOST_Advance_us로만 흐름 (1us 단위로 SysTick, 타이머, UART, I²C를 함께 진행)
+ *   - 인터럽트에 해당하는 콜백은 PRIMASK가 0이고 다른 콜백 안이 아닐 때만 호출 (중첩 인터럽트 없음)
+ *   - 보드에서 시간이 흐르지 않으면 끝나지 않는 대기(HAL_Delay 등)는 시뮬레이션 시간 10초가 지나면 멈춘 것으로 보고 중단
+ */
+
+#include "stm32f4xx_hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HOST_MAX_HANDLES 8
+#define HOST_HANG_US 10000000ULL  // 이 시간 동안 tick이 멈춰 있으면 무한 대기로 판단
+
+volatile uint32_t host_primask;
+SysTick_Type host_systick;
+SCB_Type host_scb;
+DWT_Type host_dwt;
+CoreDebug_Type host_coredebug;
+uint32_t SystemCoreClock = HOST_CPU_CLOCK_HZ;
+uint32_t host_rcc_sysclk = HOST_CPU_CLOCK_HZ;
+
+__IO uint32_t uwTick;
+uint32_t uwTickPrio = TICK_INT_PRIORITY;
+
+GPIO_TypeDef host_gpio[HOST_GPIO_PORTS];
+EXTI_TypeDef host_exti;
+SYSCFG_TypeDef host_syscfg;
+USART_TypeDef host_usart2;
+DMA_Stream_TypeDef host_dma1_stream5;
+TIM_TypeDef host_tim2, host_tim3, host_tim4, host_tim5, host_tim9, host_tim10, host_tim11;
+I2C_TypeDef host_i2c1;
+
+void (*host_wfi_hook)(void);
+void (*host_stop_hook)(void);
+void (*host_step_hook)(void);
+uint32_t host_stop_count;
+uint8_t host_in_isr;
+
+HOST_GpioEvent host_gpio_log[HOST_GPIO_LOG_SIZE];
+uint32_t host_gpio_log_count;
+uint32_t host_gpio_hal_calls;
+
+uint8_t host_uart_capture[HOST_UART_CAPTURE_SIZE];
+uint32_t host_uart_capture_len;
+uint32_t host_uart_tx_irqs;
+uint32_t host_uart_rx_irqs;
+uint32_t host_uart_rx_lost;
+
+HOST_I2cXfer host_i2c_log[HOST_I2C_LOG_SIZE];
+uint32_t host_i2c_log_count;
+uint64_t host_i2c_busy_us;
+uint32_t host_i2c_irqs;
+uint32_t host_tim_irqs;
+uint32_t host_i2c_inits;
+uint8_t host_i2c_init_in_isr;
+HOST_I2cDevice host_i2c_dev[128];
+uint32_t host_i2c_fail_next;
+uint8_t host_i2c_hang;
+
+uint32_t host_rtc_wakeup_counts;
+uint32_t host_rtc_masked_calls;
+
+static uint64_t now_us;
+static uint64_t rtc_us;
+static uint32_t systick_pending;
+static uint16_t gpio_last_odr[HOST_GPIO_PORTS];
+static uint8_t advancing;
+
+static UART_HandleTypeDef *uarts[HOST_MAX_HANDLES];
+static TIM_HandleTypeDef *tims[HOST_MAX_HANDLES];
+static I2C_HandleTypeDef *i2cs[HOST_MAX_HANDLES];
+static HOST_I2cXfer *i2c_current[HOST_MAX_HANDLES];
+
+
+/* ---------------------------------------------------------------- 기본 콜백 (board.c 또는 테스트가 다시 정의) */
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__attribute__((weak)) void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) { (void)huart; (void)Size; }
+__attribute__((weak)) void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__attribute__((weak)) void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__attribute__((weak)) void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__attribute__((weak)) void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+__attribute__((weak)) void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) { (void)hi2c; }
+
+
+/* ---------------------------------------------------------------- 공통 */
+
+// 핸들을 목록에 추가 (이미 있으면 그대로)
+static void host_register(void **list, void *handle)
+{
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        if (list[i] == handle)
+        {
+            return;
+        }
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        if (list[i] == NULL)
+        {
+            list[i] = handle;
+            return;
+        }
+    }
+    fprintf(stderr, "hal_stub: too many handles\n");
+    abort();
+}
+
+static void host_hang(const char *what)
+{
+    fprintf(stderr, "hal_stub: %s did not finish within %llu us of simulated time (tick stopped?)\n", what,
+            (unsigned long long)HOST_HANG_US);
+    abort();
+}
+
+void HOST_Reset(void)
+{
+    now_us = 0;
+    rtc_us = 0;
+    systick_pending = 0;
+    advancing = 0;
+    host_primask = 0;
+    host_in_isr = 0;
+    host_wfi_hook = NULL;
+    host_stop_hook = NULL;
+    host_step_hook = NULL;
+    host_stop_count = 0;
+
+    SystemCoreClock = HOST_CPU_CLOCK_HZ;
+    host_rcc_sysclk = HOST_CPU_CLOCK_HZ;
+    uwTick = 0;
+    uwTickPrio = TICK_INT_PRIORITY;
+    host_systick = (SysTick_Type){0};
+    host_systick.LOAD = SystemCoreClock / 1000 - 1;
+    host_systick.VAL = host_systick.LOAD;
+    host_systick.CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+    host_scb = (SCB_Type){0};
+    host_dwt = (DWT_Type){0};
+    host_coredebug = (CoreDebug_Type){0};
+
+    for (int p = 0; p < HOST_GPIO_PORTS; p++)
+    {
+        host_gpio[p] = (GPIO_TypeDef){0};
+        host_gpio[p].IDR = 0xFFFF;  // 입력은 풀업
+        gpio_last_odr[p] = 0;
+    }
+    host_exti = (EXTI_TypeDef){0};
+    host_syscfg = (SYSCFG_TypeDef){0};
+    host_usart2 = (USART_TypeDef){0};
+    host_usart2.SR = UART_FLAG_TC;
+    host_dma1_stream5 = (DMA_Stream_TypeDef){0};
+    host_tim2 = host_tim3 = host_tim4 = host_tim5 = host_tim9 = host_tim10 = host_tim11 = (TIM_TypeDef){0};
+    host_i2c1 = (I2C_TypeDef){0};
+
+    memset(uarts, 0, sizeof(uarts));
+    memset(tims, 0, sizeof(tims));
+    memset(i2cs, 0, sizeof(i2cs));
+    memset(i2c_current, 0, sizeof(i2c_current));
+
+    host_gpio_log_count = 0;
+    host_gpio_hal_calls = 0;
+    host_uart_capture_len = 0;
+    host_uart_tx_irqs = 0;
+    host_uart_rx_irqs = 0;
+    host_uart_rx_lost = 0;
+    host_i2c_log_count = 0;
+    host_i2c_busy_us = 0;
+    host_i2c_irqs = 0;
+    host_tim_irqs = 0;
+    host_i2c_inits = 0;
+    host_i2c_init_in_isr = 0;
+    memset(host_i2c_dev, 0, sizeof(host_i2c_dev));
+    host_i2c_fail_next = 0;
+    host_i2c_hang = 0;
+    host_rtc_wakeup_counts = 0;
+    host_rtc_masked_calls = 0;
+}
+
+uint64_t HOST_Now_us(void)
+{
+    return now_us;
+}
+
+
+/* ---------------------------------------------------------------- GPIO */
+
+void HOST_GPIO_Sync(void)
+{
+    for (int p = 0; p < HOST_GPIO_PORTS; p++)
+    {
+        GPIO_TypeDef *port = &host_gpio[p];
+        uint32_t bsrr = port->BSRR;
+        if (bsrr != 0)
+        {
+            // 같은 핀에 set과 reset이 함께 있으면 set이 우선
+            port->ODR = (port->ODR & ~(bsrr >> 16)) | (bsrr & 0xFFFF);
+            port->BSRR = 0;
+        }
+        uint16_t odr = (uint16_t)port->ODR;
+        if (odr != gpio_last_odr[p])
+        {
+            gpio_last_odr[p] = odr;
+            if (host_gpio_log_count < HOST_GPIO_LOG_SIZE)
+            {
+                host_gpio_log[host_gpio_log_count++] = (HOST_GpioEvent){now_us, (uint8_t)p, odr};
+            }
+        }
+    }
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    host_gpio_hal_calls++;
+    HOST_GPIO_Sync();
+    if (PinState != GPIO_PIN_RESET)
+    {
+        GPIOx->ODR |= GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+    HOST_GPIO_Sync();
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    host_gpio_hal_calls++;
+    HOST_GPIO_Sync();
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+
+/* ---------------------------------------------------------------- 시간 진행 */
+
+static void host_step_systick(uint32_t clocks)
+{
+    if (!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk))
+    {
+        return;
+    }
+    while (clocks > 0)
+    {
+        if (SysTick->VAL == 0)
+        {
+            SysTick->VAL = SysTick->LOAD & SysTick_LOAD_RELOAD_Msk;  // 0 다음 클럭에 reload
+            clocks--;
+            continue;
+        }
+        uint32_t step = (SysTick->VAL < clocks) ? SysTick->VAL : clocks;
+        SysTick->VAL -= step;
+        clocks -= step;
+        if (SysTick->VAL == 0)
+        {
+            SysTick->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+            if (SysTick->CTRL & SysTick_CTRL_TICKINT_Msk)
+            {
+                systick_pending++;
+                SCB->ICSR |= SCB_ICSR_PENDSTSET_Msk;
+            }
+        }
+    }
+}
+
+static void host_step_tim(TIM_HandleTypeDef *htim, uint32_t clock_hz)
+{
+    TIM_TypeDef *tim = htim->Instance;
+    if (!(tim->CR1 & TIM_CR1_CEN))
+    {
+        return;
+    }
+    uint64_t div = (uint64_t)(tim->PSC + 1) * 1000000u;
+    htim->host_clock_acc += clock_hz;
+    uint64_t counts = htim->host_clock_acc / div;
+    htim->host_clock_acc %= div;
+
+    while (counts-- > 0)
+    {
+        if (tim->CNT >= tim->ARR)
+        {
+            tim->CNT = 0;
+            tim->SR |= TIM_FLAG_UPDATE;
+            if (tim->DIER & TIM_DIER_UIE)
+            {
+                htim->host_pending |= 0x01;
+            }
+        }
+        else
+        {
+            tim->CNT++;
+        }
+        for (int ch = 0; ch < 4; ch++)
+        {
+            uint32_t ccr = *(&tim->CCR1 + ch);
+            if ((tim->DIER & (TIM_DIER_CC1IE << ch)) && tim->CNT == ccr)
+            {
+                htim->host_pending |= (uint8_t)(0x02 << ch);
+            }
+        }
+    }
+}
+
+#define HOST_UART_EVENT_HALF 0x01
+#define HOST_UART_EVENT_FULL 0x02
+#define HOST_UART_EVENT_IDLE 0x04
+
+// 선로에서 한 바이트가 도착: DMA가 버퍼에 쓰거나, IT 수신이면 DR에 두고 인터럽트를 기다림
+static void host_uart_rx_byte(UART_HandleTypeDef *huart, uint8_t c)
+{
+    if (huart->host_rx_dma)
+    {
+        DMA_Stream_TypeDef *stream = huart->hdmarx->Instance;
+        huart->host_rx_data[huart->host_rx_len - stream->NDTR] = c;
+        stream->NDTR--;
+        if (stream->NDTR == huart->host_rx_len / 2)
+        {
+            huart->host_rx_events |= HOST_UART_EVENT_HALF;
+        }
+        if (stream->NDTR == 0)
+        {
+            stream->NDTR = huart->host_rx_len;  // circular 모드: 처음부터 다시
+            huart->host_rx_events |= HOST_UART_EVENT_FULL;
+        }
+    }
+    else if (huart->RxState == HAL_UART_STATE_BUSY_RX && !huart->host_rx_dr_full)
+    {
+        huart->host_rx_dr = c;
+        huart->host_rx_dr_full = 1;
+    }
+    else
+    {
+        // 수신을 시작하지 않았거나, 인터럽트가 앞 바이트를 읽기 전에 도착 (overrun)
+        host_uart_rx_lost++;
+        if (huart->RxState == HAL_UART_STATE_BUSY_RX)
+        {
+            huart->host_rx_error |= HAL_UART_ERROR_ORE;
+        }
+    }
+}
+
+static void host_step_uart_rx(UART_HandleTypeDef *huart)
+{
+    uint8_t line_empty = (huart->host_rx_line_head == huart->host_rx_line_tail);
+    if (line_empty && !huart->host_rx_idle)
+    {
+        huart->host_rx_bit_acc = 0;
+        return;
+    }
+    huart->host_rx_bit_acc += huart->Init.BaudRate;
+    if (huart->host_rx_bit_acc < 10u * 1000000u)
+    {
+        return;
+    }
+    huart->host_rx_bit_acc -= 10u * 1000000u;
+
+    if (line_empty)
+    {
+        // 한 바이트 시간 동안 다음 바이트가 없음: IDLE 라인
+        huart->host_rx_idle = 0;
+        if (huart->host_rx_dma)
+        {
+            huart->host_rx_events |= HOST_UART_EVENT_IDLE;
+        }
+        return;
+    }
+    uint8_t c = huart->host_rx_line[huart->host_rx_line_tail];
+    huart->host_rx_line_tail = (huart->host_rx_line_tail + 1) % HOST_UART_LINE_SIZE;
+    huart->host_rx_idle = 1;
+    host_uart_rx_byte(huart, c);
+}
+
+static void host_step_uart(UART_HandleTypeDef *huart)
+{
+    host_step_uart_rx(huart);
+    if (huart->host_tx_data == NULL)
+    {
+        return;
+    }
+    // 1바이트 = 시작 비트 + 8비트 + 정지 비트
+    huart->host_tx_bit_acc += huart->Init.BaudRate;
+    while (huart->host_tx_bit_acc >= 10u * 1000000u && huart->host_tx_sent < huart->host_tx_len)
+    {
+        huart->host_tx_bit_acc -= 10u * 1000000u;
+        if (host_uart_capture_len < HOST_UART_CAPTURE_SIZE)
+        {
+            host_uart_capture[host_uart_capture_len++] = huart->host_tx_data[huart->host_tx_sent];
+        }
+        huart->host_tx_sent++;
+    }
+    if (huart->host_tx_sent == huart->host_tx_len)
+    {
+        huart->host_tx_data = NULL;
+        huart->Instance->SR |= UART_FLAG_TC;
+        huart->host_tx_pending = 1;
+    }
+}
+
+// 장치 모델에 전송을 반영하고 결과 오류 코드를 반환
+static uint32_t host_i2c_device_xfer(uint8_t addr, uint8_t read, uint8_t *data, uint16_t len)
+{
+    if (host_i2c_fail_next != 0)
+    {
+        uint32_t error = host_i2c_fail_next;
+        host_i2c_fail_next = 0;
+        return error;
+    }
+    HOST_I2cDevice *dev = &host_i2c_dev[addr & 0x7F];
+    if (!dev->present)
+    {
+        return HAL_I2C_ERROR_AF;
+    }
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (read)
+        {
+            data[i] = dev->mem[dev->reg++];
+        }
+        else if (i == 0)
+        {
+            dev->reg = data[0];
+        }
+        else
+        {
+            dev->mem[dev->reg++] = data[i];
+        }
+    }
+    return HAL_I2C_ERROR_NONE;
+}
+
+static void host_step_i2c(int index)
+{
+    I2C_HandleTypeDef *hi2c = i2cs[index];
+    if (!hi2c->host_busy || host_i2c_hang)
+    {
+        if (hi2c->host_busy)
+        {
+            host_i2c_busy_us++;
+        }
+        return;
+    }
+    host_i2c_busy_us++;
+    if (--hi2c->host_us_left > 0)
+    {
+        return;
+    }
+
+    hi2c->host_busy = 0;
+    hi2c->ErrorCode = host_i2c_device_xfer(hi2c->host_addr, hi2c->host_read, hi2c->host_data, hi2c->host_len);
+    HOST_I2cXfer *log = i2c_current[index];
+    if (log != NULL)
+    {
+        log->end_us = now_us;
+        log->error = hi2c->ErrorCode;
+        if (hi2c->host_read)
+        {
+            memcpy(log->data, hi2c->host_data, hi2c->host_len < sizeof(log->data) ? hi2c->host_len : sizeof(log->data));
+        }
+    }
+    hi2c->host_pending = 1;
+}
+
+// UART 수신 인터럽트: DR의 바이트, DMA 이벤트, 오류 순서로 처리
+static void host_deliver_uart_rx(UART_HandleTypeDef *huart)
+{
+    if (huart->host_rx_dr_full)
+    {
+        huart->host_rx_dr_full = 0;
+        host_uart_rx_irqs++;
+        *huart->host_rx_data = huart->host_rx_dr;
+        huart->RxState = HAL_UART_STATE_READY;  // HAL_UART_Receive_IT를 다시 호출해야 다음 바이트를 받음
+        HAL_UART_RxCpltCallback(huart);
+    }
+    if (huart->host_rx_events)
+    {
+        uint8_t events = huart->host_rx_events;
+        huart->host_rx_events = 0;
+        if (events & HOST_UART_EVENT_HALF)
+        {
+            host_uart_rx_irqs++;
+            HAL_UARTEx_RxEventCallback(huart, huart->host_rx_len / 2);
+        }
+        if (events & HOST_UART_EVENT_FULL)
+        {
+            host_uart_rx_irqs++;
+            HAL_UARTEx_RxEventCallback(huart, huart->host_rx_len);
+        }
+        // HAL처럼 IDLE 시점의 NDTR로 위치를 계산하고, 버퍼 끝에서 막 돌아온 경우(NDTR == Size)는 알리지 않음
+        uint32_t remaining = huart->hdmarx->Instance->NDTR;
+        if ((events & HOST_UART_EVENT_IDLE) && huart->host_rx_dma && remaining != huart->host_rx_len)
+        {
+            host_uart_rx_irqs++;
+            HAL_UARTEx_RxEventCallback(huart, (uint16_t)(huart->host_rx_len - remaining));
+        }
+    }
+    if (huart->host_rx_error)
+    {
+        huart->ErrorCode = huart->host_rx_error;
+        huart->host_rx_error = 0;
+        host_uart_rx_irqs++;
+        if (huart->ErrorCode & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_DMA))
+        {
+            // 수신 중단: DMA도 멈추고, 다시 시작할 때까지 도착하는 바이트는 버려짐
+            huart->RxState = HAL_UART_STATE_READY;
+            huart->host_rx_dma = 0;
+            huart->host_rx_events = 0;
+            HAL_UART_ErrorCallback(huart);
+        }
+        else
+        {
+            HAL_UART_ErrorCallback(huart);
+            huart->ErrorCode = HAL_UART_ERROR_NONE;
+        }
+    }
+}
+
+// 차단되지 않았으면 대기 중인 인터럽트 콜백 호출
+static void host_deliver(void)
+{
+    if (host_primask || host_in_isr)
+    {
+        return;
+    }
+    host_in_isr = 1;
+
+    if (systick_pending)
+    {
+        uwTick += systick_pending;
+        systick_pending = 0;
+        SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        TIM_HandleTypeDef *htim = tims[i];
+        if (htim == NULL || htim->host_pending == 0)
+        {
+            continue;
+        }
+        uint8_t pending = htim->host_pending;
+        htim->host_pending = 0;
+        for (int ch = 0; ch < 4; ch++)
+        {
+            if (pending & (0x02 << ch))
+            {
+                htim->Channel = (HAL_TIM_ActiveChannel)(1u << ch);
+                host_tim_irqs++;
+                HAL_TIM_OC_DelayElapsedCallback(htim);
+                htim->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+            }
+        }
+        if (pending & 0x01)
+        {
+            host_tim_irqs++;
+            HAL_TIM_PeriodElapsedCallback(htim);
+        }
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        UART_HandleTypeDef *huart = uarts[i];
+        if (huart != NULL && huart->host_tx_pending)
+        {
+            huart->host_tx_pending = 0;
+            host_uart_tx_irqs++;
+            HAL_UART_TxCpltCallback(huart);
+        }
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        UART_HandleTypeDef *huart = uarts[i];
+        if (huart != NULL)
+        {
+            host_deliver_uart_rx(huart);
+        }
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        I2C_HandleTypeDef *hi2c = i2cs[i];
+        if (hi2c != NULL && hi2c->host_pending)
+        {
+            hi2c->host_pending = 0;
+            host_i2c_irqs++;
+            if (hi2c->ErrorCode != HAL_I2C_ERROR_NONE)
+            {
+                HAL_I2C_ErrorCallback(hi2c);
+            }
+            else if (hi2c->host_read)
+            {
+                HAL_I2C_MasterRxCpltCallback(hi2c);
+            }
+            else
+            {
+                HAL_I2C_MasterTxCpltCallback(hi2c);
+            }
+        }
+    }
+
+    host_in_isr = 0;
+    HOST_GPIO_Sync();
+}
+
+void HOST_Deliver(void)
+{
+    host_deliver();
+}
+
+uint8_t HOST_Irq_pending(void)
+{
+    if (systick_pending)
+    {
+        return 1;
+    }
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        if (tims[i] != NULL && tims[i]->host_pending)
+        {
+            return 1;
+        }
+        if (uarts[i] != NULL && (uarts[i]->host_tx_pending || uarts[i]->host_rx_dr_full || uarts[i]->host_rx_events ||
+                                 uarts[i]->host_rx_error))
+        {
+            return 1;
+        }
+        if (i2cs[i] != NULL && i2cs[i]->host_pending)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void HOST_Advance_us(uint32_t us)
+{
+    host_deliver();
+    while (us-- > 0)
+    {
+        now_us++;
+        rtc_us++;
+
+        uint32_t clocks = host_rcc_sysclk / 1000000u;
+        host_step_systick(clocks);
+        if (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)
+        {
+            DWT->CYCCNT += clocks;
+        }
+        for (int i = 0; i < HOST_MAX_HANDLES; i++)
+        {
+            if (tims[i] != NULL)
+            {
+                host_step_tim(tims[i], host_rcc_sysclk);
+            }
+            if (uarts[i] != NULL)
+            {
+                host_step_uart(uarts[i]);
+            }
+            if (i2cs[i] != NULL)
+            {
+                host_step_i2c(i);
+            }
+        }
+        if (host_step_hook != NULL)
+        {
+            host_step_hook();
+        }
+        host_deliver();
+    }
+}
+
+
+/* ---------------------------------------------------------------- 코어 / HAL 공통 */
+
+void __WFI(void)
+{
+    if (host_wfi_hook != NULL)
+    {
+        host_wfi_hook();
+        return;
+    }
+    HOST_Advance_us(1);
+}
+
+void SystemCoreClockUpdate(void)
+{
+    SystemCoreClock = host_rcc_sysclk;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return uwTick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    uint32_t tickstart = HAL_GetTick();
+    uint32_t wait = Delay;
+    if (wait < HAL_MAX_DELAY)
+    {
+        wait += 1;  // HAL과 같이 최소 대기 시간을 보장
+    }
+    uint64_t last_change = now_us;
+    uint32_t last_tick = tickstart;
+    HOST_GPIO_Sync();
+    while ((HAL_GetTick() - tickstart) < wait)
+    {
+        HOST_Advance_us(1);
+        if (HAL_GetTick() != last_tick)
+        {
+            last_tick = HAL_GetTick();
+            last_change = now_us;
+        }
+        else if (now_us - last_change > HOST_HANG_US)
+        {
+            host_hang("HAL_Delay");
+        }
+    }
+}
+
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+    SysTick->LOAD = SystemCoreClock / 1000 - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+    uwTickPrio = TickPriority;
+    return HAL_OK;
+}
+
+void HAL_SuspendTick(void)
+{
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+}
+
+void HAL_ResumeTick(void)
+{
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+
+/* ---------------------------------------------------------------- UART */
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0)
+    {
+        return HAL_ERROR;
+    }
+    if (huart->host_tx_data != NULL || huart->host_tx_pending)
+    {
+        return HAL_BUSY;
+    }
+    host_register((void **)uarts, huart);
+    huart->host_tx_data = pData;
+    huart->host_tx_len = Size;
+    huart->host_tx_sent = 0;
+    huart->host_tx_bit_acc = 0;
+    huart->Instance->SR &= ~UART_FLAG_TC;
+    return HAL_OK;
+}
+
+// 모델은 1바이트 IT 수신만 지원 (U2C처럼 Size == 1)
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size != 1)
+    {
+        return HAL_ERROR;
+    }
+    if (huart->RxState == HAL_UART_STATE_BUSY_RX)
+    {
+        return HAL_BUSY;
+    }
+    host_register((void **)uarts, huart);
+    huart->host_rx_data = pData;
+    huart->host_rx_len = Size;
+    huart->host_rx_dma = 0;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+// circular 모드 DMA (CubeMX에서 USART2_RX를 DMA1 Stream5, Circular로 설정한 경우)
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0 || huart->hdmarx == NULL)
+    {
+        return HAL_ERROR;
+    }
+    if (huart->RxState == HAL_UART_STATE_BUSY_RX)
+    {
+        return HAL_BUSY;
+    }
+    host_register((void **)uarts, huart);
+    huart->host_rx_data = pData;
+    huart->host_rx_len = Size;
+    huart->host_rx_dma = 1;
+    huart->host_rx_events = 0;
+    huart->hdmarx->Instance->NDTR = Size;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+void HOST_UART_Feed(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len)
+{
+    host_register((void **)uarts, huart);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint16_t next = (huart->host_rx_line_head + 1) % HOST_UART_LINE_SIZE;
+        if (next == huart->host_rx_line_tail)
+        {
+            fprintf(stderr, "hal_stub: UART line queue full\n");
+            abort();
+        }
+        huart->host_rx_line[huart->host_rx_line_head] = data[i];
+        huart->host_rx_line_head = next;
+    }
+}
+
+void HOST_UART_Receive(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len)
+{
+    HOST_UART_Feed(huart, data, len);
+    while (huart->host_rx_line_head != huart->host_rx_line_tail || huart->host_rx_idle)
+    {
+        HOST_Advance_us(1);
+    }
+}
+
+void HOST_UART_RxError(UART_HandleTypeDef *huart, uint32_t error)
+{
+    host_register((void **)uarts, huart);
+    huart->host_rx_error |= error;
+    host_deliver();
+}
+
+
+/* ---------------------------------------------------------------- TIM */
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    host_register((void **)tims, htim);
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER &= ~TIM_DIER_UIE;
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    htim->host_pending &= ~0x01;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    host_register((void **)tims, htim);
+    htim->Instance->DIER |= TIM_DIER_CC1IE << (Channel >> 2);
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->DIER &= ~(TIM_DIER_CC1IE << (Channel >> 2));
+    htim->host_pending &= (uint8_t)~(0x02 << (Channel >> 2));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    host_register((void **)tims, htim);
+    htim->Instance->CCER |= 1u << (Channel);
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->CCER &= ~(1u << (Channel));
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length)
+{
+    htim->host_dma_data = pData;
+    htim->host_dma_len = Length;
+    return HAL_TIM_PWM_Start(htim, Channel);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->host_dma_data = NULL;
+    htim->host_dma_len = 0;
+    return HAL_TIM_PWM_Stop(htim, Channel);
+}
+
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource)
+{
+    if (EventSource & TIM_EVENTSOURCE_UPDATE)
+    {
+        htim->Instance->CNT = 0;
+    }
+    return HAL_OK;
+}
+
+
+/* ---------------------------------------------------------------- I2C */
+
+static int host_i2c_index(I2C_HandleTypeDef *hi2c)
+{
+    host_register((void **)i2cs, hi2c);
+    for (int i = 0; i < HOST_MAX_HANDLES; i++)
+    {
+        if (i2cs[i] == hi2c)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 전송 시간: START + (주소 + 데이터) 바이트마다 9비트 + STOP
+static uint32_t host_i2c_duration_us(I2C_HandleTypeDef *hi2c, uint16_t len)
+{
+    uint32_t speed = hi2c->Init.ClockSpeed ? hi2c->Init.ClockSpeed : 100000u;
+    uint32_t bits = 2 + 9u * (len + 1u);
+    return (uint32_t)(((uint64_t)bits * 1000000u + speed - 1) / speed);
+}
+
+static HOST_I2cXfer *host_i2c_log_start(uint8_t addr, uint8_t read, uint32_t frame, const uint8_t *data, uint16_t len)
+{
+    if (host_i2c_log_count == HOST_I2C_LOG_SIZE)
+    {
+        return NULL;
+    }
+    HOST_I2cXfer *log = &host_i2c_log[host_i2c_log_count++];
+    *log = (HOST_I2cXfer){0};
+    log->start_us = now_us;
+    log->addr = addr;
+    log->read = read;
+    log->frame = frame;
+    log->len = len;
+    if (!read && data != NULL)
+    {
+        memcpy(log->data, data, len < sizeof(log->data) ? len : sizeof(log->data));
+    }
+    return log;
+}
+
+static HAL_StatusTypeDef host_i2c_start_it(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                           uint8_t read, uint32_t frame)
+{
+    int index = host_i2c_index(hi2c);
+    if (!hi2c->host_inited || hi2c->host_busy || hi2c->host_pending)
+    {
+        return HAL_BUSY;
+    }
+    hi2c->host_busy = 1;
+    hi2c->host_read = read;
+    hi2c->host_addr = (uint8_t)(DevAddress >> 1);
+    hi2c->host_frame = frame;
+    hi2c->host_data = pData;
+    hi2c->host_len = Size;
+    hi2c->host_us_left = host_i2c_duration_us(hi2c, Size);
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    i2c_current[index] = host_i2c_log_start(hi2c->host_addr, read, frame, pData, Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+    int index = host_i2c_index(hi2c);
+    hi2c->host_inited = 1;
+    hi2c->host_busy = 0;
+    hi2c->host_pending = 0;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    i2c_current[index] = NULL;
+    host_i2c_inits++;
+    if (host_in_isr)
+    {
+        host_i2c_init_in_isr = 1;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+    host_i2c_index(hi2c);
+    hi2c->host_inited = 0;
+    hi2c->host_busy = 0;
+    hi2c->host_pending = 0;
+    if (host_in_isr)
+    {
+        host_i2c_init_in_isr = 1;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout)
+{
+    host_i2c_index(hi2c);
+    if (!hi2c->host_inited || hi2c->host_busy)
+    {
+        return HAL_BUSY;
+    }
+    uint8_t addr = (uint8_t)(DevAddress >> 1);
+    HOST_I2cXfer *log = host_i2c_log_start(addr, 0, I2C_HOST_FULL_FRAME, pData, Size);
+    if (host_i2c_hang)
+    {
+        HOST_Advance_us(Timeout * 1000u);
+        hi2c->ErrorCode = HAL_I2C_ERROR_TIMEOUT;
+        if (log != NULL)
+        {
+            log->end_us = now_us;
+            log->error = hi2c->ErrorCode;
+        }
+        return HAL_TIMEOUT;
+    }
+
+    uint32_t duration = host_i2c_duration_us(hi2c, Size);
+    host_i2c_busy_us += duration;
+    HOST_Advance_us(duration);
+    hi2c->ErrorCode = host_i2c_device_xfer(addr, 0, pData, Size);
+    if (log != NULL)
+    {
+        log->end_us = now_us;
+        log->error = hi2c->ErrorCode;
+    }
+    return (hi2c->ErrorCode == HAL_I2C_ERROR_NONE) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return host_i2c_start_it(hi2c, DevAddress, pData, Size, 0, I2C_HOST_FULL_FRAME);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return host_i2c_start_it(hi2c, DevAddress, pData, Size, 1, I2C_HOST_FULL_FRAME);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                 uint16_t Size, uint32_t XferOptions)
+{
+    return host_i2c_start_it(hi2c, DevAddress, pData, Size, 0, XferOptions);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                uint16_t Size, uint32_t XferOptions)
+{
+    return host_i2c_start_it(hi2c, DevAddress, pData, Size, 1, XferOptions);
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->ErrorCode;
+}
+
+
+/* ---------------------------------------------------------------- PWR / RTC */
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry)
+{
+    (void)Regulator;
+    (void)STOPEntry;
+    host_stop_count++;
+    // EXTI->PR은 1을 써서 지우는 레지스터인데 쓰기를 가로챌 수 없으므로, STOP에 들어갈 때 대기 중인 라인이 없는 것으로 봄
+    // (외부 신호로 깨우는 상황은 host_stop_hook이 EXTI->PR에 해당 라인을 설정)
+    EXTI->PR = 0;
+    if (host_stop_hook != NULL)
+    {
+        host_stop_hook();
+    }
+    else if (host_rtc_wakeup_counts != 0)
+    {
+        // 코어와 주변장치 클럭이 멈추므로 RTC만 진행
+        rtc_us += (uint64_t)host_rtc_wakeup_counts * 16u * 1000000u / 32768u;
+        now_us += (uint64_t)host_rtc_wakeup_counts * 16u * 1000000u / 32768u;
+    }
+    // 깨어나면 HSI로 동작
+    host_rcc_sysclk = HOST_HSI_CLOCK_HZ;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    uint32_t ms = (uint32_t)((rtc_us / 1000u) % (24u * 60u * 60u * 1000u));
+    sTime->Hours = (uint8_t)(ms / 3600000u);
+    sTime->Minutes = (uint8_t)(ms / 60000u % 60u);
+    sTime->Seconds = (uint8_t)(ms / 1000u % 60u);
+    sTime->SecondFraction = 255;
+    sTime->SubSeconds = 255 - (ms % 1000u) * 256u / 1000u;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    *sDate = (RTC_DateTypeDef){0};
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_WaitForSynchro(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    host_rtc_masked_calls += (host_primask != 0);
+    HOST_Advance_us(2 * 1000000u / 32768u + 1);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef *hrtc, uint32_t WakeUpCounter, uint32_t WakeUpClock)
+{
+    (void)hrtc;
+    (void)WakeUpClock;
+    host_rtc_masked_calls += (host_primask != 0);
+    host_rtc_wakeup_counts = WakeUpCounter + 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_DeactivateWakeUpTimer(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    host_rtc_masked_calls += (host_primask != 0);
+    host_rtc_wakeup_counts = 0;
+    return HAL_OK;
+}
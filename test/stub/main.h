@@ -0,0 +1,47 @@
+/*
+ * main.h (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * CubeMX가 생성하는 main.h 대신 사용 (시뮬레이션 HAL 헤더와 보드 핀 정의)
+ * 세그먼트 핀은 포트 두 개에 나눠 배치해서 seg7array의 포트별 BSRR 테이블을 모두 사용함
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include "stm32f4xx_hal.h"
+
+#define Speaker_Pin GPIO_PIN_1
+#define Speaker_GPIO_Port GPIOA
+
+#define SEGa_Pin GPIO_PIN_6
+#define SEGa_GPIO_Port GPIOA
+#define SEGb_Pin GPIO_PIN_7
+#define SEGb_GPIO_Port GPIOA
+#define SEGc_Pin GPIO_PIN_8
+#define SEGc_GPIO_Port GPIOA
+#define SEGd_Pin GPIO_PIN_9
+#define SEGd_GPIO_Port GPIOA
+#define SEGe_Pin GPIO_PIN_0
+#define SEGe_GPIO_Port GPIOB
+#define SEGf_Pin GPIO_PIN_1
+#define SEGf_GPIO_Port GPIOB
+#define SEGg_Pin GPIO_PIN_2
+#define SEGg_GPIO_Port GPIOB
+#define SEGp_Pin GPIO_PIN_10
+#define SEGp_GPIO_Port GPIOB
+
+#define SEG1_Pin GPIO_PIN_12
+#define SEG1_GPIO_Port GPIOB
+#define SEG2_Pin GPIO_PIN_13
+#define SEG2_GPIO_Port GPIOB
+#define SEG3_Pin GPIO_PIN_14
+#define SEG3_GPIO_Port GPIOB
+#define SEG4_Pin GPIO_PIN_15
+#define SEG4_GPIO_Port GPIOB
+
+void Error_Handler(void);
+
+#endif /* __MAIN_H */
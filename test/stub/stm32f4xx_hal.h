@@ -0,0 +1,641 @@
+/*
+ * stm32f4xx_hal.h (PC 빌드용)
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * 드라이버를 PC에서 그대로 빌드하기 위한 HAL/CMSIS 대체 헤더
+ *   - 주변장치 레지스터는 일반 메모리 구조체 (이름과 배치는 CMSIS와 같음)
+ *   - HAL 함수와 시간 흐름(UART 바이트 시간, I²C 트랜잭션, 타이머, SysTick)은 hal_stub.c의 시뮬레이션 모델
+ *   - 드라이버가 사용하는 심볼만 정의하며, HOST_ 로 시작하는 함수는 테스트에서 시뮬레이션을 조작하는 용도
+ */
+
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define __IO volatile
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+#define TICK_INT_PRIORITY 15U
+
+#define HOST_CPU_CLOCK_HZ 84000000U  // 시뮬레이션의 기본 코어 클럭 (SystemClock_Config 이후)
+#define HOST_HSI_CLOCK_HZ 16000000U  // STOP 모드에서 깨어난 직후의 클럭
+
+
+/* ---------------------------------------------------------------- Cortex-M4 코어 */
+
+typedef enum {
+    SysTick_IRQn = -1,
+    EXTI0_IRQn = 6,
+    EXTI1_IRQn = 7,
+    EXTI2_IRQn = 8,
+    EXTI3_IRQn = 9,
+    EXTI4_IRQn = 10,
+    EXTI9_5_IRQn = 23,
+    USART2_IRQn = 38,
+    EXTI15_10_IRQn = 40
+} IRQn_Type;
+
+// PRIMASK: 1이면 인터럽트(시뮬레이션 콜백)가 미뤄지고, 0으로 돌아오는 순간 대기 중인 콜백이 호출됨 (보드와 같음)
+extern volatile uint32_t host_primask;
+void HOST_Deliver(void);
+
+static inline uint32_t __get_PRIMASK(void) { return host_primask; }
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    host_primask = primask & 1U;
+    if (host_primask == 0U)
+    {
+        HOST_Deliver();
+    }
+}
+static inline void __disable_irq(void) { host_primask = 1U; }
+static inline void __enable_irq(void) { __set_PRIMASK(0U); }
+#define __DSB() ((void)0)
+#define __ISB() ((void)0)
+void __WFI(void);
+
+// Cortex-M4 DSP 명령 (SPEAKER_DDS_USE_SMLAD 경로를 PC에서 실행하기 위한 C 구현, 결과는 같고 속도는 비교용이 아님)
+static inline uint32_t __PKHBT(uint32_t a, uint32_t b, uint32_t shift)
+{
+    return (a & 0x0000FFFFU) | ((b << shift) & 0xFFFF0000U);
+}
+static inline uint32_t __SMLAD(uint32_t x, uint32_t y, uint32_t acc)
+{
+    return (uint32_t)((int32_t)acc + (int16_t)(x & 0xFFFFU) * (int16_t)(y & 0xFFFFU) +
+                      (int16_t)(x >> 16) * (int16_t)(y >> 16));
+}
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __IO uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_COUNTFLAG_Msk (1UL << 16U)
+#define SysTick_CTRL_CLKSOURCE_Msk (1UL << 2U)
+#define SysTick_CTRL_TICKINT_Msk (1UL << 1U)
+#define SysTick_CTRL_ENABLE_Msk (1UL)
+#define SysTick_LOAD_RELOAD_Msk (0xFFFFFFUL)
+
+typedef struct {
+    __IO uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Msk (1UL << 26U)
+#define SCB_SCR_SLEEPDEEP_Msk (1UL << 2U)
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL)
+
+typedef struct {
+    __IO uint32_t DHCSR;
+    __IO uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24U)
+
+extern SysTick_Type host_systick;
+extern SCB_Type host_scb;
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_coredebug;
+#define SysTick (&host_systick)
+#define SCB (&host_scb)
+#define DWT (&host_dwt)
+#define CoreDebug (&host_coredebug)
+
+extern uint32_t SystemCoreClock;
+void SystemCoreClockUpdate(void);
+
+
+/* ---------------------------------------------------------------- HAL 공통 */
+
+extern __IO uint32_t uwTick;
+extern uint32_t uwTickPrio;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+
+/* ---------------------------------------------------------------- GPIO / EXTI */
+
+typedef struct {
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT 0x00000000U
+#define GPIO_MODE_OUTPUT_PP 0x00000001U
+#define GPIO_MODE_OUTPUT_OD 0x00000011U
+#define GPIO_NOPULL 0x00000000U
+#define GPIO_PULLUP 0x00000001U
+#define GPIO_SPEED_FREQ_LOW 0x00000000U
+
+#define HOST_GPIO_PORTS 4  // A, B, C, H
+extern GPIO_TypeDef host_gpio[HOST_GPIO_PORTS];
+#define GPIOA (&host_gpio[0])
+#define GPIOB (&host_gpio[1])
+#define GPIOC (&host_gpio[2])
+#define GPIOH (&host_gpio[3])
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+typedef struct {
+    __IO uint32_t IMR;
+    __IO uint32_t EMR;
+    __IO uint32_t RTSR;
+    __IO uint32_t FTSR;
+    __IO uint32_t SWIER;
+    __IO uint32_t PR;
+} EXTI_TypeDef;
+
+typedef struct {
+    __IO uint32_t MEMRMP;
+    __IO uint32_t PMC;
+    __IO uint32_t EXTICR[4];
+} SYSCFG_TypeDef;
+
+extern EXTI_TypeDef host_exti;
+extern SYSCFG_TypeDef host_syscfg;
+#define EXTI (&host_exti)
+#define SYSCFG (&host_syscfg)
+
+#define __HAL_GPIO_EXTI_CLEAR_IT(__EXTI_LINE__) (EXTI->PR = (__EXTI_LINE__))
+
+
+/* ---------------------------------------------------------------- DMA */
+
+typedef struct {
+    __IO uint32_t CR;
+    __IO uint32_t NDTR;
+    __IO uint32_t PAR;
+    __IO uint32_t M0AR;
+    __IO uint32_t M1AR;
+    __IO uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    DMA_Stream_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__) ((__HANDLE__)->Instance->NDTR)
+
+extern DMA_Stream_TypeDef host_dma1_stream5;
+#define DMA1_Stream5 (&host_dma1_stream5)  // USART2_RX
+
+
+/* ---------------------------------------------------------------- UART */
+
+typedef struct {
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+extern USART_TypeDef host_usart2;
+#define USART2 (&host_usart2)
+
+#define UART_FLAG_TC 0x00000040U
+
+#define HAL_UART_ERROR_NONE 0x00000000U
+#define HAL_UART_ERROR_PE 0x00000001U
+#define HAL_UART_ERROR_NE 0x00000002U
+#define HAL_UART_ERROR_FE 0x00000004U
+#define HAL_UART_ERROR_ORE 0x00000008U
+#define HAL_UART_ERROR_DMA 0x00000010U
+
+typedef enum {
+    HAL_UART_STATE_RESET = 0x00U,
+    HAL_UART_STATE_READY = 0x20U,
+    HAL_UART_STATE_BUSY_RX = 0x22U,
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+#define HOST_UART_LINE_SIZE 4096  // 선로에서 도착을 기다릴 수 있는 수신 바이트 수 (HOST_UART_Feed)
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    __IO HAL_UART_StateTypeDef RxState;
+    __IO uint32_t ErrorCode;
+
+    // 시뮬레이션 상태 (hal_stub.c)
+    const uint8_t *host_tx_data;  // 진행 중인 DMA 송신 (NULL이면 쉬는 중)
+    uint16_t host_tx_len;
+    uint16_t host_tx_sent;        // 선로로 나간 바이트 수
+    uint64_t host_tx_bit_acc;     // 바이트 시간 계산용 누적값 (us * baud)
+    uint8_t host_tx_pending;      // 인터럽트 차단 중에 끝난 송신 (풀리면 TxCplt 콜백)
+    uint8_t *host_rx_data;        // HAL_UART_Receive_IT / HAL_UARTEx_ReceiveToIdle_DMA로 받은 수신 버퍼
+    uint16_t host_rx_len;
+    uint8_t host_rx_dma;          // 1이면 circular DMA 수신 (NDTR은 hdmarx->Instance)
+    uint8_t host_rx_line[HOST_UART_LINE_SIZE];
+    uint16_t host_rx_line_head;   // 선로 큐: head에 넣고 tail부터 바이트 시간마다 도착
+    uint16_t host_rx_line_tail;
+    uint64_t host_rx_bit_acc;
+    uint8_t host_rx_idle;         // 바이트가 도착한 뒤 아직 IDLE 라인이 아님
+    uint8_t host_rx_dr_full;      // IT 수신: 인터럽트가 아직 읽지 않은 바이트가 DR에 있음
+    uint8_t host_rx_dr;
+    uint8_t host_rx_events;       // DMA 수신: 인터럽트 차단 중에 생긴 half/full/IDLE 이벤트
+    uint32_t host_rx_error;       // 인터럽트 차단 중에 생긴 HAL_UART_ERROR_* (풀리면 ErrorCallback)
+} UART_HandleTypeDef;
+
+#define __HAL_UART_GET_FLAG(__HANDLE__, __FLAG__) ((((__HANDLE__)->Instance->SR) & (__FLAG__)) == (__FLAG__))
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+
+/* ---------------------------------------------------------------- TIM */
+
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+} TIM_TypeDef;
+
+extern TIM_TypeDef host_tim2, host_tim3, host_tim4, host_tim5, host_tim9, host_tim10, host_tim11;
+#define TIM2 (&host_tim2)
+#define TIM3 (&host_tim3)
+#define TIM4 (&host_tim4)
+#define TIM5 (&host_tim5)
+#define TIM9 (&host_tim9)
+#define TIM10 (&host_tim10)
+#define TIM11 (&host_tim11)
+
+#define IS_TIM_32B_COUNTER_INSTANCE(INSTANCE) (((INSTANCE) == TIM2) || ((INSTANCE) == TIM5))
+
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CHANNEL_3 0x00000008U
+#define TIM_CHANNEL_4 0x0000000CU
+
+typedef enum {
+    HAL_TIM_ACTIVE_CHANNEL_1 = 0x01U,
+    HAL_TIM_ACTIVE_CHANNEL_2 = 0x02U,
+    HAL_TIM_ACTIVE_CHANNEL_3 = 0x04U,
+    HAL_TIM_ACTIVE_CHANNEL_4 = 0x08U,
+    HAL_TIM_ACTIVE_CHANNEL_CLEARED = 0x00U
+} HAL_TIM_ActiveChannel;
+
+#define TIM_CR1_CEN 0x0001U
+#define TIM_DIER_UIE 0x0001U
+#define TIM_DIER_CC1IE 0x0002U
+#define TIM_FLAG_UPDATE 0x0001U
+#define TIM_EVENTSOURCE_UPDATE 0x0001U
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct __TIM_HandleTypeDef {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+    HAL_TIM_ActiveChannel Channel;
+
+    // 시뮬레이션 상태 (hal_stub.c)
+    uint64_t host_clock_acc;      // 카운터 클럭 계산용 누적값
+    uint8_t host_pending;         // 아직 콜백을 호출하지 않은 이벤트 (bit0: update, bit1~4: 비교 채널 1~4)
+    const uint32_t *host_dma_data;  // HAL_TIM_PWM_Start_DMA로 받은 버퍼 (순환 모드)
+    uint16_t host_dma_len;
+} TIM_HandleTypeDef;
+
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+    do { (__HANDLE__)->Instance->ARR = (__AUTORELOAD__); (__HANDLE__)->Init.Period = (__AUTORELOAD__); } while (0)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__) ((__HANDLE__)->Instance->ARR)
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+    (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)) = (__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)))
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __COUNTER__) ((__HANDLE__)->Instance->CNT = (__COUNTER__))
+#define __HAL_TIM_GET_COUNTER(__HANDLE__) ((__HANDLE__)->Instance->CNT)
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PRESC__) ((__HANDLE__)->Instance->PSC = (__PRESC__))
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__) ((__HANDLE__)->Instance->SR = ~(__FLAG__))
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_OC_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_OC_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim);
+
+
+/* ---------------------------------------------------------------- I2C */
+
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t OAR1;
+    __IO uint32_t OAR2;
+    __IO uint32_t DR;
+    __IO uint32_t SR1;
+    __IO uint32_t SR2;
+    __IO uint32_t CCR;
+    __IO uint32_t TRISE;
+    __IO uint32_t FLTR;
+} I2C_TypeDef;
+
+extern I2C_TypeDef host_i2c1;
+#define I2C1 (&host_i2c1)
+
+#define HAL_I2C_ERROR_NONE 0x00000000U
+#define HAL_I2C_ERROR_BERR 0x00000001U
+#define HAL_I2C_ERROR_ARLO 0x00000002U
+#define HAL_I2C_ERROR_AF 0x00000004U
+#define HAL_I2C_ERROR_OVR 0x00000008U
+#define HAL_I2C_ERROR_TIMEOUT 0x00000020U
+
+#define I2C_FIRST_FRAME 0x00000001U
+#define I2C_LAST_FRAME 0x00000020U
+#define I2C_HOST_FULL_FRAME 0x00000000U  // Seq가 아닌 일반 전송 (시뮬레이션 로그용)
+
+typedef struct {
+    uint32_t ClockSpeed;
+    uint32_t DutyCycle;
+    uint32_t OwnAddress1;
+    uint32_t AddressingMode;
+} I2C_InitTypeDef;
+
+typedef struct __I2C_HandleTypeDef {
+    I2C_TypeDef *Instance;
+    I2C_InitTypeDef Init;
+    __IO uint32_t ErrorCode;
+
+    // 시뮬레이션 상태 (hal_stub.c)
+    uint8_t host_busy;            // IT 전송 진행 중
+    uint8_t host_read;
+    uint8_t host_addr;            // 7비트 주소
+    uint32_t host_frame;
+    uint8_t *host_data;
+    uint16_t host_len;
+    uint32_t host_us_left;        // 전송이 끝날 때까지 남은 시간
+    uint8_t host_pending;         // 인터럽트 차단 중에 끝난 전송 (풀리면 완료/오류 콜백)
+    uint8_t host_inited;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                 uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                                uint16_t Size, uint32_t XferOptions);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+
+/* ---------------------------------------------------------------- PWR / RTC */
+
+#define PWR_MAINREGULATOR_ON 0x00000000U
+#define PWR_LOWPOWERREGULATOR_ON 0x00000001U
+#define PWR_STOPENTRY_WFI ((uint8_t)0x01)
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry);
+
+typedef struct {
+    uint32_t HourFormat;
+    uint32_t AsynchPrediv;
+    uint32_t SynchPrediv;
+} RTC_InitTypeDef;
+
+typedef struct {
+    RTC_InitTypeDef Init;
+} RTC_HandleTypeDef;
+
+typedef struct {
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Seconds;
+    uint8_t TimeFormat;
+    uint32_t SubSeconds;
+    uint32_t SecondFraction;
+} RTC_TimeTypeDef;
+
+typedef struct {
+    uint8_t WeekDay;
+    uint8_t Month;
+    uint8_t Date;
+    uint8_t Year;
+} RTC_DateTypeDef;
+
+#define RTC_FORMAT_BIN 0x00000000U
+#define RTC_WAKEUPCLOCK_RTCCLK_DIV16 0x00000000U
+
+#define __HAL_RTC_WRITEPROTECTION_DISABLE(__HANDLE__) ((void)(__HANDLE__))
+#define __HAL_RTC_WRITEPROTECTION_ENABLE(__HANDLE__) ((void)(__HANDLE__))
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_WaitForSynchro(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef *hrtc, uint32_t WakeUpCounter, uint32_t WakeUpClock);
+HAL_StatusTypeDef HAL_RTCEx_DeactivateWakeUpTimer(RTC_HandleTypeDef *hrtc);
+
+
+/* ---------------------------------------------------------------- 시뮬레이션 조작 (테스트 전용) */
+
+// 시뮬레이션 시간 (us), 주변장치 상태, 로그를 모두 처음 상태로 되돌림
+void HOST_Reset(void);
+
+// 시뮬레이션 시간을 us만큼 진행
+// SysTick(uwTick, DWT->CYCCNT), 시작된 타이머, UART 송신, I²C 전송이 함께 진행되고
+// 인터럽트에 해당하는 HAL 콜백은 PRIMASK가 0일 때만 호출됨 (차단 중에 생긴 이벤트는 풀린 뒤 호출)
+void HOST_Advance_us(uint32_t us);
+uint64_t HOST_Now_us(void);
+extern uint32_t host_tim_irqs;  // 타이머 콜백 (PeriodElapsed, OC DelayElapsed) 횟수
+// HOST_Advance_us가 1us마다 주변장치를 진행한 뒤 호출 (정한 시각에 UART 입력 등을 넣을 때, 안에서 시간을 진행하면 안 됨)
+extern void (*host_step_hook)(void);
+
+// WFI/STOP 모드에서 일어날 일을 테스트가 정함 (NULL이면 WFI는 1us 진행, STOP은 RTC 깨우기 타이머만큼 진행)
+// SysTick->CTRL에 쓰면 COUNTFLAG도 지워지므로 (보드는 읽을 때만 지움), tickless SLEEP은 다른 인터럽트로 일찍 깨어나는 경우만 정확함
+extern void (*host_wfi_hook)(void);
+extern void (*host_stop_hook)(void);
+uint8_t HOST_Irq_pending(void);  // PRIMASK 때문에 미뤄진 인터럽트가 있으면 1 (WFI 훅이 다음 인터럽트까지 진행할 때)
+extern uint32_t host_stop_count;
+extern uint32_t host_rcc_sysclk;  // SystemCoreClockUpdate가 읽어가는 현재 시스템 클럭 (STOP에서 깨어나면 HSI)
+
+// GPIO: BSRR에 쓴 값을 ODR에 반영하고, 바뀐 출력을 시각과 함께 기록
+// (HAL_GPIO_*, HAL_Delay, HOST_Advance_us가 자동으로 호출하며, BSRR을 직접 쓴 직후 값을 보려면 테스트가 호출)
+// 레지스터 쓰기를 가로챌 수 없으므로, 동기화 사이에 같은 포트의 BSRR에 여러 번 쓰면 마지막 값만 반영됨
+typedef struct {
+    uint64_t us;
+    uint8_t port;       // 0: A, 1: B, 2: C, 3: H
+    uint16_t odr;
+} HOST_GpioEvent;
+
+#define HOST_GPIO_LOG_SIZE 4096
+extern HOST_GpioEvent host_gpio_log[HOST_GPIO_LOG_SIZE];
+extern uint32_t host_gpio_log_count;
+extern uint32_t host_gpio_hal_calls;  // HAL_GPIO_WritePin/ReadPin 호출 횟수
+void HOST_GPIO_Sync(void);
+
+// UART: 선로로 나간 바이트 (보드레이트에 맞춰 10비트/바이트로 진행)
+#define HOST_UART_CAPTURE_SIZE (1024 * 1024)
+extern uint8_t host_uart_capture[HOST_UART_CAPTURE_SIZE];
+extern uint32_t host_uart_capture_len;
+extern uint32_t host_uart_tx_irqs;
+
+// UART 수신: 선로에 올린 바이트는 보드레이트에 맞춰 한 바이트씩 도착
+//   - IT 수신 (HAL_UART_Receive_IT): 바이트마다 RxCplt 인터럽트, 인터럽트가 DR을 읽기 전에 다음 바이트가 오면 overrun
+//   - circular DMA 수신 (HAL_UARTEx_ReceiveToIdle_DMA): DMA가 NDTR을 줄이며 버퍼에 쓰고,
+//     버퍼 절반/끝과 IDLE 라인(한 바이트 시간 동안 다음 바이트가 없음)에서 RxEvent 인터럽트
+//   - 수신을 시작하지 않았거나 overrun으로 잃은 바이트는 host_uart_rx_lost에 더함
+extern uint32_t host_uart_rx_irqs;   // RxCplt/RxEvent/Error 콜백 횟수
+extern uint32_t host_uart_rx_lost;
+void HOST_UART_Feed(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);     // 선로에 올리고 바로 반환
+void HOST_UART_Receive(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);  // 모두 도착하고 IDLE이 될 때까지 진행
+// 수신 오류 인터럽트: FE/NE/PE는 수신을 계속하고, ORE와 DMA 오류는 수신을 중단(RxState = READY)한 뒤 ErrorCallback
+void HOST_UART_RxError(UART_HandleTypeDef *huart, uint32_t error);
+
+// I²C: 트랜잭션 로그와 슬레이브 장치 모델
+typedef struct {
+    uint64_t start_us;
+    uint64_t end_us;
+    uint8_t addr;       // 7비트 주소
+    uint8_t read;
+    uint32_t frame;     // I2C_FIRST_FRAME 등 (일반 전송은 I2C_HOST_FULL_FRAME)
+    uint16_t len;
+    uint8_t data[32];   // 앞쪽 32바이트
+    uint32_t error;     // HAL_I2C_ERROR_*
+} HOST_I2cXfer;
+
+#define HOST_I2C_LOG_SIZE 1024
+extern HOST_I2cXfer host_i2c_log[HOST_I2C_LOG_SIZE];
+extern uint32_t host_i2c_log_count;
+extern uint64_t host_i2c_busy_us;   // 버스가 전송 중이던 시간의 합
+extern uint32_t host_i2c_irqs;
+extern uint32_t host_i2c_inits;     // HAL_I2C_Init 호출 횟수 (버스 복구 확인용)
+extern uint8_t host_i2c_init_in_isr;  // 인터럽트 콜백 안에서 HAL_I2C_Init/DeInit이 호출된 적이 있으면 1
+
+// 장치 하나: 첫 쓰기 바이트가 레지스터 주소, 이후 쓰기/읽기는 레지스터를 하나씩 진행
+typedef struct {
+    uint8_t present;
+    uint8_t reg;
+    uint8_t mem[256];
+} HOST_I2cDevice;
+
+extern HOST_I2cDevice host_i2c_dev[128];
+extern uint32_t host_i2c_fail_next;  // 0이 아니면 다음 IT 전송을 이 오류로 끝냄
+extern uint8_t host_i2c_hang;        // 1이면 IT 전송이 끝나지 않음 (SDA가 잡힌 상황)
+
+// 인터럽트 콜백 안에서 실행 중이면 1
+extern uint8_t host_in_isr;
+
+// RTC 깨우기 타이머 (RTCCLK/16 카운트, 0이면 꺼짐)
+extern uint32_t host_rtc_wakeup_counts;
+// HAL_GetTick으로 타임아웃을 재는 RTC 함수(깨우기 타이머 설정/해제, 동기화 대기)를 인터럽트 차단 중에 호출한 횟수
+// (보드에서는 tick이 멈춰 있어 플래그가 서지 않으면 끝나지 않음, 동기화 대기는 RTCCLK 2주기 동안 진행)
+extern uint32_t host_rtc_masked_calls;
+
+#endif /* STM32F4XX_HAL_H */
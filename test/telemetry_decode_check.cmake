@@ -0,0 +1,42 @@
+# telemetry_decode_check.cmake
+#   test_telem이 저장한 UART 출력(U2C_send_frame 프레임 + 콘솔 텍스트)을 Tools/telemetry_decode.py로 풀어서 확인
+#   cmake -DTEST_TELEM=<실행 파일> -DPYTHON=<python3> -DDECODER=<telemetry_decode.py> -DWORK_DIR=<디렉터리> -P telemetry_decode_check.cmake
+
+set(capture ${WORK_DIR}/telem_capture.bin)
+set(csv ${WORK_DIR}/telem_capture.csv)
+
+execute_process(COMMAND ${TEST_TELEM} ${capture} RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "test_telem failed: ${result}")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${DECODER} ${capture} --csv ${csv} --quiet
+                RESULT_VARIABLE result ERROR_VARIABLE console)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "telemetry_decode.py failed: ${result}\n${console}")
+endif()
+
+# 콘솔 텍스트는 stderr로 그대로, 요약에는 빠진 레코드가 없어야 함
+foreach(expected "console before" "console between" "# 5 records, 0 lost")
+    string(FIND "${console}" "${expected}" pos)
+    if(pos EQUAL -1)
+        message(FATAL_ERROR "decoder stderr has no '${expected}':\n${console}")
+    endif()
+endforeach()
+
+file(STRINGS ${csv} lines)
+list(LENGTH lines count)
+if(NOT count EQUAL 6)
+    message(FATAL_ERROR "expected header + 5 records, got ${count} lines")
+endif()
+list(GET lines 0 header)
+if(NOT header STREQUAL "seq,overruns,tick,temp,adc,gain")
+    message(FATAL_ERROR "unexpected header: ${header}")
+endif()
+foreach(i RANGE 1 5)
+    list(GET lines ${i} line)
+    math(EXPR seq "${i} - 1")
+    if(NOT line MATCHES "^${seq},0,[0-9]+,-5,1000 2000,1\\.5$")
+        message(FATAL_ERROR "unexpected record ${i}: ${line}")
+    endif()
+endforeach()
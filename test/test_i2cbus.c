@@ -0,0 +1,230 @@
+/*
+ * test_i2cbus.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * i2cbus: 두 장치가 버스를 나눠 쓸 때 우선순위 순서와 대기 시간/사용률, 버스 오류/타임아웃 복구가 I2CBUS_Task에서 일어나는지
+ * (i2cbus 상태는 테스트끼리 이어지므로 각 테스트는 큐가 빌 때까지 기다림)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "i2cbus.h"
+
+#define SENSOR_ADDR 0x48
+#define DISPLAY_ADDR 0x3C
+
+static I2CBUS_Result results[8];
+static int result_count = 0;
+static uint8_t in_isr_at_callback = 0;
+
+static void record(I2CBUS_Result result, void *context)
+{
+    if (result_count < (int)(sizeof(results) / sizeof(results[0])))
+    {
+        results[result_count++] = result;
+    }
+    in_isr_at_callback |= host_in_isr;
+}
+
+// I2CBUS_Task를 주기마다 호출하면서 큐가 빌 때까지 진행
+static void run_until_idle(void)
+{
+    for (int i = 0; i < 100 && I2CBUS_IsBusy(); i++)
+    {
+        HOST_Advance_us(I2CBUS_TASK_PERIOD_MS * 1000);
+        I2CBUS_Task();
+    }
+    CHECK(!I2CBUS_IsBusy());
+}
+
+static void setup(void)
+{
+    memset(host_i2c_dev, 0, sizeof(host_i2c_dev));
+    host_i2c_dev[SENSOR_ADDR].present = 1;
+    host_i2c_dev[DISPLAY_ADDR].present = 1;
+    I2CBUS_Init(&hi2c1);
+    I2CBUS_ResetStats();
+    result_count = 0;
+    in_isr_at_callback = 0;
+}
+
+static void test_high_priority_device_goes_next(void)
+{
+    static const uint8_t line[3][9] = {"@line 1", "@line 2", "@line 3"};
+    static const uint8_t reg = 0x10;
+    uint8_t raw[2] = {0};
+
+    setup();
+    host_i2c_dev[SENSOR_ADDR].mem[0x10] = 0x12;
+    host_i2c_dev[SENSOR_ADDR].mem[0x11] = 0x34;
+
+    // 표시 장치의 낮은 우선순위 쓰기 3개 뒤에 센서 읽기를 요청: 진행 중인 첫 쓰기 다음에 바로 실행
+    uint32_t base = host_i2c_log_count;
+    uint64_t busy_base = host_i2c_busy_us;
+    uint64_t t0 = HOST_Now_us();
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK_EQ(I2CBUS_Write(DISPLAY_ADDR, line[i], 8, I2CBUS_PRIO_LOW, record, NULL), HAL_OK);
+    }
+    uint64_t high_submit_us = HOST_Now_us();
+    CHECK_EQ(I2CBUS_WriteRead(SENSOR_ADDR, &reg, 1, raw, 2, I2CBUS_PRIO_HIGH, record, NULL), HAL_OK);
+    run_until_idle();
+
+    CHECK_EQ(host_i2c_log_count - base, 5);
+    const HOST_I2cXfer *x = &host_i2c_log[base];
+    CHECK_EQ(x[0].addr, DISPLAY_ADDR);
+    CHECK_EQ(x[0].data[6], '1');
+    CHECK_EQ(x[1].addr, SENSOR_ADDR);   // 쓰기 단계 (STOP 없음)
+    CHECK_EQ(x[1].frame, I2C_FIRST_FRAME);
+    CHECK_EQ(x[2].addr, SENSOR_ADDR);   // 반복 시작 조건으로 읽기
+    CHECK_EQ(x[2].read, 1);
+    CHECK_EQ(x[2].frame, I2C_LAST_FRAME);
+    CHECK_EQ(x[3].data[6], '2');
+    CHECK_EQ(x[4].data[6], '3');
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(x[i + 1].start_us >= x[i].end_us);  // 한 번에 트랜잭션 하나
+    }
+
+    CHECK_EQ(raw[0], 0x12);
+    CHECK_EQ(raw[1], 0x34);
+    CHECK_EQ(result_count, 4);
+    CHECK_EQ(results[1], I2CBUS_OK);
+
+    I2CBUS_Stats stats;
+    I2CBUS_GetStats(&stats);
+    CHECK_EQ(stats.completed, 4);
+    CHECK_EQ(stats.bytes, 3 * 9 + 1 + 2 + 2);
+    CHECK_EQ(stats.max_depth[I2CBUS_PRIO_LOW], 3);
+    CHECK_EQ(stats.recoveries, 0);
+
+    // HIGH 요청은 진행 중인 LOW 쓰기 하나만 기다림 (큐 대기 시간은 ms 단위라서 실제 값은 로그의 us로 확인)
+    uint64_t high_wait_us = x[1].start_us - high_submit_us;
+    uint64_t elapsed_us = x[4].end_us - t0;
+    CHECK(high_wait_us <= x[0].end_us - x[0].start_us);
+    printf("queue wait: max %lu ms, total %lu ms over %lu xfers; HIGH request waited %lu us (one LOW write %lu us)\n",
+           (unsigned long)stats.max_wait_ms, (unsigned long)stats.total_wait_ms, (unsigned long)stats.completed,
+           (unsigned long)high_wait_us, (unsigned long)(x[0].end_us - x[0].start_us));
+    // 다음 트랜잭션은 완료 인터럽트에서 바로 시작하므로 버스트 동안은 빈틈이 없어야 함
+    uint64_t busy_us = host_i2c_busy_us - busy_base;
+    CHECK_EQ(busy_us, elapsed_us);
+    printf("bus utilisation: %lu us busy / %lu us burst = %.1f%%, / %lu ms since reset = %.1f%%\n",
+           (unsigned long)busy_us, (unsigned long)elapsed_us, 100.0 * (double)busy_us / (double)elapsed_us,
+           (unsigned long)stats.elapsed_ms, 100.0 * (double)busy_us / (stats.elapsed_ms * 1000.0));
+}
+
+static void test_bus_error_recovers_in_task(void)
+{
+    static const uint8_t a[2] = {0x00, 0xAA};
+    static const uint8_t b[2] = {0x00, 0xBB};
+
+    setup();
+    uint32_t inits = host_i2c_inits;
+    uint32_t base = host_i2c_log_count;
+
+    // 첫 트랜잭션이 arbitration lost로 끝남: 콜백은 바로 호출되지만 복구와 다음 트랜잭션은 I2CBUS_Task에서
+    host_i2c_fail_next = HAL_I2C_ERROR_ARLO;
+    CHECK_EQ(I2CBUS_Write(DISPLAY_ADDR, a, 2, I2CBUS_PRIO_LOW, record, NULL), HAL_OK);
+    CHECK_EQ(I2CBUS_Write(SENSOR_ADDR, b, 2, I2CBUS_PRIO_HIGH, record, NULL), HAL_OK);
+    HOST_Advance_us(2000);
+
+    CHECK_EQ(result_count, 1);
+    CHECK_EQ(results[0], I2CBUS_BUS_ERROR);
+    CHECK_EQ(in_isr_at_callback, 1);
+    CHECK_EQ(host_i2c_init_in_isr, 0);
+    CHECK_EQ(host_i2c_inits, inits);
+    CHECK_EQ(host_i2c_log_count - base, 1);  // 복구 전에는 다음 트랜잭션을 시작하지 않음
+    CHECK(I2CBUS_IsBusy());
+
+    I2CBUS_Task();
+    CHECK_EQ(host_i2c_inits, inits + 1);
+    CHECK_EQ(host_i2c_log_count - base, 2);
+    run_until_idle();
+
+    CHECK_EQ(result_count, 2);
+    CHECK_EQ(results[1], I2CBUS_OK);
+    CHECK_EQ(host_i2c_dev[SENSOR_ADDR].mem[0], 0xBB);
+    CHECK_EQ(host_i2c_dev[DISPLAY_ADDR].mem[0], 0x00);
+    CHECK_EQ(host_i2c_init_in_isr, 0);
+
+    I2CBUS_Stats stats;
+    I2CBUS_GetStats(&stats);
+    CHECK_EQ(stats.bus_errors, 1);
+    CHECK_EQ(stats.recoveries, 1);
+    CHECK_EQ(stats.completed, 1);
+}
+
+static void test_timeout_recovers_and_bus_works_again(void)
+{
+    static const uint8_t c[2] = {0x01, 0xCC};
+
+    setup();
+    uint32_t inits = host_i2c_inits;
+
+    // SDA가 잡혀 완료 인터럽트가 오지 않음
+    host_i2c_hang = 1;
+    CHECK_EQ(I2CBUS_Write(DISPLAY_ADDR, c, 2, I2CBUS_PRIO_LOW, record, NULL), HAL_OK);
+    for (int i = 0; i < I2CBUS_TIMEOUT_MS / I2CBUS_TASK_PERIOD_MS + 1; i++)
+    {
+        HOST_Advance_us(I2CBUS_TASK_PERIOD_MS * 1000);
+        I2CBUS_Task();
+    }
+    host_i2c_hang = 0;
+
+    CHECK_EQ(result_count, 1);
+    CHECK_EQ(results[0], I2CBUS_TIMEOUT);
+    CHECK_EQ(in_isr_at_callback, 0);
+    CHECK_EQ(host_i2c_inits, inits + 1);
+    CHECK_EQ(host_i2c_init_in_isr, 0);
+    CHECK(!I2CBUS_IsBusy());
+
+    CHECK_EQ(I2CBUS_Write(DISPLAY_ADDR, c, 2, I2CBUS_PRIO_LOW, record, NULL), HAL_OK);
+    run_until_idle();
+    CHECK_EQ(results[1], I2CBUS_OK);
+    CHECK_EQ(host_i2c_dev[DISPLAY_ADDR].mem[1], 0xCC);
+}
+
+static void test_blocking_write_failure_recovers_in_task(void)
+{
+    static const uint8_t d[2] = {0x02, 0xDD};
+
+    setup();
+    uint32_t inits = host_i2c_inits;
+    uint32_t base = host_i2c_log_count;
+
+    // 임계 구역 안에서 실패해도 인터럽트를 켜지 않고, 복구(HAL_I2C_DeInit/Init)는 I2CBUS_Task에 맡김
+    host_i2c_hang = 1;
+    __disable_irq();
+    CHECK_EQ(I2CBUS_WriteBlocking(DISPLAY_ADDR, d, 2), HAL_TIMEOUT);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    host_i2c_hang = 0;
+    CHECK_EQ(host_i2c_inits, inits);
+
+    // 복구 전에는 새 트랜잭션을 시작하지 않음
+    CHECK_EQ(I2CBUS_Write(DISPLAY_ADDR, d, 2, I2CBUS_PRIO_LOW, record, NULL), HAL_OK);
+    CHECK_EQ(host_i2c_log_count - base, 1);
+    I2CBUS_Task();
+    CHECK_EQ(host_i2c_inits, inits + 1);
+    CHECK_EQ(host_i2c_log_count - base, 2);
+    run_until_idle();
+    CHECK_EQ(results[0], I2CBUS_OK);
+    CHECK_EQ(host_i2c_dev[DISPLAY_ADDR].mem[2], 0xDD);
+
+    I2CBUS_Stats stats;
+    I2CBUS_GetStats(&stats);
+    CHECK_EQ(stats.timeouts, 1);
+    CHECK_EQ(stats.recoveries, 1);
+}
+
+int main(void)
+{
+    RUN_TEST(test_high_priority_device_goes_next);
+    RUN_TEST(test_bus_error_recovers_in_task);
+    RUN_TEST(test_timeout_recovers_and_bus_works_again);
+    RUN_TEST(test_blocking_write_failure_recovers_in_task);
+    return TEST_EXIT();
+}
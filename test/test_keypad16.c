@@ -0,0 +1,320 @@
+/*
+ * test_keypad16.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * keypad16: 열 입력을 바꿔가며 스캔, 인터럽트 구동 방식의 대기(EXTI) ↔ 스캔(타이머) 전환, 스캔 한 번의 비용
+ * (test_keypad16_pins는 KEYPAD16_SAME_PORT=0으로 빌드해서 같은 테스트를 HAL_GPIO 방식의 스캔으로 실행)
+ * 빠른 스캔은 BSRR에 행을 쓰고 곧바로 IDR을 읽으므로 시뮬레이션에서는 행에 따라 열 입력을 바꿀 수 없음
+ * → 열 하나를 LOW로 두면 그 열의 네 키(예: C1 → '1' '4' '7' '*', 비트 0x1111)가 모두 눌린 것으로 읽힘
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "host_test.h"
+#include "keypad16.h"
+#include "perf.h"
+
+#define COL1_KEYS 0x1111u
+
+static void set_col1(int pressed)
+{
+    if (pressed)
+    {
+        C1_PORT->IDR &= ~(uint32_t)C1_PIN;
+    }
+    else
+    {
+        C1_PORT->IDR |= C1_PIN;
+    }
+}
+
+static void test_triggered_key_is_read_once(void)
+{
+    KEYPAD16_Init();
+    set_col1(1);
+    for (int i = 0; i < 8; i++)
+    {
+        KEYPAD16_Scan();
+    }
+
+    // 임계 구역 안에서 읽어도 인터럽트를 다시 켜지 않아야 함
+    __disable_irq();
+    CHECK_EQ(KEYPAD16_Get_Triggered_Key(), '*');
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    CHECK_EQ(KEYPAD16_Get_Triggered_Key(), NO_KEY_PRESSED);
+}
+
+static void test_bounce_is_filtered(void)
+{
+    // 눌림 중 튐: 연속 KEYPAD16_DEBOUNCE_SCANS회 LOW로 읽혀야 눌림으로 인정
+    static const uint8_t bounce[] = {1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 1};
+    KEYPAD16_Event event;
+
+    KEYPAD16_Init();
+    int run = 0;
+    for (size_t i = 0; i < sizeof(bounce); i++)
+    {
+        set_col1(bounce[i]);
+        KEYPAD16_Scan();
+        run = bounce[i] ? run + 1 : 0;
+        CHECK_EQ(KEYPAD16_Get_Key_Bits(), (run >= KEYPAD16_DEBOUNCE_SCANS) ? COL1_KEYS : 0);
+    }
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), 0);  // 마지막 세 번만 LOW
+
+    set_col1(1);
+    KEYPAD16_Scan();
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), COL1_KEYS);
+
+    // 뗄 때의 튐도 같은 방식으로 걸러짐
+    static const uint8_t release[] = {0, 1, 0, 0, 0, 1, 0, 0, 0};
+    for (size_t i = 0; i < sizeof(release); i++)
+    {
+        set_col1(release[i]);
+        KEYPAD16_Scan();
+    }
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), COL1_KEYS);
+    KEYPAD16_Scan();
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), 0);
+
+    // 튀는 동안에는 이벤트가 없고, 키마다 눌림/뗌 한 번씩만 나옴
+    int presses = 0;
+    int releases = 0;
+    while (KEYPAD16_Get_Event(&event))
+    {
+        presses += (event.type == KEYPAD16_EVENT_PRESS);
+        releases += (event.type == KEYPAD16_EVENT_RELEASE);
+    }
+    CHECK_EQ(presses, 4);
+    CHECK_EQ(releases, 4);
+}
+
+static void test_debounce_latency_matches_period(void)
+{
+    // 스캔 직후에 눌리면 KEYPAD16_DEBOUNCE_MS 뒤의 스캔에서 인정됨
+    KEYPAD16_Event event;
+
+    KEYPAD16_Init();
+    KEYPAD16_Scan();
+    uint32_t pressed_at = HAL_GetTick();
+    set_col1(1);
+    while (KEYPAD16_Get_Key_Bits() == 0 && HAL_GetTick() - pressed_at < 1000)
+    {
+        HOST_Advance_us(KEYPAD16_TASK_PERIOD_MS * 1000);  // HAL_Delay는 1ms를 더 기다리므로 시간만 진행
+        KEYPAD16_Task();
+    }
+
+    CHECK(KEYPAD16_Get_Event(&event));
+    CHECK_EQ(event.type, KEYPAD16_EVENT_PRESS);
+    CHECK_EQ(event.tick - pressed_at, KEYPAD16_DEBOUNCE_MS);
+    CHECK_EQ(KEYPAD16_DEBOUNCE_MS, 40);
+}
+
+// 인터럽트 구동 방식: 열 입력이 LOW로 바뀌면 EXTI(Falling edge)가 켜져 있을 때만 콜백 (시뮬레이션은 EXTI를 만들지 않음)
+static void press_col1_it(int pressed)
+{
+    set_col1(pressed);
+    if (pressed)
+    {
+        EXTI->PR |= C1_PIN;
+        if (EXTI->IMR & C1_PIN)
+        {
+            HAL_GPIO_EXTI_Callback(C1_PIN);
+        }
+    }
+}
+
+static uint32_t scan_count(void)
+{
+    PERF_Stats stats;
+    PERF_GetStats(PERF_KEYPAD16_SCAN, &stats);
+    return stats.count;
+}
+
+static uint32_t timer_running(void)
+{
+    return htim9.Instance->CR1 & TIM_CR1_CEN;
+}
+
+static void check_idle(void)
+{
+    CHECK_EQ(KEYPAD16_IsIdle(), 1);
+    CHECK_EQ(EXTI->IMR & KEYPAD16_COL_PINS, KEYPAD16_COL_PINS);
+    CHECK_EQ(timer_running(), 0);
+    CHECK_EQ(R1_PORT->ODR & KEYPAD16_ROW_PINS, 0);  // 모든 행 LOW: 어느 키든 열을 LOW로 만듦
+}
+
+static void test_exti_idle_scan_cycle(void)
+{
+    KEYPAD16_Event event;
+
+    set_col1(0);
+    PERF_Reset();
+    KEYPAD16_Init_IT(&htim9);
+    check_idle();
+
+    // 대기 중에는 스캔하지 않음
+    HOST_Advance_us(200000);
+    CHECK_EQ(scan_count(), 0);
+
+    // 누르면 EXTI로 깨어나 타이머 스캔, 스캔 중에는 EXTI를 끔
+    uint32_t pressed_at = HAL_GetTick();
+    press_col1_it(1);
+    CHECK_EQ(KEYPAD16_IsIdle(), 0);
+    CHECK_EQ(EXTI->IMR & KEYPAD16_COL_PINS, 0);
+    CHECK(timer_running());
+    while (KEYPAD16_Get_Key_Bits() == 0 && HAL_GetTick() - pressed_at < 1000)
+    {
+        HOST_Advance_us(1000);
+    }
+    CHECK(KEYPAD16_Get_Event(&event));
+    CHECK_EQ(event.type, KEYPAD16_EVENT_PRESS);
+    CHECK(event.tick - pressed_at <= KEYPAD16_DEBOUNCE_MS);
+    while (KEYPAD16_Get_Event(&event))
+    {
+    }
+
+    // 누르고 있는 동안은 계속 스캔
+    uint32_t scans = scan_count();
+    HOST_Advance_us(100000);
+    CHECK_EQ(scan_count() - scans, 100 / KEYPAD16_TASK_PERIOD_MS);
+    CHECK_EQ(KEYPAD16_IsIdle(), 0);
+
+    // 떼고 디바운스가 끝나면 다시 대기
+    uint32_t released_at = HAL_GetTick();
+    press_col1_it(0);
+    while (!KEYPAD16_IsIdle() && HAL_GetTick() - released_at < 1000)
+    {
+        HOST_Advance_us(1000);
+    }
+    check_idle();
+    CHECK(KEYPAD16_Get_Event(&event));
+    CHECK_EQ(event.type, KEYPAD16_EVENT_RELEASE);
+    scans = scan_count();
+    HOST_Advance_us(200000);
+    CHECK_EQ(scan_count(), scans);
+}
+
+static void test_exti_press_before_arming_is_not_lost(void)
+{
+    // 대기 상태로 들어가기 전에 이미 눌려 있으면 Falling edge가 없으므로 열 상태를 직접 확인해서 스캔 시작
+    set_col1(1);
+    KEYPAD16_Init_IT(&htim9);
+    CHECK_EQ(KEYPAD16_IsIdle(), 0);
+    CHECK(timer_running());
+    HOST_Advance_us((KEYPAD16_DEBOUNCE_MS + KEYPAD16_TASK_PERIOD_MS) * 1000);
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), COL1_KEYS);
+
+    set_col1(0);
+    HOST_Advance_us((KEYPAD16_DEBOUNCE_MS + KEYPAD16_TASK_PERIOD_MS) * 1000);
+    check_idle();
+}
+
+static void test_exti_typing_trace(void)
+{
+    // 사람이 입력하는 속도: 누르는 시간 60 ~ 200ms, 키 사이 150 ~ 1000ms로 20번
+    KEYPAD16_Event event;
+    uint32_t seed = 7;
+    uint32_t wakes = 0;
+    uint32_t presses = 0;
+    uint32_t latency_total = 0;
+    uint32_t latency_max = 0;
+
+    set_col1(0);
+    KEYPAD16_Init_IT(&htim9);
+    PERF_Reset();
+    uint32_t start = HAL_GetTick();
+
+    for (int k = 0; k < 20; k++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t hold_ms = 60 + (seed >> 16) % 141;
+        uint32_t gap_ms = 150 + (seed >> 8) % 851;
+
+        HOST_Advance_us(gap_ms * 1000);
+        uint32_t pressed_at = HAL_GetTick();
+        wakes += KEYPAD16_IsIdle();
+        press_col1_it(1);
+        HOST_Advance_us(hold_ms * 1000);
+        press_col1_it(0);
+
+        while (KEYPAD16_Get_Event(&event))
+        {
+            if (event.type == KEYPAD16_EVENT_PRESS && event.key == '1')
+            {
+                uint32_t latency = event.tick - pressed_at;
+                latency_total += latency;
+                latency_max = (latency > latency_max) ? latency : latency_max;
+                presses++;
+            }
+        }
+    }
+    HOST_Advance_us(200000);
+    check_idle();
+
+    uint32_t elapsed = HAL_GetTick() - start;
+    uint32_t scans = scan_count();
+    printf("typing trace: %lu keys in %lu ms, %lu EXTI wakes, %lu scans (polling every %d ms: %lu), "
+           "press latency mean %lu ms, max %lu ms\n",
+           (unsigned long)presses, (unsigned long)elapsed, (unsigned long)wakes, (unsigned long)scans,
+           KEYPAD16_TASK_PERIOD_MS, (unsigned long)(elapsed / KEYPAD16_TASK_PERIOD_MS),
+           (unsigned long)(presses ? latency_total / presses : 0), (unsigned long)latency_max);
+    CHECK_EQ(presses, 20);
+    CHECK_EQ(wakes, 20);
+    CHECK(latency_max <= KEYPAD16_DEBOUNCE_MS);
+    CHECK(scans < elapsed / KEYPAD16_TASK_PERIOD_MS / 2);
+}
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void test_scan_cost(void)
+{
+    // 시뮬레이션의 DWT는 HOST_Advance_us에서만 진행하므로 PC에서 걸린 시간(ns)을 PERF_USER0에 기록
+    // (보드의 클럭 수는 "perf show"의 keypad_scan으로 확인, keypad_scan_compare가 두 빌드의 출력을 나란히 보여줌)
+    PERF_Stats stats;
+
+    KEYPAD16_Init();
+    set_col1(1);
+    host_gpio_hal_calls = 0;
+    KEYPAD16_Scan();
+    uint32_t hal_calls = host_gpio_hal_calls;
+    // 빠른 스캔은 BSRR 쓰기 5번과 IDR 읽기 4번, HAL_GPIO 방식은 행마다 WritePin 5번 + ReadPin 4번, 끝에서 WritePin 4번
+    CHECK_EQ(hal_calls, KEYPAD16_SAME_PORT ? 0 : 4 * (5 + 4) + 4);
+
+    PERF_Reset();
+    for (int batch = 0; batch < 2000; batch++)
+    {
+        uint64_t t0 = wall_ns();
+        for (int i = 0; i < 100; i++)
+        {
+            KEYPAD16_Scan();
+        }
+        PERF_Record(PERF_USER0, (uint32_t)((wall_ns() - t0) / 100));
+    }
+    PERF_GetStats(PERF_USER0, &stats);
+    CHECK_EQ(stats.count, 2000);
+    CHECK_EQ(KEYPAD16_Get_Key_Bits(), COL1_KEYS);
+
+    printf("keypad scan (%s): %lu HAL_GPIO calls/scan, %lu ns/scan mean, min %lu, max %lu on this PC\n",
+           KEYPAD16_SAME_PORT ? "BSRR/IDR" : "HAL_GPIO", (unsigned long)hal_calls,
+           (unsigned long)(stats.total / stats.count), (unsigned long)stats.min, (unsigned long)stats.max);
+}
+
+int main(void)
+{
+    RUN_TEST(test_triggered_key_is_read_once);
+    RUN_TEST(test_bounce_is_filtered);
+    RUN_TEST(test_debounce_latency_matches_period);
+    RUN_TEST(test_exti_idle_scan_cycle);
+    RUN_TEST(test_exti_press_before_arming_is_not_lost);
+    RUN_TEST(test_exti_typing_trace);
+    RUN_TEST(test_scan_cost);
+    return TEST_EXIT();
+}
@@ -0,0 +1,454 @@
+/*
+ * test_lcd1602.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * lcd1602 비동기 모드: I²C 버스에 나간 트랜잭션 순서와 명령 실행 시간 대기, blocking 방식과 비교한 메인 루프 정지 시간
+ * 글리프 캐시: 적중/실패, LRU 교체, 화면(프레임버퍼 포함)에 보이는 글리프는 교체하지 않음, CGRAM 쓰기는 실패 때만
+ * (드라이버와 i2cbus 상태는 테스트끼리 이어지므로 각 테스트는 큐가 빌 때까지 기다림)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "lcd1602.h"
+
+static void wait_idle(void)
+{
+    for (int i = 0; i < 1000 && LCD_IsBusy(); i++)
+    {
+        HOST_Advance_us(100);
+    }
+    CHECK(!LCD_IsBusy());
+}
+
+// LCD_Init(blocking) 후 비동기 모드 시작, 이후 트랜잭션 로그의 시작 위치 반환
+static uint32_t start_async(void)
+{
+    host_i2c_dev[LCD_ADDR].present = 1;
+    LCD_Init();
+    LCD_StartAsync(&htim3);
+    return host_i2c_log_count;
+}
+
+static void test_queue_keeps_order_and_waits(void)
+{
+    uint32_t base = start_async();
+
+    CHECK_EQ(LCD_SendCommand(0x01), HAL_OK);                      // clear: 1600us
+    CHECK_EQ(LCD_WriteBuffer(1, 1, (const uint8_t *)"AB", 2), HAL_OK);
+    CHECK_EQ(LCD_SendCommand(0x0C), HAL_OK);                      // 40us
+    CHECK_EQ(LCD_WriteBuffer(2, 3, (const uint8_t *)"CD", 2), HAL_OK);
+    wait_idle();
+
+    CHECK_EQ(host_i2c_log_count - base, 4);
+    const HOST_I2cXfer *x = &host_i2c_log[base];
+    CHECK_EQ(x[0].addr, LCD_ADDR);
+    CHECK_EQ(x[0].data[1], 0x01);
+    CHECK_EQ(x[1].data[1], 0x80);
+    CHECK(memcmp(&x[1].data[3], "AB", 2) == 0);
+    CHECK_EQ(x[2].data[1], 0x0C);
+    CHECK_EQ(x[3].data[1], 0xC2);
+    CHECK(memcmp(&x[3].data[3], "CD", 2) == 0);
+
+    // 명령 뒤에는 실행 시간만큼 다음 트랜잭션을 미룸
+    CHECK(x[1].start_us - x[0].end_us >= LCD_WAIT_CLEAR_US);
+    CHECK(x[3].start_us - x[2].end_us >= LCD_WAIT_CMD_US);
+}
+
+static void test_full_queue_drops_without_blocking(void)
+{
+    uint32_t base = start_async();
+    uint32_t dropped = LCD_GetDropped();
+
+    // 시간을 진행하지 않으므로 인터럽트가 큐를 비우지 못함 → 가득 차면 바로 HAL_BUSY
+    int accepted = 0;
+    for (int i = 0; i < LCD_QUEUE_SIZE + 4; i++)
+    {
+        accepted += (LCD_SendData((uint8_t)('a' + i)) == HAL_OK);
+    }
+    CHECK_EQ(accepted, LCD_QUEUE_SIZE - 1);
+    CHECK_EQ(LCD_GetDropped() - dropped, 5);
+    wait_idle();
+
+    CHECK_EQ(host_i2c_log_count - base, LCD_QUEUE_SIZE - 1);
+    for (int i = 0; i < LCD_QUEUE_SIZE - 1; i++)
+    {
+        CHECK_EQ(host_i2c_log[base + i].data[1], 'a' + i);
+    }
+
+    // 버린 뒤의 LCD_Flush는 화면 전체(줄마다 트랜잭션 하나)를 다시 전송
+    base = host_i2c_log_count;
+    LCD_Flush();
+    wait_idle();
+    CHECK_EQ(host_i2c_log_count - base, LCD_ROWS);
+}
+
+static void test_address_command_wait_follows_bus_clock(void)
+{
+    // 100kHz: 주소 명령 뒤 control 바이트(90us)로 실행 시간이 확보되므로 트랜잭션 하나
+    uint32_t base = start_async();
+    CHECK_EQ(LCD_WriteBuffer(1, 5, (const uint8_t *)"xy", 2), HAL_OK);
+    wait_idle();
+    CHECK_EQ(host_i2c_log_count - base, 1);
+    CHECK_EQ(host_i2c_log[base].data[0], LCD_CTRL_CMD_NEXT);
+    CHECK_EQ(host_i2c_log[base].data[1], 0x84);
+
+    // 400kHz: control 바이트가 22.5us뿐이므로 주소 명령을 따로 보내고 LCD_WAIT_CMD_US를 기다림
+    hi2c1.Init.ClockSpeed = 400000;
+    base = host_i2c_log_count;
+    CHECK_EQ(LCD_WriteBuffer(2, 1, (const uint8_t *)"zw", 2), HAL_OK);
+    wait_idle();
+    CHECK_EQ(host_i2c_log_count - base, 2);
+    const HOST_I2cXfer *x = &host_i2c_log[base];
+    CHECK_EQ(x[0].len, 2);
+    CHECK_EQ(x[0].data[0], LCD_CTRL_CMD);
+    CHECK_EQ(x[0].data[1], 0xC0);
+    CHECK_EQ(x[1].data[0], LCD_CTRL_DATA);
+    CHECK(memcmp(&x[1].data[1], "zw", 2) == 0);
+    CHECK(x[1].start_us - x[0].end_us >= LCD_WAIT_CMD_US);
+}
+
+static void test_flush_keeps_invalid_set_during_flush(void)
+{
+    uint32_t base = start_async();
+
+    // 큐를 한 칸만 남기고 채운 뒤 두 줄을 바꾸면, 두 번째 줄은 LCD_Flush 안에서 버려짐
+    for (int i = 0; i < LCD_QUEUE_SIZE - 2; i++)
+    {
+        CHECK_EQ(LCD_SendData(' '), HAL_OK);
+    }
+    LCD_SetCursor(1, 1);
+    LCD_Print("row1");
+    LCD_SetCursor(2, 1);
+    LCD_Print("row2");
+    uint32_t dropped = LCD_GetDropped();
+    LCD_Flush();
+    CHECK_EQ(LCD_GetDropped() - dropped, 1);
+    wait_idle();
+
+    // 다음 LCD_Flush는 버려진 줄을 포함해 다시 전송해야 함
+    base = host_i2c_log_count;
+    LCD_Flush();
+    wait_idle();
+    int row2_sent = 0;
+    for (uint32_t i = base; i < host_i2c_log_count; i++)
+    {
+        row2_sent |= (host_i2c_log[i].data[1] == 0xC0 && memcmp(&host_i2c_log[i].data[3], "row2", 4) == 0);
+    }
+    CHECK(row2_sent);
+}
+
+static void test_blocking_failure_resends_on_flush(void)
+{
+    start_async();
+    LCD_StartAsync(NULL);  // blocking 모드
+
+    // 장치가 응답하지 않아 실패한 쓰기는 화면에 반영된 것으로 치지 않음
+    host_i2c_dev[LCD_ADDR].present = 0;
+    CHECK(LCD_WriteBuffer(1, 1, (const uint8_t *)"Q", 1) != HAL_OK);
+    host_i2c_dev[LCD_ADDR].present = 1;
+
+    uint32_t base = host_i2c_log_count;
+    LCD_Flush();
+    CHECK(host_i2c_log_count - base >= 1);
+    CHECK_EQ(host_i2c_log[base].data[3], 'Q');
+}
+
+// 화면 갱신 한 번(clear + 두 줄, 또는 값만 바뀐 LCD_Flush)이 메인 루프를 멈추는 시간과 화면에 반영되기까지의 시간
+typedef struct {
+    uint32_t clear_stall_us;   // clear + LCD_DispChar 두 줄
+    uint32_t clear_done_us;
+    uint32_t flush_stall_max_us;  // 값이 바뀐 LCD_Flush
+    uint32_t flush_stall_total_us;
+    uint32_t flush_done_max_us;
+} LcdStall;
+
+static void measure_stall(LcdStall *stall)
+{
+    char line[LCD_COLS + 1];
+
+    *stall = (LcdStall){0};
+    uint64_t t0 = HOST_Now_us();
+    LCD_SendCommand(0x01);
+    LCD_DispChar(1, 1, "Temp   23.5 C");
+    LCD_DispChar(2, 1, "Fan    1200 rpm");
+    stall->clear_stall_us = (uint32_t)(HOST_Now_us() - t0);
+    wait_idle();
+    stall->clear_done_us = (uint32_t)(HOST_Now_us() - t0);
+
+    // 대시보드: 50ms마다 숫자 몇 칸만 바뀜
+    LCD_ClearBuffer();
+    LCD_Invalidate();
+    LCD_Flush();
+    wait_idle();
+    for (int pass = 0; pass < 20; pass++)
+    {
+        HOST_Advance_us(LCD_TASK_PERIOD_MS * 1000);
+        snprintf(line, sizeof(line), "Temp %4d.%d C", 20 + pass / 10, pass % 10);
+        LCD_SetCursor(1, 1);
+        LCD_Print(line);
+        snprintf(line, sizeof(line), "Fan  %6d rpm", 1200 + pass * 7);
+        LCD_SetCursor(2, 1);
+        LCD_Print(line);
+
+        t0 = HOST_Now_us();
+        LCD_Flush();
+        uint32_t stall_us = (uint32_t)(HOST_Now_us() - t0);
+        wait_idle();
+        uint32_t done_us = (uint32_t)(HOST_Now_us() - t0);
+        stall->flush_stall_total_us += stall_us;
+        stall->flush_stall_max_us = (stall_us > stall->flush_stall_max_us) ? stall_us : stall->flush_stall_max_us;
+        stall->flush_done_max_us = (done_us > stall->flush_done_max_us) ? done_us : stall->flush_done_max_us;
+    }
+}
+
+static void test_main_loop_stall_blocking_vs_async(void)
+{
+    LcdStall blocking;
+    LcdStall async;
+
+    start_async();
+    LCD_StartAsync(NULL);
+    measure_stall(&blocking);
+    start_async();
+    measure_stall(&async);
+
+    printf("clear + 2 lines: blocking stalls the main loop %lu us; async %lu us (on screen after %lu us)\n",
+           (unsigned long)blocking.clear_stall_us, (unsigned long)async.clear_stall_us,
+           (unsigned long)async.clear_done_us);
+    printf("dashboard flush x20: blocking stall max %lu us, total %lu us; async max %lu us, total %lu us "
+           "(on screen within %lu us)\n",
+           (unsigned long)blocking.flush_stall_max_us, (unsigned long)blocking.flush_stall_total_us,
+           (unsigned long)async.flush_stall_max_us, (unsigned long)async.flush_stall_total_us,
+           (unsigned long)async.flush_done_max_us);
+
+    // blocking: clear 명령 뒤 HAL_Delay(2)와 I²C 전송 시간 동안 멈춤, 비동기: 큐에 넣고 바로 리턴
+    CHECK(blocking.clear_stall_us >= 2000);
+    CHECK(blocking.flush_stall_max_us > 0);
+    CHECK_EQ(async.clear_stall_us, 0);
+    CHECK_EQ(async.flush_stall_total_us, 0);
+    // 비동기 모드도 화면에는 blocking 방식보다 늦지 않게 반영됨 (명령 실행 시간만 기다림)
+    CHECK(async.clear_done_us <= blocking.clear_stall_us);
+    CHECK(async.flush_done_max_us <= blocking.flush_stall_max_us + 100);
+}
+
+#define GLYPHS 16
+
+// 첫 줄에 ID를 넣어서 CGRAM 쓰기 로그에서 어떤 글리프가 올라갔는지 알 수 있게 함
+static uint8_t glyph_bits[GLYPHS][8];
+
+// blocking 모드로 초기화 (글리프 캐시 비움) 후 글리프 등록
+static void glyph_setup(void)
+{
+    host_i2c_dev[LCD_ADDR].present = 1;
+    LCD_StartAsync(NULL);
+    LCD_Init();
+    for (int id = 0; id < GLYPHS; id++)
+    {
+        glyph_bits[id][0] = (uint8_t)id;
+        CHECK_EQ(LCD_RegisterGlyph((uint8_t)id, glyph_bits[id]), HAL_OK);
+    }
+}
+
+// base 이후의 CGRAM 쓰기를 slot_glyph에 반영하고 개수를 반환
+static uint32_t scan_cgram(uint32_t base, int slot_glyph[LCD_CGRAM_SLOTS])
+{
+    uint32_t writes = 0;
+    CHECK(host_i2c_log_count < HOST_I2C_LOG_SIZE);
+    for (uint32_t i = base; i < host_i2c_log_count; i++)
+    {
+        const HOST_I2cXfer *x = &host_i2c_log[i];
+        if (x->data[0] == LCD_CTRL_CMD_NEXT && (x->data[1] & 0xC0) == 0x40)
+        {
+            CHECK_EQ(x->len, 3 + 8);
+            slot_glyph[(x->data[1] >> 3) & 0x07] = x->data[3];
+            writes++;
+        }
+    }
+    return writes;
+}
+
+static void test_glyph_hit_uploads_once(void)
+{
+    int slot_glyph[LCD_CGRAM_SLOTS];
+    uint32_t hits0, misses0, hits, misses;
+
+    glyph_setup();
+    LCD_GetGlyphStats(&hits0, &misses0);
+    uint32_t base = host_i2c_log_count;
+
+    CHECK_EQ(LCD_UseGlyph(3), 0x08);  // 빈 슬롯 0
+    CHECK_EQ(LCD_UseGlyph(3), 0x08);
+    CHECK_EQ(LCD_UseGlyph(5), 0x09);
+    CHECK_EQ(LCD_UseGlyph(3), 0x08);
+    CHECK_EQ(LCD_UseGlyph(GLYPHS), -1);  // 등록하지 않은 ID
+
+    CHECK_EQ(scan_cgram(base, slot_glyph), 2);
+    CHECK_EQ(slot_glyph[0], 3);
+    CHECK_EQ(slot_glyph[1], 5);
+    LCD_GetGlyphStats(&hits, &misses);
+    CHECK_EQ(hits - hits0, 2);
+    CHECK_EQ(misses - misses0, 2);
+
+    // 다시 등록하면 새 비트맵이 반영되도록 다음 사용 때 업로드
+    CHECK_EQ(LCD_RegisterGlyph(3, glyph_bits[3]), HAL_OK);
+    base = host_i2c_log_count;
+    CHECK(LCD_UseGlyph(3) >= 0x08);
+    CHECK_EQ(scan_cgram(base, slot_glyph), 1);
+}
+
+static void test_glyph_overflow_evicts_least_recently_used(void)
+{
+    int slot_glyph[LCD_CGRAM_SLOTS];
+
+    glyph_setup();
+    for (int id = 0; id < LCD_CGRAM_SLOTS; id++)
+    {
+        CHECK_EQ(LCD_UseGlyph((uint8_t)id), 0x08 + id);
+    }
+    CHECK_EQ(LCD_UseGlyph(0), 0x08);  // 슬롯 0을 최근 사용으로
+
+    // 9번째 글리프: 가장 오래전에 사용한 슬롯 1(글리프 1)을 교체
+    uint32_t base = host_i2c_log_count;
+    CHECK_EQ(LCD_UseGlyph(8), 0x09);
+    CHECK_EQ(scan_cgram(base, slot_glyph), 1);
+    CHECK_EQ(slot_glyph[1], 8);
+
+    // 쫓겨난 글리프 1은 다시 실패, 이번에는 슬롯 2가 가장 오래됨
+    CHECK_EQ(LCD_UseGlyph(1), 0x0A);
+    CHECK_EQ(LCD_UseGlyph(0), 0x08);  // 교체되지 않고 남아 있음
+}
+
+static void test_glyph_on_screen_is_never_evicted(void)
+{
+    int slot_glyph[LCD_CGRAM_SLOTS];
+
+    glyph_setup();
+
+    // 슬롯 8개를 모두 프레임버퍼에 그림 (아직 LCD_Flush 전): 교체할 슬롯이 없음
+    LCD_SetCursor(1, 1);
+    for (int id = 0; id < LCD_CGRAM_SLOTS; id++)
+    {
+        LCD_PutChar((uint8_t)LCD_UseGlyph((uint8_t)id));
+    }
+    uint32_t base = host_i2c_log_count;
+    CHECK_EQ(LCD_UseGlyph(9), -1);
+    CHECK_EQ(scan_cgram(base, slot_glyph), 0);
+
+    // 화면에 반영한 뒤 프레임버퍼에서 지워도, LCD_Flush 전에는 화면에 남아 있으므로 교체하지 않음
+    LCD_Flush();
+    LCD_SetCursor(1, 4);
+    LCD_Print(" ");  // 슬롯 3
+    CHECK_EQ(LCD_UseGlyph(9), -1);
+
+    // LCD_Flush 뒤에는 슬롯 3만 교체 가능 (더 오래된 슬롯 0~2는 아직 보임)
+    LCD_Flush();
+    base = host_i2c_log_count;
+    CHECK_EQ(LCD_UseGlyph(9), 0x0B);
+    CHECK_EQ(scan_cgram(base, slot_glyph), 1);
+    CHECK_EQ(slot_glyph[3], 9);
+}
+
+#define TRACE_COLS 6  // 6칸만 써서 보이는 글리프 수가 슬롯 수 근처에 머물게 함
+
+// 칸마다 그린 글리프 ID와 문자 코드 (-1: 글리프 아님)
+typedef struct {
+    int glyph[LCD_ROWS][TRACE_COLS];
+    int code[LCD_ROWS][TRACE_COLS];
+} GlyphCells;
+
+// 그린 문자 코드의 슬롯에 그린 글리프가 그대로 있어야 함
+static void check_cells(const GlyphCells *cells, const int slot_glyph[LCD_CGRAM_SLOTS])
+{
+    for (int r = 0; r < LCD_ROWS; r++)
+    {
+        for (int c = 0; c < TRACE_COLS; c++)
+        {
+            if (cells->glyph[r][c] >= 0)
+            {
+                CHECK_EQ(slot_glyph[cells->code[r][c] & 0x07], cells->glyph[r][c]);
+            }
+        }
+    }
+}
+
+static void test_glyph_random_trace_keeps_screen_correct(void)
+{
+    // 무작위로 글리프를 그리고 지우면서, 프레임버퍼(fb)와 화면(shown)의 사용자 정의 문자가 교체되지 않는지 확인
+    int slot_glyph[LCD_CGRAM_SLOTS];
+    GlyphCells fb;
+    GlyphCells shown;
+    uint32_t hits0, misses0, hits, misses;
+    uint32_t seed = 12345;
+    uint32_t refused = 0;
+    uint32_t writes = 0;
+
+    glyph_setup();
+    memset(slot_glyph, 0xFF, sizeof(slot_glyph));
+    memset(&fb, 0xFF, sizeof(fb));
+    memset(&shown, 0xFF, sizeof(shown));
+    LCD_GetGlyphStats(&hits0, &misses0);
+
+    for (int step = 0; step < 3000; step++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int r = (seed >> 8) % LCD_ROWS;
+        int c = (seed >> 12) % TRACE_COLS;
+        int id = (seed >> 20) % GLYPHS;
+        host_i2c_log_count = 0;  // 로그(HOST_I2C_LOG_SIZE)가 넘치지 않도록 한 단계씩 확인
+
+        LCD_SetCursor(r + 1, c + 1);
+        if ((seed >> 28) < 4)
+        {
+            LCD_Print(" ");
+            fb.glyph[r][c] = -1;
+        }
+        else
+        {
+            int code = LCD_UseGlyph((uint8_t)id);
+            if (code < 0)
+            {
+                refused++;  // 보이는 슬롯뿐이라 거절
+            }
+            else
+            {
+                LCD_PutChar((uint8_t)code);
+                fb.glyph[r][c] = id;
+                fb.code[r][c] = code;
+            }
+        }
+        writes += scan_cgram(0, slot_glyph);
+
+        if ((seed >> 4) % 8 == 0)
+        {
+            LCD_Flush();
+            shown = fb;
+        }
+        check_cells(&fb, slot_glyph);
+        check_cells(&shown, slot_glyph);
+    }
+
+    // CGRAM 쓰기는 실패(업로드)한 경우에만
+    LCD_GetGlyphStats(&hits, &misses);
+    printf("glyph trace: %lu hits, %lu uploads, %lu refused (all slots visible)\n",
+           (unsigned long)(hits - hits0), (unsigned long)writes, (unsigned long)refused);
+    CHECK_EQ(writes, misses - misses0 - refused);
+    CHECK(refused > 0 && writes > LCD_CGRAM_SLOTS && hits - hits0 > writes);
+}
+
+int main(void)
+{
+    RUN_TEST(test_queue_keeps_order_and_waits);
+    RUN_TEST(test_full_queue_drops_without_blocking);
+    RUN_TEST(test_address_command_wait_follows_bus_clock);
+    RUN_TEST(test_flush_keeps_invalid_set_during_flush);
+    RUN_TEST(test_blocking_failure_resends_on_flush);
+    RUN_TEST(test_main_loop_stall_blocking_vs_async);
+    RUN_TEST(test_glyph_hit_uploads_once);
+    RUN_TEST(test_glyph_overflow_evicts_least_recently_used);
+    RUN_TEST(test_glyph_on_screen_is_never_evicted);
+    RUN_TEST(test_glyph_random_trace_keeps_screen_correct);
+    return TEST_EXIT();
+}
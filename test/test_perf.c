@@ -0,0 +1,151 @@
+/*
+ * test_perf.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * perf: 통계 복사/초기화의 인터럽트 상태, "perf show"/"help"와 이어서 출력하기(continuation)
+ */
+
+#include <string.h>
+#include "host_test.h"
+#include "perf.h"
+#include "usart2console.h"
+
+static int other_calls = 0;
+static int other_done = 0;
+
+// 다른 커맨드의 긴 출력 (other_done이 1이 될 때까지 끝나지 않음)
+static bool other_continuation(void)
+{
+    other_calls++;
+    return other_done;
+}
+
+static void drain(void)
+{
+    for (int i = 0; i < 1000 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+    {
+        HOST_Advance_us(1000);
+        U2C_process();
+    }
+}
+
+static int capture_contains(const char *text)
+{
+    size_t length = strlen(text);
+    for (uint32_t i = 0; i + length <= host_uart_capture_len; i++)
+    {
+        if (memcmp(&host_uart_capture[i], text, length) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void test_stats_keep_interrupts_masked(void)
+{
+    PERF_Stats stats;
+
+    PERF_Reset();
+    PERF_Record(PERF_USER0, 100);
+    PERF_Record(PERF_USER0, 300);
+
+    // 임계 구역 안에서 호출해도 인터럽트를 다시 켜면 안 됨
+    __disable_irq();
+    PERF_GetStats(PERF_USER0, &stats);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    PERF_Reset();
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+
+    CHECK_EQ(stats.count, 2);
+    CHECK_EQ(stats.min, 100);
+    CHECK_EQ(stats.max, 300);
+    CHECK_EQ(stats.total, 400);
+    CHECK_EQ(stats.hist[7], 1);  // 64 ~ 127
+    CHECK_EQ(stats.hist[9], 1);  // 256 ~ 511
+    PERF_GetStats(PERF_USER0, &stats);
+    CHECK_EQ(stats.count, 0);
+}
+
+static void test_continuation_refuses_while_another_is_active(void)
+{
+    U2C_init();
+    other_done = 0;
+    CHECK_EQ(U2C_set_continuation(other_continuation), HAL_OK);
+    CHECK_EQ(U2C_set_continuation(other_continuation), HAL_OK);  // 같은 함수는 다시 등록 가능
+
+    // 다른 출력이 진행 중이면 "perf show"는 표를 시작하지 않음
+    PERF_Init();
+    PERF_Record(PERF_USER1, 5);
+    HOST_UART_Receive(&huart2, (const uint8_t *)"perf show\r", 10);
+    U2C_process();
+    drain();
+    CHECK(capture_contains("perf: busy"));
+    CHECK(!capture_contains("user1"));
+    CHECK(other_calls > 0);
+
+    // 이전 출력이 끝나면 등록이 풀리고 "perf show"가 표를 끝까지 출력
+    other_done = 1;
+    U2C_process();
+    HOST_UART_Receive(&huart2, (const uint8_t *)"perf show\r", 10);
+    U2C_process();
+    drain();
+    CHECK(capture_contains("user1"));
+    CHECK_EQ(U2C_set_continuation(other_continuation), HAL_OK);  // perf 출력도 끝나서 해제됨
+    CHECK_EQ(U2C_set_continuation(NULL), HAL_OK);
+}
+
+static void test_help_and_perf_show_do_not_interleave(void)
+{
+    static const char filler[] = "..............................................................";
+
+    U2C_init();
+    PERF_Init();
+    drain();
+
+    // 다른 출력이 진행 중이면 help도 목록을 시작하지 않음
+    other_done = 0;
+    CHECK_EQ(U2C_set_continuation(other_continuation), HAL_OK);
+    host_uart_capture_len = 0;
+    HOST_UART_Receive(&huart2, (const uint8_t *)"help\r", 5);
+    U2C_process();
+    drain();
+    CHECK(capture_contains("help: busy"));
+    CHECK(!capture_contains("perf - "));
+    other_done = 1;
+    U2C_process();
+
+    // 송신 링 버퍼를 거의 채워 help 목록이 한 번에 끝나지 않게 한 뒤 "perf show"
+    host_uart_capture_len = 0;
+    HOST_UART_Receive(&huart2, (const uint8_t *)"help\r", 5);
+    while (U2C_get_tx_free() >= 40)
+    {
+        uint16_t length = U2C_get_tx_free() - 39;
+        if (length > sizeof(filler) - 1)
+        {
+            length = sizeof(filler) - 1;
+        }
+        U2C_print((uint8_t *)filler, length);
+    }
+    U2C_process();
+    HOST_UART_Receive(&huart2, (const uint8_t *)"perf show\r", 10);
+    U2C_process();
+    drain();
+    CHECK(capture_contains("perf: busy"));
+    CHECK(capture_contains("binmode - Switch to binary frame mode" NEWLINE_CHARACTER
+                           "help - List registered commands" NEWLINE_CHARACTER
+                           "perf - perf show|reset" NEWLINE_CHARACTER));
+    CHECK(!capture_contains("user1"));
+    CHECK_EQ(U2C_set_continuation(NULL), HAL_OK);
+}
+
+int main(void)
+{
+    RUN_TEST(test_stats_keep_interrupts_masked);
+    RUN_TEST(test_continuation_refuses_while_another_is_active);
+    RUN_TEST(test_help_and_perf_show_do_not_interleave);
+    return TEST_EXIT();
+}
@@ -0,0 +1,77 @@
+/*
+ * test_power.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * power (POWER_USE_RTC 없음): STOP 모드를 쓰지 않고 SLEEP만 사용, HAL tick이 실제 시간과 맞는지
+ */
+
+#include "host_test.h"
+#include "power.h"
+#include "scheduler.h"
+
+static int restore_calls = 0;
+
+static void restore_clock(void)
+{
+    restore_calls++;
+}
+
+static void event_task(void)
+{
+}
+
+// 5ms 뒤 다른 인터럽트(UART 수신 등)로 깨어나는 WFI
+static void wfi_woken_early(void)
+{
+    HOST_Advance_us(5000);
+}
+
+static void test_idle_without_rtc_never_stops(void)
+{
+    // 이벤트 태스크만 있어 깨우기만 기다려도 STOP 모드에 들어가지 않음 (들어가면 HAL tick이 멈춤)
+    SCHED_Init();
+    SCHED_AddEvent("event", event_task, 0);
+    POWER_Init(restore_clock);
+    host_wfi_hook = wfi_woken_early;
+
+    for (int i = 0; i < 10; i++)
+    {
+        POWER_Idle();
+    }
+    CHECK_EQ(host_stop_count, 0);
+    CHECK_EQ(restore_calls, 0);
+    CHECK_EQ(__get_PRIMASK(), 0);
+
+    // 일찍 깨어나도 실제로 잔 시간만큼만 HAL tick을 더함
+    uint32_t now_ms = (uint32_t)(HOST_Now_us() / 1000);
+    CHECK_EQ(now_ms, 10 * 5);
+    CHECK(HAL_GetTick() + 1 >= now_ms && HAL_GetTick() <= now_ms + 1);
+
+    POWER_Stats stats;
+    POWER_GetStats(&stats);
+    CHECK_EQ(stats.stops, 0);
+    CHECK_EQ(stats.sleeps, 10);
+    CHECK(stats.sleep_ms + 2 >= now_ms && stats.sleep_ms <= now_ms);
+}
+
+static void test_stats_keep_interrupts_masked(void)
+{
+    POWER_Stats stats;
+
+    POWER_Init(NULL);
+    __disable_irq();
+    POWER_GetStats(&stats);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    POWER_ResetStats();
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+}
+
+int main(void)
+{
+    RUN_TEST(test_idle_without_rtc_never_stops);
+    RUN_TEST(test_stats_keep_interrupts_masked);
+    return TEST_EXIT();
+}
@@ -0,0 +1,211 @@
+/*
+ * test_power_rtc.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * power (POWER_USE_RTC): STOP 모드에서 깨어나 클럭을 다시 설정하고, 잔 시간만큼 HAL tick을 맞추는지,
+ *                       RTC HAL 함수를 인터럽트 차단 중에 부르지 않는지, 사용 패턴별 절전 비율
+ */
+
+#include <stdio.h>
+#include "host_test.h"
+#include "power.h"
+#include "scheduler.h"
+#include "usart2console.h"
+#include "keypad16.h"
+
+static int restore_calls = 0;
+static uint32_t primask_in_restore = 0;
+static int periodic_runs = 0;
+
+// CubeMX의 SystemClock_Config 역할: PLL로 되돌리고, HAL처럼 HAL_GetTick으로 준비 완료를 기다림
+static void restore_clock(void)
+{
+    restore_calls++;
+    primask_in_restore |= __get_PRIMASK();
+    HAL_Delay(2);  // HSI로 동작하면서 PLL 잠금 대기 (tick이 멈춰 있거나 인터럽트가 막혀 있으면 끝나지 않음)
+    host_rcc_sysclk = HOST_CPU_CLOCK_HZ;  // HAL_RCC_ClockConfig처럼 SYSCLK을 바꾼 직후 SysTick을 다시 설정
+    SystemCoreClockUpdate();
+    HAL_InitTick(uwTickPrio);
+}
+
+static void periodic_task(void)
+{
+    periodic_runs++;
+}
+
+static void test_stop_restores_clock_and_keeps_tick(void)
+{
+    // 모든 드라이버가 쉬는 상태: 콘솔 송신 없음, 키패드는 EXTI 대기
+    U2C_init();
+    KEYPAD16_Init_IT(&htim9);
+    SCHED_Init();
+    SCHED_AddPeriodic("periodic", periodic_task, 100, 0);
+    POWER_Init(restore_clock);
+
+    for (int i = 0; i < 5; i++)
+    {
+        POWER_Idle();
+        SCHED_Run();
+    }
+
+    CHECK_EQ(host_stop_count, 5);
+    CHECK_EQ(restore_calls, 5);
+    CHECK_EQ(primask_in_restore, 0);  // 클럭 설정 함수는 인터럽트가 허용된 상태에서 호출
+    CHECK_EQ(SystemCoreClock, HOST_CPU_CLOCK_HZ);
+    CHECK_EQ(__get_PRIMASK(), 0);
+    CHECK_EQ(periodic_runs, 5);
+    CHECK_EQ(host_rtc_masked_calls, 0);  // HAL_GetTick 타임아웃을 쓰는 RTC 함수는 인터럽트를 허용하고 호출
+
+    // STOP 동안 지난 시간(RTC)과 클럭 설정 시간을 더한 HAL tick이 실제 시간과 맞음 (RTC 정밀도 1/256초)
+    uint32_t now_ms = (uint32_t)(HOST_Now_us() / 1000);
+    CHECK(now_ms >= 5 * 95);
+    CHECK(HAL_GetTick() + 10 >= now_ms && HAL_GetTick() <= now_ms + 10);
+
+    POWER_Stats stats;
+    POWER_GetStats(&stats);
+    CHECK_EQ(stats.stops, 5);
+    CHECK(stats.stop_ms >= 5 * 90 && stats.stop_ms <= 5 * 100);
+}
+
+static void test_busy_driver_prevents_stop(void)
+{
+    // 송신 중인 콘솔 출력이 있으면 STOP 대신 SLEEP
+    U2C_init();
+    KEYPAD16_Init_IT(&htim9);
+    SCHED_Init();
+    SCHED_AddPeriodic("periodic", periodic_task, 100, 0);
+    POWER_Init(restore_clock);
+
+    U2C_print((uint8_t *)"0123456789", 10);
+    POWER_Idle();
+    CHECK_EQ(host_stop_count, 0);
+}
+
+// STOP 중 30ms 뒤 UART RX 핀(EXTI 라인 3)의 시작 비트로 깨어남
+static void stop_woken_by_uart(void)
+{
+    HOST_Advance_us(30000);
+    EXTI->PR |= 1u << POWER_UART_WAKE_LINE;
+}
+
+static void test_uart_wake_keeps_mcu_awake(void)
+{
+    U2C_init();
+    KEYPAD16_Init_IT(&htim9);
+    SCHED_Init();
+    SCHED_AddPeriodic("periodic", periodic_task, 100, 0);
+    POWER_Init(restore_clock);
+
+    host_stop_hook = stop_woken_by_uart;
+    POWER_Idle();
+    CHECK_EQ(host_stop_count, 1);
+    CHECK(HAL_GetTick() >= 30 && HAL_GetTick() <= 40);
+
+    // 깨어난 뒤 POWER_UART_AWAKE_MS 동안은 이어지는 입력을 받도록 STOP 대신 SLEEP
+    SCHED_Run();
+    POWER_Idle();
+    CHECK_EQ(host_stop_count, 1);
+
+    POWER_Stats stats;
+    POWER_GetStats(&stats);
+    CHECK_EQ(stats.uart_wakes, 1);
+}
+
+// 사용 패턴: 100ms마다 센서 읽기, 1초마다 콘솔에 한 줄 출력, 8초에 콘솔 입력("help")으로 깨어남
+static uint8_t trace_uart_wake_done = 0;
+static uint8_t trace_feed_help = 0;
+static uint32_t report_count = 0;
+
+static void sensor_task(void)
+{
+    periodic_runs++;
+}
+
+static void report_task(void)
+{
+    U2C_printf("t=%lu ms" NEWLINE_CHARACTER, (unsigned long)HAL_GetTick());
+    report_count++;
+}
+
+// 다음 인터럽트까지 진행하는 WFI
+// 스텁은 CTRL에 쓰면 COUNTFLAG가 지워지고 깨어난 뒤 마지막으로 쓴 LOAD(한 tick)로 다시 세므로,
+// 늘린 SysTick 카운터는 한 tick이 남았을 때 깨움 (남은 tick은 깨어난 뒤 SysTick 인터럽트가 셈)
+static void trace_wfi(void)
+{
+    uint32_t tick_clocks = host_rcc_sysclk / 1000u;
+    uint32_t stop_val = (SysTick->LOAD >= tick_clocks) ? tick_clocks : 0;
+    do
+    {
+        HOST_Advance_us(1);
+    } while (!HOST_Irq_pending() && SysTick->VAL > stop_val);
+}
+
+// RTC 깨우기 타이머까지 진행 (SysTick은 HAL_SuspendTick으로 인터럽트가 꺼져 있음), 8초 뒤 첫 STOP은 중간에 콘솔 입력으로 깨어남
+static void trace_stop(void)
+{
+    uint32_t stop_us = (uint32_t)((uint64_t)host_rtc_wakeup_counts * 16u * 1000000u / 32768u);
+    if (!trace_uart_wake_done && HOST_Now_us() >= 8000000)
+    {
+        trace_uart_wake_done = 1;
+        trace_feed_help = 1;
+        HOST_Advance_us(stop_us / 2);
+        EXTI->PR |= 1u << POWER_UART_WAKE_LINE;
+        return;
+    }
+    HOST_Advance_us(stop_us);
+}
+
+static void test_usage_trace_power_ratio(void)
+{
+    POWER_Stats stats;
+
+    U2C_init();
+    KEYPAD16_Init_IT(&htim9);
+    SCHED_Init();
+    SCHED_AddPeriodic("console", U2C_Task, U2C_TASK_PERIOD_MS, 0);
+    SCHED_AddPeriodic("sensor", sensor_task, 100, 0);
+    SCHED_AddPeriodic("report", report_task, 1000, 0);
+    POWER_Init(restore_clock);
+    host_wfi_hook = trace_wfi;
+    host_stop_hook = trace_stop;
+
+    while (HOST_Now_us() < 30000000)
+    {
+        SCHED_Run();
+        if (trace_feed_help)
+        {
+            trace_feed_help = 0;
+            HOST_UART_Feed(&huart2, (const uint8_t *)"help\r", 5);
+        }
+        POWER_Idle();
+    }
+    host_wfi_hook = NULL;
+    host_stop_hook = NULL;
+    POWER_GetStats(&stats);
+
+    uint32_t now_ms = (uint32_t)(HOST_Now_us() / 1000);
+    printf("usage trace: %lu ms elapsed, SLEEP %lu ms (%lu entries), STOP %lu ms (%lu entries), "
+           "(sleep_ms + stop_ms) / elapsed_ms = %.1f%%, HAL tick off by %ld ms\n",
+           (unsigned long)stats.elapsed_ms, (unsigned long)stats.sleep_ms, (unsigned long)stats.sleeps,
+           (unsigned long)stats.stop_ms, (unsigned long)stats.stops,
+           100.0 * (stats.sleep_ms + stats.stop_ms) / stats.elapsed_ms, (long)HAL_GetTick() - (long)now_ms);
+    CHECK_EQ(stats.uart_wakes, 1);
+    CHECK(stats.stops > 0);
+    CHECK(stats.sleeps > 0);
+    CHECK(report_count >= 29);
+    CHECK((stats.sleep_ms + stats.stop_ms) * 10 >= stats.elapsed_ms * 7);
+    // STOP마다 RTC 정밀도(1/256초)와 STOP 전 tick 안에서 지난 클럭만큼 오차가 생기므로 실제 시간의 1% 안
+    CHECK(HAL_GetTick() + now_ms / 100 >= now_ms && HAL_GetTick() <= now_ms + now_ms / 100);
+    CHECK_EQ(host_rtc_masked_calls, 0);
+}
+
+int main(void)
+{
+    RUN_TEST(test_stop_restores_clock_and_keeps_tick);
+    RUN_TEST(test_uart_wake_keeps_mcu_awake);
+    RUN_TEST(test_usage_trace_power_ratio);
+    RUN_TEST(test_busy_driver_prevents_stop);  // 송신 중인 콘솔 출력이 남으므로 마지막
+    return TEST_EXIT();
+}
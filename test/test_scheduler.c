@@ -0,0 +1,302 @@
+/*
+ * test_scheduler.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * scheduler: EDF 실행 순서, 데드라인 초과, 깨우기와 주기 실행이 겹칠 때,
+ *            기존 while(1) + HAL_Delay 루프와 비교한 콘솔 응답 지연
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "keypad16.h"
+#include "lcd1602.h"
+#include "scheduler.h"
+#include "seg7array.h"
+#include "usart2console.h"
+
+static char order[8];
+static int order_len = 0;
+static uint32_t busy_us = 0;
+static uint32_t primask_in_task = 0;
+
+static void record(char name)
+{
+    if (order_len < (int)sizeof(order) - 1)
+    {
+        order[order_len++] = name;
+        order[order_len] = '\0';
+    }
+}
+
+static void task_a(void)
+{
+    record('A');
+    primask_in_task |= __get_PRIMASK();
+}
+
+static void task_b(void)
+{
+    record('B');
+}
+
+static void task_c(void)
+{
+    record('C');
+}
+
+// busy_us만큼 실행 시간을 쓰는 태스크
+static void task_busy(void)
+{
+    record('X');
+    HOST_Advance_us(busy_us);
+}
+
+static void reset_record(void)
+{
+    order[0] = '\0';
+    order_len = 0;
+}
+
+static void test_init_keeps_cycle_counter(void)
+{
+    // 다른 모듈이 재고 있던 사이클 카운터 값을 되돌리면 안 됨
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    HOST_Advance_us(100);
+    uint32_t before = DWT->CYCCNT;
+    CHECK(before > 0);
+
+    SCHED_Init();
+    CHECK(DWT->CYCCNT >= before);
+    CHECK(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk);
+}
+
+static void test_earliest_deadline_runs_first(void)
+{
+    SCHED_Init();
+    reset_record();
+    int a = SCHED_AddPeriodic("a", task_a, 10, 0);  // 데드라인 10
+    int b = SCHED_AddPeriodic("b", task_b, 10, 3);  // 데드라인 3
+    int c = SCHED_AddEvent("c", task_c, 5);         // 깨운 시점 + 5
+
+    HOST_Advance_us(10000);
+    SCHED_Wake(c);
+    SCHED_Run();
+
+    CHECK(strcmp(order, "BCA") == 0);
+    CHECK_EQ(SCHED_GetStats(a)->runs, 1);
+    CHECK_EQ(SCHED_GetStats(b)->runs, 1);
+    CHECK_EQ(SCHED_GetStats(c)->runs, 1);
+    CHECK_EQ(primask_in_task, 0);  // 태스크는 인터럽트가 켜진 상태로 실행
+    CHECK_EQ(SCHED_TimeToNext(), 10);
+}
+
+static void test_deadline_miss_and_skipped_periods(void)
+{
+    SCHED_Init();
+    reset_record();
+    int x = SCHED_AddPeriodic("x", task_busy, 10, 2);
+
+    // 실행 시간(3ms)이 데드라인(2ms)보다 길면 끝날 때 missed
+    busy_us = 3000;
+    HOST_Advance_us(10000);
+    SCHED_Run();
+    CHECK_EQ(SCHED_GetStats(x)->runs, 1);
+    CHECK_EQ(SCHED_GetStats(x)->missed, 1);
+    CHECK(SCHED_GetStats(x)->max_cycles >= 3000u * (SystemCoreClock / 1000000u));
+
+    // release 20에 실행하지 못하고 45에서 실행: 30, 40 주기를 건너뛰고 다음 release는 50
+    // (release 20의 실행도 데드라인 22를 넘겨서 끝나므로 missed는 1 + 2 + 1)
+    busy_us = 0;
+    HOST_Advance_us(45000 - 13000);
+    SCHED_Run();
+    CHECK_EQ(SCHED_GetStats(x)->runs, 2);
+    CHECK_EQ(SCHED_GetStats(x)->missed, 1 + 2 + 1);
+    CHECK_EQ(SCHED_GetStats(x)->max_lateness, 45 - 20);
+    CHECK_EQ(SCHED_TimeToNext(), 5);
+}
+
+static void test_wake_of_due_periodic_task_runs_once(void)
+{
+    // release 시점에 깨우기가 겹쳐도 한 번만 실행하고 다음 주기로 넘어감
+    SCHED_Init();
+    reset_record();
+    int a = SCHED_AddPeriodic("a", task_a, 10, 0);
+
+    HOST_Advance_us(10000);
+    SCHED_Wake(a);
+    SCHED_Run();
+    SCHED_Run();
+    CHECK(strcmp(order, "A") == 0);
+    CHECK_EQ(SCHED_TimeToNext(), 10);
+
+    // release 전에 깨우면 바로 실행하고, 주기 실행은 그대로 예정됨
+    reset_record();
+    HOST_Advance_us(4000);
+    SCHED_Wake(a);
+    SCHED_Run();
+    CHECK(strcmp(order, "A") == 0);
+    CHECK_EQ(SCHED_TimeToNext(), 6);
+    HOST_Advance_us(6000);
+    SCHED_Run();
+    CHECK(strcmp(order, "AA") == 0);
+}
+
+static void test_run_keeps_interrupts_masked(void)
+{
+    // 인터럽트를 막은 상태에서 호출해도 SCHED_Run이 인터럽트를 켜지 않음
+    SCHED_Init();
+    reset_record();
+    SCHED_AddPeriodic("b", task_b, 1, 0);
+    HOST_Advance_us(1000);
+
+    __disable_irq();
+    SCHED_Run();
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    CHECK(strcmp(order, "B") == 0);
+}
+
+// 콘솔 응답 지연: 명령의 마지막 바이트('\r')가 도착한 시각부터 명령 핸들러가 실행될 때까지
+#define PING_COUNT 40
+
+static uint64_t next_ping_us = 0;
+static uint32_t pings_sent = 0;
+static uint32_t ping_seed = 0;
+static uint64_t last_rx_us = 0;
+static uint32_t latency_max_us = 0;
+static uint64_t latency_total_us = 0;
+static uint32_t pongs = 0;
+static int console_task = -1;
+
+// 정해진 시각(30 ~ 130ms 간격)에 메인 루프와 상관없이 "ping"을 선로에 올림
+static void ping_sender(void)
+{
+    if (pings_sent < PING_COUNT && HOST_Now_us() >= next_ping_us)
+    {
+        HOST_UART_Feed(&huart2, (const uint8_t *)"ping\r", 5);
+        pings_sent++;
+        ping_seed = ping_seed * 1103515245u + 12345u;
+        next_ping_us = HOST_Now_us() + 30000 + (ping_seed >> 8) % 100000;
+    }
+}
+
+static void console_rx(void)
+{
+    last_rx_us = HOST_Now_us();
+    if (console_task >= 0)
+    {
+        SCHED_Wake(console_task);
+    }
+}
+
+static void cmd_ping(int argc, char *argv[])
+{
+    uint32_t latency = (uint32_t)(HOST_Now_us() - last_rx_us);
+    latency_total_us += latency;
+    latency_max_us = (latency > latency_max_us) ? latency : latency_max_us;
+    pongs++;
+}
+
+static void console_setup(void)
+{
+    U2C_init();
+    U2C_register_command("ping", cmd_ping, "latency probe");  // 두 번째부터는 이미 등록되어 있음
+    U2C_set_rx_hook(console_rx);
+    host_i2c_dev[LCD_ADDR].present = 1;
+    KEYPAD16_Init();
+    SEG7ARRAY_Init();
+    LCD_Init();
+    SEG7ARRAY_ShowInt(1234);
+
+    next_ping_us = HOST_Now_us() + 5000;
+    pings_sent = 0;
+    ping_seed = 3;
+    latency_max_us = 0;
+    latency_total_us = 0;
+    pongs = 0;
+    console_task = -1;
+    host_step_hook = ping_sender;
+}
+
+static void lcd_status_line(char *line, size_t size)
+{
+    snprintf(line, size, "up %5lu ms", (unsigned long)HAL_GetTick());
+}
+
+static void test_console_latency_old_loop_vs_scheduler(void)
+{
+    char line[LCD_COLS + 1];
+    uint32_t old_max;
+    uint32_t old_mean;
+
+    // 기존 방식: 자리마다 HAL_Delay(1)인 SEG7ARRAY_Cycle, blocking LCD 갱신(50ms마다), 스캔 간격 HAL_Delay(10)
+    console_setup();
+    uint32_t last_lcd = HAL_GetTick();
+    while (pongs < PING_COUNT && HAL_GetTick() < 10000)
+    {
+        U2C_process();
+        KEYPAD16_Scan();
+        SEG7ARRAY_Cycle();
+        if (HAL_GetTick() - last_lcd >= LCD_TASK_PERIOD_MS)
+        {
+            last_lcd = HAL_GetTick();
+            lcd_status_line(line, sizeof(line));
+            LCD_DispChar(1, 1, line);
+        }
+        HAL_Delay(10);
+    }
+    CHECK_EQ(pongs, PING_COUNT);
+    old_max = latency_max_us;
+    old_mean = (uint32_t)(latency_total_us / PING_COUNT);
+
+    // 스케줄러: 같은 일을 태스크로 나누고, 수신 인터럽트가 콘솔 태스크를 바로 깨움
+    // (할 일이 없을 때는 10us씩 진행: 보드에서는 WFI로 다음 인터럽트까지 잠)
+    console_setup();
+    LCD_StartAsync(&htim3);
+    SCHED_Init();
+    console_task = SCHED_AddPeriodic("console", U2C_Task, U2C_TASK_PERIOD_MS, 0);
+    SCHED_AddPeriodic("keypad", KEYPAD16_Task, KEYPAD16_TASK_PERIOD_MS, 0);
+    SCHED_AddPeriodic("lcd", LCD_Task, LCD_TASK_PERIOD_MS, 0);
+    SCHED_AddPeriodic("seg7", SEG7ARRAY_Task, SEG7ARRAY_TASK_PERIOD_MS, 0);
+    uint32_t start = HAL_GetTick();
+    last_lcd = start;
+    while (pongs < PING_COUNT && HAL_GetTick() - start < 10000)
+    {
+        if (HAL_GetTick() - last_lcd >= LCD_TASK_PERIOD_MS)
+        {
+            last_lcd = HAL_GetTick();
+            lcd_status_line(line, sizeof(line));
+            LCD_SetCursor(1, 1);
+            LCD_Print(line);
+        }
+        SCHED_Run();
+        HOST_Advance_us(10);
+    }
+    host_step_hook = NULL;
+    CHECK_EQ(pongs, PING_COUNT);
+
+    printf("console latency over %d commands: while(1)+HAL_Delay loop max %lu us, mean %lu us; "
+           "scheduler + U2C rx hook max %lu us, mean %lu us\n", PING_COUNT,
+           (unsigned long)old_max, (unsigned long)old_mean, (unsigned long)latency_max_us,
+           (unsigned long)(latency_total_us / PING_COUNT));
+    // 기존 루프는 한 바퀴(HAL_Delay(10) + SEG7ARRAY_Cycle 4ms + LCD 갱신)를 기다릴 수 있음
+    CHECK(old_max > 10000);
+    // 스케줄러는 실행 중인 태스크 하나가 끝날 때까지만 기다림
+    // (시뮬레이션에서 태스크 코드 자체는 시간을 쓰지 않으므로, 보드에서는 가장 긴 태스크의 실행 시간이 더해짐)
+    CHECK(latency_max_us < 1000);
+    LCD_StartAsync(NULL);
+}
+
+int main(void)
+{
+    RUN_TEST(test_init_keeps_cycle_counter);
+    RUN_TEST(test_earliest_deadline_runs_first);
+    RUN_TEST(test_deadline_miss_and_skipped_periods);
+    RUN_TEST(test_wake_of_due_periodic_task_runs_once);
+    RUN_TEST(test_run_keeps_interrupts_masked);
+    RUN_TEST(test_console_latency_old_loop_vs_scheduler);
+    return TEST_EXIT();
+}
@@ -0,0 +1,609 @@
+/*
+ * test_seg7array.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * seg7array: GPIO 출력으로 본 자리별 세그먼트, 숫자/문자열 출력과 스크롤, 폰트, ShowInt 변환 비용,
+ *            타이머 모드의 프레임당 인터럽트 시간과 화면 갱신 주기의 흔들림 (폴링 방식과 비교)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "host_test.h"
+#include "perf.h"
+#include "seg7array.h"
+
+// 현재 출력 중인 세그먼트 바이트 (abcdefgp 순, main.h의 핀 배치)
+static uint8_t segments(void)
+{
+    HOST_GPIO_Sync();
+    uint32_t a = GPIOA->ODR;
+    uint32_t b = GPIOB->ODR;
+    return (uint8_t)(((a >> 6) & 1) << 7 | ((a >> 7) & 1) << 6 | ((a >> 8) & 1) << 5 | ((a >> 9) & 1) << 4 |
+                     ((b >> 0) & 1) << 3 | ((b >> 1) & 1) << 2 | ((b >> 2) & 1) << 1 | ((b >> 10) & 1));
+}
+
+// 켜져 있는 자리 (0~3, 자리 핀은 active-low), 꺼져 있으면 -1, 두 자리 이상이면 -2
+static int lit_digit(void)
+{
+    HOST_GPIO_Sync();
+    int lit = -1;
+    for (int pos = 0; pos < 4; pos++)
+    {
+        if ((GPIOB->ODR & (SEG1_Pin << pos)) == 0)
+        {
+            lit = (lit == -1) ? pos : -2;
+        }
+    }
+    return lit;
+}
+
+// SEG7ARRAY_Task를 4번 호출하며 자리별로 출력된 세그먼트를 모음
+static void capture_frame(uint8_t shown[4])
+{
+    for (int i = 0; i < 4; i++)
+    {
+        SEG7ARRAY_Task();
+        int pos = lit_digit();
+        CHECK(pos >= 0);
+        if (pos >= 0)
+        {
+            shown[pos] = segments();
+        }
+    }
+}
+
+static void test_task_without_init_builds_tables(void)
+{
+    // 실행 파일의 첫 테스트: 아직 SEG7ARRAY_Init이 한 번도 불리지 않은 상태
+    uint8_t shown[4] = {0};
+
+    SEG7ARRAY_Set_cathode(1, SEG7ARRAY_Glyph('7'));
+    capture_frame(shown);
+    CHECK_EQ(shown[0], SEG7ARRAY_Glyph('7'));
+}
+
+static void test_init_blanks_all_digits(void)
+{
+    SEG7ARRAY_Init();
+    CHECK_EQ(lit_digit(), -1);
+    CHECK_EQ(segments(), 0);
+}
+
+static void test_show_int_multiplexed(void)
+{
+    uint8_t shown[4] = {0};
+
+    SEG7ARRAY_Init();
+    SEG7ARRAY_ShowInt(1234);
+    capture_frame(shown);
+
+    CHECK_EQ(shown[0], SEG7ARRAY_Glyph('1'));
+    CHECK_EQ(shown[1], SEG7ARRAY_Glyph('2'));
+    CHECK_EQ(shown[2], SEG7ARRAY_Glyph('3'));
+    CHECK_EQ(shown[3], SEG7ARRAY_Glyph('4'));
+}
+
+static void test_show_fixed_negative(void)
+{
+    uint8_t shown[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+    SEG7ARRAY_Init();
+    SEG7ARRAY_ShowFixed(-5, 1);  // "-0.5"
+    capture_frame(shown);
+
+    CHECK_EQ(shown[0], 0x00);
+    CHECK_EQ(shown[1], SEG7ARRAY_Glyph('-'));
+    CHECK_EQ(shown[2], SEG7ARRAY_Glyph('0') | 0x01);
+    CHECK_EQ(shown[3], SEG7ARRAY_Glyph('5'));
+}
+
+static void test_bsrr_tables_cover_all_patterns(void)
+{
+    // 니블 테이블 두 개의 조합으로 256가지 세그먼트 바이트가 모두 그대로 출력되는지
+    int wrong = 0;
+
+    SEG7ARRAY_Init();
+    for (int value = 0; value < 256; value++)
+    {
+        uint8_t all[4] = {(uint8_t)value, (uint8_t)value, (uint8_t)value, (uint8_t)value};
+        SEG7ARRAY_Set_all(all);
+        SEG7ARRAY_Task();
+        wrong += (segments() != value || lit_digit() < 0);
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+static void check_frame(const uint8_t expected[4])
+{
+    uint8_t shown[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    capture_frame(shown);
+    for (int pos = 0; pos < 4; pos++)
+    {
+        CHECK_EQ(shown[pos], expected[pos]);
+    }
+}
+
+static void test_show_hex(void)
+{
+    SEG7ARRAY_Init();
+    SEG7ARRAY_ShowHex(0xBEEF);
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('B'), SEG7ARRAY_Glyph('E'), SEG7ARRAY_Glyph('E'), SEG7ARRAY_Glyph('F')});
+
+    // 앞의 0도 표시
+    SEG7ARRAY_ShowHex(0x00A);
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('0'), SEG7ARRAY_Glyph('0'), SEG7ARRAY_Glyph('0'), SEG7ARRAY_Glyph('A')});
+    CHECK(SEG7ARRAY_Glyph('B') != SEG7ARRAY_Glyph('8'));
+    CHECK(SEG7ARRAY_Glyph('D') != SEG7ARRAY_Glyph('0'));
+}
+
+static void test_show_text_short(void)
+{
+    SEG7ARRAY_Init();
+
+    // 4자 이하는 왼쪽 정렬, '.'은 앞 글자의 소수점
+    SEG7ARRAY_ShowText("Hi.");
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('H'), SEG7ARRAY_Glyph('I') | 0x01, 0, 0});
+    CHECK_EQ(SEG7ARRAY_IsBlank(), 0);
+
+    // 맨 앞의 '.'이나 이미 소수점이 있는 글자 뒤의 '.'은 한 자리를 차지
+    SEG7ARRAY_ShowText("..1.");
+    check_frame((const uint8_t[4]){0x01, 0x01, SEG7ARRAY_Glyph('1') | 0x01, 0});
+
+    // '.'은 글자 수에 세지 않으므로 "1.2.3.4."는 스크롤 없이 4자리
+    SEG7ARRAY_ShowText("1.2.3.4.");
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('1') | 0x01, SEG7ARRAY_Glyph('2') | 0x01,
+                                   SEG7ARRAY_Glyph('3') | 0x01, SEG7ARRAY_Glyph('4') | 0x01});
+
+    SEG7ARRAY_ShowText("");
+    check_frame((const uint8_t[4]){0, 0, 0, 0});
+    CHECK_EQ(SEG7ARRAY_IsBlank(), 1);
+}
+
+static void test_marquee_scrolls_and_wraps(void)
+{
+    // "HELLO" + 공백 4칸을 SEG7ARRAY_SCROLL_MS마다 한 칸씩 순환
+    static const char stream[] = "HELLO    ";
+    const int length = (int)sizeof(stream) - 1;
+    uint8_t expected[4];
+
+    SEG7ARRAY_Init();
+    SEG7ARRAY_ShowText("HELLO");
+    for (int step = 0; step <= 2 * length; step++)
+    {
+        for (int pos = 0; pos < 4; pos++)
+        {
+            expected[pos] = SEG7ARRAY_Glyph(stream[(step + pos) % length]);
+        }
+        check_frame(expected);
+        CHECK_EQ(SEG7ARRAY_IsBlank(), 0);  // 화면이 비어 있는 구간도 스크롤 중이므로 비어 있지 않음
+
+        // 스크롤 시간 직전까지는 그대로, 같은 문자열을 다시 출력해도 위치 유지
+        HOST_Advance_us((SEG7ARRAY_SCROLL_MS - 1) * 1000);
+        SEG7ARRAY_ShowText("HELLO");
+        check_frame(expected);
+        HOST_Advance_us(1000);
+        SEG7ARRAY_Update();  // SEG7ARRAY_Task는 현재 자리를 출력한 뒤 스크롤하므로 먼저 진행
+    }
+
+    // 다른 문자열은 처음부터, 4자 이하로 바꾸면 스크롤이 멈춤
+    SEG7ARRAY_ShowText("WORLDS");
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('W'), SEG7ARRAY_Glyph('O'), SEG7ARRAY_Glyph('R'), SEG7ARRAY_Glyph('L')});
+    SEG7ARRAY_ShowText("OK");
+    HOST_Advance_us(SEG7ARRAY_SCROLL_MS * 3000);
+    check_frame((const uint8_t[4]){SEG7ARRAY_Glyph('O'), SEG7ARRAY_Glyph('K'), 0, 0});
+}
+
+static void test_font_table(void)
+{
+    // 숫자는 표준 7세그먼트 모양 (abcdefgp 순)
+    static const uint8_t digits[10] = {0xFC, 0x60, 0xDA, 0xF2, 0x66, 0xB6, 0xBE, 0xE0, 0xFE, 0xF6};
+    // 같은 모양으로 표시되는 글자 쌍 (7세그먼트로는 구분할 수 없음)
+    static const char *same_shape[] = {"S5", "Z2", "XH"};
+    char text[2] = {0, 0};
+
+    for (int d = 0; d < 10; d++)
+    {
+        CHECK_EQ(SEG7ARRAY_Glyph((char)('0' + d)), digits[d]);
+    }
+
+    // 모든 출력 가능 문자: 화면에 표시된 값이 SEG7ARRAY_Glyph와 같고, 소문자는 대문자와 같음
+    SEG7ARRAY_Init();
+    for (int c = 0x20; c < 0x7F; c++)
+    {
+        if (c == '.')
+        {
+            continue;  // 소수점으로 합쳐짐 (test_show_text_short)
+        }
+        text[0] = (char)c;
+        SEG7ARRAY_ShowText(text);
+        uint8_t shown[4] = {0};
+        capture_frame(shown);
+        CHECK_EQ(shown[0], SEG7ARRAY_Glyph((char)c));
+        CHECK_EQ(shown[0] & 0x01, 0);  // 소수점은 글자 모양에 쓰지 않음
+        if (c >= 'a' && c <= 'z')
+        {
+            CHECK_EQ(SEG7ARRAY_Glyph((char)c), SEG7ARRAY_Glyph((char)(c - 'a' + 'A')));
+        }
+        if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z'))
+        {
+            CHECK(SEG7ARRAY_Glyph((char)c) != 0);
+        }
+    }
+    CHECK_EQ(SEG7ARRAY_Glyph('{'), 0);
+    CHECK_EQ(SEG7ARRAY_Glyph('\n'), 0);
+
+    // 숫자와 글자 사이에서 모양이 겹치는 쌍은 same_shape뿐 (예: O가 0과 같으면 실패)
+    static const char symbols[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    int unexpected = 0;
+    for (int i = 0; symbols[i] != '\0'; i++)
+    {
+        for (int j = i + 1; symbols[j] != '\0'; j++)
+        {
+            if (SEG7ARRAY_Glyph(symbols[i]) != SEG7ARRAY_Glyph(symbols[j]))
+            {
+                continue;
+            }
+            int allowed = 0;
+            for (size_t k = 0; k < sizeof(same_shape) / sizeof(same_shape[0]); k++)
+            {
+                allowed |= (strchr(same_shape[k], symbols[i]) != NULL && strchr(same_shape[k], symbols[j]) != NULL);
+            }
+            if (!allowed)
+            {
+                printf("same glyph: '%c' '%c'\n", symbols[i], symbols[j]);
+                unexpected++;
+            }
+        }
+    }
+    CHECK_EQ(unexpected, 0);
+}
+
+// ShowInt와 같은 결과를 printf로 만든 기준 프레임
+static void reference_int(int32_t value, uint8_t frame[4])
+{
+    char text[16];
+    if (value < -999 || value > 9999)
+    {
+        memset(frame, SEG7ARRAY_Glyph('-'), 4);
+        return;
+    }
+    snprintf(text, sizeof(text), "%4ld", (long)value);
+    for (int pos = 0; pos < 4; pos++)
+    {
+        frame[pos] = SEG7ARRAY_Glyph(text[pos]);
+    }
+}
+
+static void test_show_int_matches_printf(void)
+{
+    static const int32_t edges[] = {10000, -1000, 123456, INT32_MAX, INT32_MIN, -1, 0};
+    uint8_t expected[4];
+    int wrong = 0;
+
+    SEG7ARRAY_Init();
+    for (int32_t value = -999; value <= 9999; value++)
+    {
+        reference_int(value, expected);
+        SEG7ARRAY_ShowInt(value);
+        uint8_t shown[4] = {0};
+        capture_frame(shown);
+        wrong += (memcmp(shown, expected, 4) != 0);
+    }
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        reference_int(edges[i], expected);
+        SEG7ARRAY_ShowInt(edges[i]);
+        check_frame(expected);
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void test_show_int_cost(void)
+{
+    // 시뮬레이션의 DWT는 HOST_Advance_us에서만 진행하므로 PC에서 걸린 시간(ns)을 PERF_USER0/1에 기록
+    // USER0: 값이 바뀌는 호출 (변환 + 게시), USER1: 같은 값을 다시 출력하는 호출 (비교만)
+    PERF_Stats changed;
+    PERF_Stats same;
+    volatile int32_t sink = 0;
+
+    SEG7ARRAY_Init();
+    PERF_Reset();
+    for (int batch = 0; batch < 1000; batch++)
+    {
+        uint64_t t0 = wall_ns();
+        for (int i = 0; i < 100; i++)
+        {
+            SEG7ARRAY_ShowInt((batch * 100 + i) % 10999 - 999);
+        }
+        uint64_t t1 = wall_ns();
+        for (int i = 0; i < 100; i++)
+        {
+            SEG7ARRAY_ShowInt(1234 + sink);
+        }
+        uint64_t t2 = wall_ns();
+        PERF_Record(PERF_USER0, (uint32_t)((t1 - t0) / 100));
+        PERF_Record(PERF_USER1, (uint32_t)((t2 - t1) / 100));
+    }
+    PERF_GetStats(PERF_USER0, &changed);
+    PERF_GetStats(PERF_USER1, &same);
+    CHECK_EQ(changed.count, 1000);
+    CHECK_EQ(same.count, 1000);
+
+    printf("ShowInt on this PC: %lu ns/call for a new value (min %lu), %lu ns/call for the same value (min %lu)\n",
+           (unsigned long)(changed.total / changed.count), (unsigned long)changed.min,
+           (unsigned long)(same.total / same.count), (unsigned long)same.min);
+}
+
+// 화면 갱신 주기 통계: 1번 자리가 켜지는 시각(프레임 시작) 사이의 간격 (us)
+typedef struct {
+    uint32_t frames;
+    uint32_t min_us;
+    uint32_t max_us;
+    double mean_us;
+    double stdev_us;
+} RefreshStats;
+
+static void refresh_stats(RefreshStats *stats)
+{
+    uint64_t last = 0;
+    int lit = 0;
+    double sum = 0;
+    double sum_sq = 0;
+
+    *stats = (RefreshStats){0, UINT32_MAX, 0, 0, 0};
+    for (uint32_t i = 0; i < host_gpio_log_count; i++)
+    {
+        if (host_gpio_log[i].port != 1)
+        {
+            continue;
+        }
+        int now_lit = (host_gpio_log[i].odr & SEG1_Pin) == 0;
+        if (now_lit && !lit)
+        {
+            if (last != 0)
+            {
+                uint32_t period = (uint32_t)(host_gpio_log[i].us - last);
+                stats->min_us = (period < stats->min_us) ? period : stats->min_us;
+                stats->max_us = (period > stats->max_us) ? period : stats->max_us;
+                sum += period;
+                sum_sq += (double)period * period;
+                stats->frames++;
+            }
+            last = host_gpio_log[i].us;
+        }
+        lit = now_lit;
+    }
+    if (stats->frames > 0)
+    {
+        stats->mean_us = sum / stats->frames;
+        stats->stdev_us = sqrt(sum_sq / stats->frames - stats->mean_us * stats->mean_us);
+    }
+}
+
+static void print_refresh(const char *name, const RefreshStats *stats)
+{
+    printf("%s: %lu frames, period mean %.1f us, min %lu, max %lu, stdev %.1f us\n", name,
+           (unsigned long)stats->frames, stats->mean_us, (unsigned long)stats->min_us,
+           (unsigned long)stats->max_us, stats->stdev_us);
+}
+
+static void test_polling_refresh_jitter(void)
+{
+    // 기존 while(1) 방식: SEG7ARRAY_Task 사이에 다른 처리(0.2 ~ 1.5ms)가 끼면 프레임 주기가 그만큼 흔들림
+    RefreshStats stats;
+    uint32_t seed = 11;
+
+    SEG7ARRAY_Init();
+    SEG7ARRAY_ShowInt(8888);
+    host_gpio_log_count = 0;
+    for (int i = 0; i < 400; i++)
+    {
+        SEG7ARRAY_Task();
+        seed = seed * 1103515245u + 12345u;
+        HOST_Advance_us(200 + (seed >> 16) % 1301);
+    }
+    refresh_stats(&stats);
+    print_refresh("polling refresh (main loop 0.2-1.5 ms per pass)", &stats);
+    CHECK_EQ(stats.frames, 99);
+    CHECK(stats.max_us - stats.min_us > 1000);
+}
+
+// 타이머 모드에서 window_us 동안 자리별로 켜져 있던 시간 (us)
+static void measure_on_us(uint32_t window_us, uint32_t on_us[4])
+{
+    HOST_GPIO_Sync();
+    uint64_t start = HOST_Now_us();
+    uint16_t odr = (uint16_t)GPIOB->ODR;
+    uint64_t last = start;
+
+    host_gpio_log_count = 0;
+    HOST_Advance_us(window_us);
+    uint64_t end = HOST_Now_us();
+
+    for (int pos = 0; pos < 4; pos++)
+    {
+        on_us[pos] = 0;
+    }
+    for (uint32_t i = 0; i <= host_gpio_log_count; i++)
+    {
+        int is_end = (i == host_gpio_log_count);
+        if (!is_end && host_gpio_log[i].port != 1)
+        {
+            continue;
+        }
+        uint64_t at = is_end ? end : host_gpio_log[i].us;
+        for (int pos = 0; pos < 4; pos++)
+        {
+            if ((odr & (SEG1_Pin << pos)) == 0)
+            {
+                on_us[pos] += (uint32_t)(at - last);
+            }
+        }
+        last = at;
+        if (!is_end)
+        {
+            odr = host_gpio_log[i].odr;
+        }
+    }
+}
+
+static void test_timer_mode_without_channel_is_full_on(void)
+{
+    // SEG7ARRAY_Init_IT(htim): 비교 채널 없이 밝기 0과 최대만 구분, 켜진 자리는 한 자리 주기 내내 켜짐
+    uint32_t on_us[4];
+
+    SEG7ARRAY_Init_IT(&htim4);
+    SEG7ARRAY_ShowInt(8888);
+    SEG7ARRAY_Set_brightness(8);
+    SEG7ARRAY_Set_digit_brightness(4, 0);
+    HOST_Advance_us(2000);  // 다음 프레임부터 반영
+
+    measure_on_us(20000, on_us);
+    CHECK_EQ(htim4.Instance->DIER & TIM_DIER_CC1IE, 0);
+    for (int pos = 0; pos < 3; pos++)
+    {
+        CHECK(on_us[pos] >= 20000 / 4 - SEG7ARRAY_DIGIT_TICKS && on_us[pos] <= 20000 / 4 + SEG7ARRAY_DIGIT_TICKS);
+    }
+    CHECK_EQ(on_us[3], 0);
+
+    HAL_TIM_Base_Stop_IT(&htim4);
+}
+
+static void test_timer_mode_brightness_follows_gamma(void)
+{
+    // SEG7ARRAY_Init_IT_Brightness: 자리마다 켜짐 시간 = DIGIT_TICKS * gamma / 256 (1 tick = 1us)
+    static const uint8_t levels[4] = {15, 8, 3, 1};
+    static const uint32_t expected_ticks[4] = {SEG7ARRAY_DIGIT_TICKS, SEG7ARRAY_DIGIT_TICKS * 64 / 256,
+                                               SEG7ARRAY_DIGIT_TICKS * 7 / 256, 1};
+    const uint32_t frames = 20;
+    uint32_t on_us[4];
+
+    SEG7ARRAY_Init_IT_Brightness(&htim4, TIM_CHANNEL_1);
+    SEG7ARRAY_ShowInt(8888);
+    SEG7ARRAY_Set_brightness(SEG7ARRAY_BRIGHTNESS_MAX);  // 밝기 설정은 이전 테스트에서 이어짐
+    for (int pos = 0; pos < 4; pos++)
+    {
+        SEG7ARRAY_Set_digit_brightness((uint8_t)(pos + 1), levels[pos]);
+    }
+    HOST_Advance_us(2000);
+
+    measure_on_us(frames * 4 * SEG7ARRAY_DIGIT_TICKS, on_us);
+    CHECK(htim4.Instance->DIER & TIM_DIER_CC1IE);
+    for (int pos = 0; pos < 4; pos++)
+    {
+        // 자리마다 프레임당 1번 켜지며, 인터럽트 진입 시점에 따라 1us 정도 차이가 남
+        uint32_t expected = expected_ticks[pos] * frames;
+        CHECK(on_us[pos] + frames >= expected && on_us[pos] <= expected + frames);
+    }
+
+    HAL_TIM_Base_Stop_IT(&htim4);
+    HAL_TIM_OC_Stop_IT(&htim4, TIM_CHANNEL_1);
+}
+
+static void test_timer_mode_isr_load_and_jitter(void)
+{
+    // 밝기 조절 모드: 자리마다 주기 인터럽트 1번 + 최대 밝기가 아닌 자리는 비교 일치 인터럽트 1번
+    static const uint8_t levels[4] = {15, 8, 3, 1};
+    const uint32_t frames = 100;
+    const uint32_t frame_us = 4 * SEG7ARRAY_DIGIT_TICKS;
+    RefreshStats steady;
+    RefreshStats masked;
+    PERF_Stats cost;
+    uint32_t seed = 5;
+
+    SEG7ARRAY_Init_IT_Brightness(&htim4, TIM_CHANNEL_1);
+    SEG7ARRAY_ShowInt(8888);
+    SEG7ARRAY_Set_brightness(SEG7ARRAY_BRIGHTNESS_MAX);
+    for (int pos = 0; pos < 4; pos++)
+    {
+        SEG7ARRAY_Set_digit_brightness((uint8_t)(pos + 1), levels[pos]);
+    }
+    HOST_Advance_us(2000);
+
+    // 메인 루프가 인터럽트를 막지 않으면 프레임 주기는 정확히 1 / SEG7ARRAY_REFRESH_HZ
+    uint32_t irqs = host_tim_irqs;
+    host_gpio_log_count = 0;
+    HOST_Advance_us(frames * frame_us);
+    irqs = host_tim_irqs - irqs;
+    refresh_stats(&steady);
+    CHECK_EQ(irqs, frames * (4 + 3));
+    CHECK_EQ(steady.frames, frames - 1);
+    CHECK_EQ(steady.min_us, frame_us);
+    CHECK_EQ(steady.max_us, frame_us);
+
+    // 메인 루프의 임계 구역(최대 30us)이 인터럽트를 늦추면 프레임 시작도 그만큼만 흔들림
+    host_gpio_log_count = 0;
+    for (uint64_t end = HOST_Now_us() + frames * frame_us; HOST_Now_us() < end;)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if ((seed >> 16) % 4 == 0)
+        {
+            __disable_irq();
+            HOST_Advance_us(1 + (seed >> 8) % 30);
+            __enable_irq();
+        }
+        else
+        {
+            HOST_Advance_us(10);
+        }
+    }
+    refresh_stats(&masked);
+    CHECK(masked.min_us + 30 >= frame_us && masked.max_us <= frame_us + 30);
+
+    // 인터럽트 한 번의 처리 시간: 시뮬레이션의 DWT는 HOST_Advance_us에서만 진행하므로 PC에서 걸린 시간(ns)을 PERF_USER0에 기록
+    // (보드의 클럭 수는 "perf show"의 seg7_cycle로 확인)
+    HAL_TIM_Base_Stop_IT(&htim4);
+    HAL_TIM_OC_Stop_IT(&htim4, TIM_CHANNEL_1);
+    PERF_Reset();
+    for (int batch = 0; batch < 1000; batch++)
+    {
+        uint64_t t0 = wall_ns();
+        for (int i = 0; i < 100; i++)
+        {
+            SEG7ARRAY_TIM_Callback();
+            SEG7ARRAY_TIM_OC_Callback();
+        }
+        PERF_Record(PERF_USER0, (uint32_t)((wall_ns() - t0) / 200));
+    }
+    PERF_GetStats(PERF_USER0, &cost);
+    double isr_ns = (double)cost.total / cost.count;
+    double frame_isr_ns = isr_ns * irqs / frames;
+
+    printf("timer refresh: %lu interrupts per frame, %.0f ns per interrupt on this PC -> %.0f ns per frame, "
+           "%.2f%% CPU at %d frames/s\n",
+           (unsigned long)(irqs / frames), isr_ns, frame_isr_ns, frame_isr_ns * SEG7ARRAY_REFRESH_HZ / 1e7,
+           SEG7ARRAY_REFRESH_HZ);
+    print_refresh("timer refresh (no masking)", &steady);
+    print_refresh("timer refresh (main loop masks IRQs up to 30 us)", &masked);
+}
+
+int main(void)
+{
+    RUN_TEST(test_task_without_init_builds_tables);  // 반드시 첫 번째
+    RUN_TEST(test_init_blanks_all_digits);
+    RUN_TEST(test_show_int_multiplexed);
+    RUN_TEST(test_show_fixed_negative);
+    RUN_TEST(test_bsrr_tables_cover_all_patterns);
+    RUN_TEST(test_show_hex);
+    RUN_TEST(test_show_text_short);
+    RUN_TEST(test_marquee_scrolls_and_wraps);
+    RUN_TEST(test_font_table);
+    RUN_TEST(test_show_int_matches_printf);
+    RUN_TEST(test_show_int_cost);
+    RUN_TEST(test_polling_refresh_jitter);
+    RUN_TEST(test_timer_mode_without_channel_is_full_on);  // 타이머 모드는 폴링 테스트 뒤에
+    RUN_TEST(test_timer_mode_brightness_follows_gamma);
+    RUN_TEST(test_timer_mode_isr_load_and_jitter);
+    return TEST_EXIT();
+}
@@ -0,0 +1,551 @@
+/*
+ * test_speaker.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * speaker: 출력 방식별 실제 주파수, 음 경계 시간(템포 변경, 페이드 포함), RTTTL 변환, DDS 합성과 합성 속도
+ * 실행하면 README의 주파수 표(SPEAKER 4. 타이머 출력 방식)에 들어가는 행을 출력함
+ * 인자로 파일 경로를 주면 DDS로 합성한 화음을 WAV로 저장함 (speaker_wav_check.cmake가 C/SMLAD 결과를 비교)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "host_test.h"
+#include "perf.h"
+#include "speaker.h"
+
+// README 표의 요청 주파수
+static const uint32_t table_hz[] = {262, 440, 880, 4186, 6000, 8000};
+
+// 인터럽트 방식: window_us 동안 스피커 핀의 상승 에지 간격으로 잰 주파수
+static double measure_toggle_hz(uint32_t frequency, uint32_t window_us)
+{
+    uint64_t first = 0;
+    uint64_t last = 0;
+    uint32_t edges = 0;
+    uint16_t odr = 0;
+
+    // 타이머 출력 방식 테스트가 PSC/ARR을 바꾸므로 100kHz 설정으로 되돌림
+    __HAL_TIM_SET_PRESCALER(&htim11, 0);
+    __HAL_TIM_SET_AUTORELOAD(&htim11, 840 - 1);
+    SPEAKER_Init(&htim11);
+    SPEAKER_Start(frequency, window_us / 1000 + 10);
+    HOST_GPIO_Sync();
+    odr = (uint16_t)GPIOA->ODR;
+    host_gpio_log_count = 0;
+    HOST_Advance_us(window_us);
+    SPEAKER_Stop();
+
+    for (uint32_t i = 0; i < host_gpio_log_count; i++)
+    {
+        if (host_gpio_log[i].port != 0)
+        {
+            continue;
+        }
+        uint16_t now = host_gpio_log[i].odr;
+        if ((now & Speaker_Pin) && !(odr & Speaker_Pin))
+        {
+            if (edges == 0)
+            {
+                first = host_gpio_log[i].us;
+            }
+            last = host_gpio_log[i].us;
+            edges++;
+        }
+        odr = now;
+    }
+    CHECK(edges > 2);
+    return edges > 2 ? (double)(edges - 1) * 1000000.0 / (double)(last - first) : 0;
+}
+
+// 타이머 출력 방식: SPEAKER_Start가 설정한 PSC/ARR로 계산한 PWM 주파수
+static double measure_pwm_hz(uint32_t frequency)
+{
+    SPEAKER_Init_PWM(&htim11, TIM_CHANNEL_1);
+    SPEAKER_Start(frequency, 10);
+    uint32_t psc = htim11.Instance->PSC;
+    uint32_t arr = htim11.Instance->ARR;
+    uint32_t ccr = htim11.Instance->CCR1;
+    SPEAKER_Stop();
+
+    CHECK(arr <= 0xFFFF);
+    CHECK_EQ(ccr, (arr + 1) / 2);  // 최대 음량: duty 50%
+    return (double)SPEAKER_TIM_CLOCK_HZ / ((double)(psc + 1) * (double)(arr + 1));
+}
+
+static double error_percent(double actual, uint32_t requested)
+{
+    return (actual - requested) * 100.0 / requested;
+}
+
+static void test_pwm_reload_rounds_to_nearest(void)
+{
+    // 분주 전 주기를 PSC+1로 나눌 때 반올림: 가능한 (PSC, ARR) 중 오차가 가장 작은 값을 골라야 함
+    for (uint32_t frequency = 100; frequency <= 10000; frequency += 7)
+    {
+        double actual = measure_pwm_hz(frequency);
+        uint32_t psc = htim11.Instance->PSC;
+        uint32_t reload = htim11.Instance->ARR + 1;
+        double ideal = (double)SPEAKER_TIM_CLOCK_HZ / frequency / (psc + 1);
+        CHECK(reload >= ideal - 0.5 - 1.0 / (psc + 1) && reload <= ideal + 0.5 + 1.0 / (psc + 1));
+        CHECK(error_percent(actual, frequency) < 0.01 && error_percent(actual, frequency) > -0.01);
+    }
+}
+
+static void test_frequency_table(void)
+{
+    printf("| 요청 주파수 (Hz) | 기존 인터럽트 방식 | 타이머 출력 방식 |\n");
+    for (size_t i = 0; i < sizeof(table_hz) / sizeof(table_hz[0]); i++)
+    {
+        uint32_t frequency = table_hz[i];
+        double toggle = measure_toggle_hz(frequency, 200000);
+        double pwm = measure_pwm_hz(frequency);
+
+        // 인터럽트 방식은 100kHz 샘플 수를 반올림한 주기
+        uint32_t ticks = (100000 + frequency / 2) / frequency;
+        CHECK(toggle > 100000.0 / ticks - 0.05 && toggle < 100000.0 / ticks + 0.05);
+        CHECK(error_percent(pwm, frequency) < 0.002 && error_percent(pwm, frequency) > -0.002);
+
+        printf("| %lu | %.1f (%+.2f%%) | %.3f (%+.4f%%) |\n", (unsigned long)frequency,
+               toggle, error_percent(toggle, frequency), pwm, error_percent(pwm, frequency));
+    }
+}
+
+// 인터럽트 방식으로 큐를 재생하며 핀 로그를 남김 (at_ms에 tempo가 0이 아니면 템포 변경, fade_ms가 0이 아니면 페이드 시작)
+static void play_toggle(const SPEAKER_Note *notes, uint16_t count, uint32_t total_ms,
+                        uint32_t at_ms, uint16_t tempo, uint32_t fade_ms)
+{
+    __HAL_TIM_SET_PRESCALER(&htim11, 0);
+    __HAL_TIM_SET_AUTORELOAD(&htim11, 840 - 1);
+    SPEAKER_Init(&htim11);
+    SPEAKER_SetTempo(100);
+    host_gpio_log_count = 0;
+    CHECK_EQ(SPEAKER_Enqueue(notes, count), count);
+    for (uint32_t ms = 0; ms < total_ms; ms++)
+    {
+        if (ms == at_ms && tempo != 0)
+        {
+            SPEAKER_SetTempo(tempo);
+        }
+        if (ms == at_ms && fade_ms != 0)
+        {
+            SPEAKER_FadeOut(fade_ms);
+        }
+        HOST_Advance_us(1000);
+    }
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+    SPEAKER_SetTempo(100);
+}
+
+// 핀 로그에서 음이 시작된 시각(쉼 뒤의 첫 상승 에지)과 마지막 에지 시각을 찾음
+static uint32_t find_onsets(uint64_t *onsets, uint32_t max, uint64_t *last_edge)
+{
+    uint32_t count = 0;
+    uint64_t prev_rise = 0;
+    uint16_t odr = 0;
+
+    CHECK(host_gpio_log_count < HOST_GPIO_LOG_SIZE);
+    for (uint32_t i = 0; i < host_gpio_log_count; i++)
+    {
+        if (host_gpio_log[i].port != 0 || ((host_gpio_log[i].odr ^ odr) & Speaker_Pin) == 0)
+        {
+            continue;
+        }
+        uint64_t t = host_gpio_log[i].us;
+        odr = host_gpio_log[i].odr;
+        *last_edge = t;
+        if (odr & Speaker_Pin)
+        {
+            // 가장 낮은 음(440Hz)의 주기보다 길게 조용했으면 새 음
+            if ((count == 0 || t - prev_rise > 4000) && count < max)
+            {
+                onsets[count++] = t;
+            }
+            prev_rise = t;
+        }
+    }
+    return count;
+}
+
+static void test_note_boundaries_follow_durations(void)
+{
+    // 모든 음 뒤에 쉼이 있어서 핀 로그에서 시작 시각을 구분할 수 있음
+    static const SPEAKER_Note notes[] = {
+        {440, 100, 10}, {880, 60, 5}, {0, 20, 0}, {660, 80, 20}, {1000, 50, 5}
+    };
+    // 소리 나는 음의 시작 간격 (us): 100+10, 60+5+20(쉼표), 80+20
+    static const uint32_t expected_us[] = {110000, 85000, 100000};
+    uint64_t onsets[8];
+    uint64_t last_edge = 0;
+
+    play_toggle(notes, 5, 400, 0, 0, 0);
+    uint32_t count = find_onsets(onsets, 8, &last_edge);
+    CHECK_EQ(count, 4);
+    printf("note boundaries at tempo 100 (requested -> measured us):");
+    for (uint32_t i = 0; i + 1 < count && i < 3; i++)
+    {
+        int64_t measured = (int64_t)(onsets[i + 1] - onsets[i]);
+        printf(" %lu -> %lld", (unsigned long)expected_us[i], (long long)measured);
+        CHECK(measured >= (int64_t)expected_us[i] - 10 && measured <= (int64_t)expected_us[i] + 10);  // 100kHz 한 샘플
+    }
+    // 마지막 음(1000Hz, 50ms)은 50ms 안에서 끝나고 한 주기(1ms)보다 일찍 끝나지 않음
+    printf(", last note sounds %lu us of 50000\n", (unsigned long)(last_edge - onsets[3]));
+    CHECK(last_edge - onsets[3] <= 50000 + 10 && last_edge - onsets[3] >= 49000);
+}
+
+static void test_tempo_change_applies_from_next_note(void)
+{
+    static const SPEAKER_Note notes[] = {{440, 100, 10}, {880, 60, 10}, {660, 80, 20}};
+    uint64_t onsets[4];
+    uint64_t last_edge = 0;
+
+    // 첫 음이 재생 중일 때 2배 빠르게: 첫 음은 그대로 110ms, 다음 음부터 절반 (60+10 -> 35ms)
+    play_toggle(notes, 3, 300, 50, 200, 0);
+    uint32_t count = find_onsets(onsets, 4, &last_edge);
+    CHECK_EQ(count, 3);
+    int64_t first = (int64_t)(onsets[1] - onsets[0]);
+    int64_t second = (int64_t)(onsets[2] - onsets[1]);
+    printf("tempo 100 -> 200 during note 1: 110000 -> %lld us, 35000 -> %lld us, last note %lu us of 40000\n",
+           (long long)first, (long long)second, (unsigned long)(last_edge - onsets[2]));
+    CHECK(first >= 110000 - 10 && first <= 110000 + 10);
+    CHECK(second >= 35000 - 10 && second <= 35000 + 10);
+    CHECK(last_edge - onsets[2] <= 40000 + 10 && last_edge - onsets[2] >= 40000 - 2300);
+}
+
+static void test_fade_out_ends_on_time(void)
+{
+    static const SPEAKER_Note note = {440, 1000, 0};
+    uint64_t onsets[2];
+    uint64_t last_edge = 0;
+
+    // 100ms에 50ms 페이드: 150ms에 소리가 멈추고, 그 사이 High 구간이 줄어듦
+    play_toggle(&note, 1, 300, 100, 0, 50);
+    CHECK_EQ(find_onsets(onsets, 2, &last_edge), 1);  // 페이드 중에 상승 에지가 빠진 주기(한 주기 내내 High)가 없음
+    uint64_t fade_end = onsets[0] + 150000;
+    printf("fade 50 ms from 100 ms: sound stops %lld us after the requested end\n",
+           (long long)((int64_t)last_edge - (int64_t)fade_end));
+    CHECK(last_edge <= fade_end + 10 && last_edge >= fade_end - 2300);
+
+    // 페이드 전 한 주기와 마지막 주기의 High 구간 비교
+    uint64_t rise = 0;
+    uint64_t first_high = 0;
+    uint64_t last_high = 0;
+    for (uint32_t i = 0; i < host_gpio_log_count; i++)
+    {
+        if (host_gpio_log[i].port != 0)
+        {
+            continue;
+        }
+        if (host_gpio_log[i].odr & Speaker_Pin)
+        {
+            rise = host_gpio_log[i].us;
+        }
+        else if (rise != 0 && host_gpio_log[i].us > rise)
+        {
+            if (first_high == 0)
+            {
+                first_high = host_gpio_log[i].us - rise;
+            }
+            last_high = host_gpio_log[i].us - rise;
+            rise = 0;
+        }
+    }
+    CHECK(first_high >= 1130 && first_high <= 1140);  // 2270us 주기의 50%
+    CHECK(last_high < first_high / 4);
+}
+
+static void test_rtttl_clamps_very_long_notes(void)
+{
+    SPEAKER_Note notes[2];
+
+    // b=4: 온음표 60000ms, 점온음표 90000ms는 uint16_t에 들어가지 않으므로 65535ms로 제한
+    CHECK_EQ(SPEAKER_ParseRTTTL("slow:d=1,o=5,b=4:c.,c", notes, 2), 2);
+    CHECK_EQ(notes[0].duration_ms + notes[0].gap_ms, 65535);
+    CHECK_EQ(notes[1].duration_ms + notes[1].gap_ms, 60000);
+}
+
+static void test_calls_keep_interrupts_masked(void)
+{
+    static const SPEAKER_Note note = {440, 10, 0};
+
+    // 임계 구역 안에서 호출해도 인터럽트를 다시 켜면 안 됨
+    SPEAKER_Init_PWM(&htim11, TIM_CHANNEL_1);
+    __disable_irq();
+    SPEAKER_Start(440, 10);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_SetLoop(1);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_SetLoop(0);
+    SPEAKER_Enqueue(&note, 1);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_Update();
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_FadeOut(5);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_Stop();
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+}
+
+static void test_rtttl_sharp_b_carries_into_next_octave(void)
+{
+    SPEAKER_Note notes[8];
+    uint16_t count = SPEAKER_ParseRTTTL("t:d=4,o=5,b=120:b#,b#7,b#8,c,8p,a#4.", notes, 8);
+
+    CHECK_EQ(count, 6);
+    CHECK_EQ(notes[0].frequency, 1047);  // b#5 = C6
+    CHECK_EQ(notes[1].frequency, 4186);  // b#7 = C8
+    CHECK_EQ(notes[2].frequency, 4186);  // b#8 = C9 -> 옥타브 8로 제한
+    CHECK_EQ(notes[3].frequency, 523);   // C5
+    CHECK_EQ(notes[4].frequency, 0);     // 쉼표
+    CHECK_EQ(notes[5].frequency, 466);   // A#4
+
+    // 온음표 2000ms, 길이의 1/16은 쉬는 시간
+    CHECK_EQ(notes[0].duration_ms + notes[0].gap_ms, 500);
+    CHECK_EQ(notes[0].gap_ms, 500 / 16);
+    CHECK_EQ(notes[4].duration_ms + notes[4].gap_ms, 250);
+    CHECK_EQ(notes[5].duration_ms + notes[5].gap_ms, 750);  // 점음표
+}
+
+// DDS 방식: DMA 버퍼를 절반씩 읽고, 다 읽은 절반을 DMA 콜백으로 다시 채움 (DMA 전송 대신)
+static void dds_collect(uint16_t *samples, uint32_t count)
+{
+    const uint16_t *buffer = (const uint16_t *)htim11.host_dma_data;
+    for (uint32_t i = 0; i < count; i += SPEAKER_DDS_BLOCK)
+    {
+        uint32_t half = (i / SPEAKER_DDS_BLOCK) & 1;
+        for (uint32_t j = 0; j < SPEAKER_DDS_BLOCK && i + j < count; j++)
+        {
+            samples[i + j] = buffer[half * SPEAKER_DDS_BLOCK + j];
+        }
+        if (half == 0)
+        {
+            SPEAKER_DMA_HalfCpltCallback();
+        }
+        else
+        {
+            SPEAKER_DMA_CpltCallback();
+        }
+    }
+}
+
+static void test_dds_frequency(void)
+{
+    // 1초 분량의 샘플에서 무음 duty를 아래에서 위로 지나는 횟수 = 주파수
+    static uint16_t samples[SPEAKER_DDS_SAMPLE_RATE];
+    const uint16_t center = SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE / 2;
+
+    SPEAKER_Init_DDS(&htim11, TIM_CHANNEL_1);
+    CHECK_EQ(htim11.Instance->ARR + 1, SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE);
+    for (size_t i = 0; i < sizeof(table_hz) / sizeof(table_hz[0]); i++)
+    {
+        uint32_t crossings = 0;
+
+        SPEAKER_DDS_Play(0, table_hz[i], SPEAKER_WAVE_SINE, 255);
+        CHECK(htim11.host_dma_data != NULL);
+        dds_collect(samples, SPEAKER_DDS_BLOCK * 2);  // 이전 주파수로 채워져 있던 두 절반은 버림
+        dds_collect(samples, SPEAKER_DDS_SAMPLE_RATE);
+        for (uint32_t n = 1; n < SPEAKER_DDS_SAMPLE_RATE; n++)
+        {
+            crossings += (samples[n - 1] < center && samples[n] >= center);
+        }
+        CHECK(crossings + 1 >= table_hz[i] && crossings <= table_hz[i] + 1);
+    }
+
+    SPEAKER_DDS_Stop(0);
+    dds_collect(samples, SPEAKER_DDS_BLOCK);
+    CHECK(htim11.host_dma_data == NULL);  // 모든 목소리가 꺼지면 DMA 정지
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+}
+
+static void test_dds_full_chord_stays_in_range(void)
+{
+    // 모든 목소리가 최대 음량이어도 duty가 0 ~ ARR을 넘지 않음
+    static uint16_t samples[SPEAKER_DDS_SAMPLE_RATE / 10];
+    const uint32_t arr = SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE - 1;
+    uint16_t lowest = 0xFFFF;
+    uint16_t highest = 0;
+
+    SPEAKER_Init_DDS(&htim11, TIM_CHANNEL_1);
+    for (uint8_t voice = 0; voice < SPEAKER_DDS_VOICES; voice++)
+    {
+        SPEAKER_DDS_Play(voice, 100, SPEAKER_WAVE_SQUARE, 255);  // 같은 위상의 사각파: 가장 큰 합
+    }
+    dds_collect(samples, sizeof(samples) / sizeof(samples[0]));
+    for (size_t n = 0; n < sizeof(samples) / sizeof(samples[0]); n++)
+    {
+        lowest = samples[n] < lowest ? samples[n] : lowest;
+        highest = samples[n] > highest ? samples[n] : highest;
+    }
+    CHECK(highest <= arr);
+    CHECK(highest > arr * 9 / 10 && lowest < arr / 10);  // 거의 전체 범위를 사용
+
+    for (uint8_t voice = 0; voice < SPEAKER_DDS_VOICES; voice++)
+    {
+        SPEAKER_DDS_Stop(voice);
+    }
+    dds_collect(samples, SPEAKER_DDS_BLOCK);
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+}
+
+#define WAV_SAMPLES (SPEAKER_DDS_SAMPLE_RATE / 2)
+
+static int16_t wav_pcm[WAV_SAMPLES];
+
+// 한 주파수 성분의 크기 (Goertzel)
+static double goertzel(const int16_t *x, uint32_t n, double frequency)
+{
+    double w = 2.0 * 3.14159265358979 * frequency / SPEAKER_DDS_SAMPLE_RATE;
+    double coeff = 2.0 * cos(w);
+    double s1 = 0;
+    double s2 = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double s0 = x[i] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return sqrt(s1 * s1 + s2 * s2 - coeff * s1 * s2) / n;
+}
+
+static void put_le(uint8_t *p, uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void test_dds_render_wav(const char *path)
+{
+    // A 장조 화음 (목소리마다 다른 파형/음량) 0.5초를 PWM duty에서 16비트 PCM으로 바꿈
+    static uint16_t samples[WAV_SAMPLES];
+    const int32_t center = SPEAKER_TIM_CLOCK_HZ / SPEAKER_DDS_SAMPLE_RATE / 2;
+
+    SPEAKER_Init_DDS(&htim11, TIM_CHANNEL_1);
+    SPEAKER_DDS_Play(0, 440, SPEAKER_WAVE_SINE, 255);
+    SPEAKER_DDS_Play(1, 554, SPEAKER_WAVE_TRIANGLE, 200);
+    SPEAKER_DDS_Play(2, 659, SPEAKER_WAVE_SINE, 128);
+    dds_collect(samples, WAV_SAMPLES);
+    for (uint32_t n = 0; n < WAV_SAMPLES; n++)
+    {
+        wav_pcm[n] = (int16_t)(((int32_t)samples[n] - center) * 32767 / center);
+    }
+
+    // 세 음이 음량 순서대로 들어 있고, 화음에 없는 주파수는 거의 없음
+    double a = goertzel(wav_pcm, WAV_SAMPLES, 440);
+    double cs = goertzel(wav_pcm, WAV_SAMPLES, 554);
+    double e = goertzel(wav_pcm, WAV_SAMPLES, 659);
+    double off = goertzel(wav_pcm, WAV_SAMPLES, 500) + goertzel(wav_pcm, WAV_SAMPLES, 1000);
+    printf("DDS chord (SMLAD %d): 440 Hz %.0f, 554 Hz %.0f, 659 Hz %.0f, 500+1000 Hz %.0f\n",
+           SPEAKER_DDS_USE_SMLAD, a, cs, e, off);
+    CHECK(a > cs && cs > e && e > 20 * off);
+
+    for (uint8_t voice = 0; voice < 3; voice++)
+    {
+        SPEAKER_DDS_Stop(voice);
+    }
+    dds_collect(samples, SPEAKER_DDS_BLOCK);
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+
+    if (path == NULL)
+    {
+        return;
+    }
+    uint8_t header[44] = "RIFF....WAVEfmt ....................data....";
+    put_le(&header[4], 36 + sizeof(wav_pcm), 4);
+    put_le(&header[16], 16, 4);                            // fmt 크기
+    put_le(&header[20], 1, 2);                             // PCM
+    put_le(&header[22], 1, 2);                             // 모노
+    put_le(&header[24], SPEAKER_DDS_SAMPLE_RATE, 4);
+    put_le(&header[28], SPEAKER_DDS_SAMPLE_RATE * 2, 4);   // 초당 바이트
+    put_le(&header[32], 2, 2);                             // 샘플당 바이트
+    put_le(&header[34], 16, 2);                            // 비트 수
+    put_le(&header[40], sizeof(wav_pcm), 4);
+    FILE *f = fopen(path, "wb");
+    CHECK(f != NULL);
+    if (f != NULL)
+    {
+        fwrite(header, 1, sizeof(header), f);
+        for (uint32_t n = 0; n < WAV_SAMPLES; n++)
+        {
+            uint8_t le[2];
+            put_le(le, (uint16_t)wav_pcm[n], 2);
+            fwrite(le, 1, 2, f);
+        }
+        fclose(f);
+    }
+}
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void test_dds_synthesis_throughput(void)
+{
+    // 모든 목소리를 켠 채로 2000블록 합성에 걸린 PC 시간 (보드에서는 "perf show"의 speaker_dds가 블록당 클럭 수)
+    static uint16_t samples[SPEAKER_DDS_BLOCK * 2000];
+    PERF_Stats stats;
+
+    SPEAKER_Init_DDS(&htim11, TIM_CHANNEL_1);
+    for (uint8_t voice = 0; voice < SPEAKER_DDS_VOICES; voice++)
+    {
+        SPEAKER_DDS_Play(voice, 200 + 100 * voice, SPEAKER_WAVE_SINE, 255);
+    }
+    PERF_Reset();
+    uint64_t t0 = wall_ns();
+    dds_collect(samples, sizeof(samples) / sizeof(samples[0]));
+    double ns_per_block = (double)(wall_ns() - t0) / 2000;
+    PERF_GetStats(PERF_SPEAKER_DDS_FILL, &stats);
+    CHECK_EQ(stats.count, 2000);
+
+    printf("DDS synthesis (SMLAD %d, %d voices): %.0f ns/block, %.1f Msamples/s on this PC"
+           " (real time needs %d samples/s, one block per %d us)\n",
+           SPEAKER_DDS_USE_SMLAD, SPEAKER_DDS_VOICES, ns_per_block, SPEAKER_DDS_BLOCK * 1000.0 / ns_per_block,
+           SPEAKER_DDS_SAMPLE_RATE, SPEAKER_DDS_BLOCK * 1000000 / SPEAKER_DDS_SAMPLE_RATE);
+
+    for (uint8_t voice = 0; voice < SPEAKER_DDS_VOICES; voice++)
+    {
+        SPEAKER_DDS_Stop(voice);
+    }
+    dds_collect(samples, SPEAKER_DDS_BLOCK);
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+}
+
+static void test_dds_calls_keep_interrupts_masked(void)
+{
+    SPEAKER_Init_DDS(&htim11, TIM_CHANNEL_1);
+    __disable_irq();
+    SPEAKER_DDS_Play(1, 440, SPEAKER_WAVE_SINE, 255);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    SPEAKER_DDS_Stop(1);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    uint16_t samples[SPEAKER_DDS_BLOCK];
+    dds_collect(samples, SPEAKER_DDS_BLOCK);
+    CHECK_EQ(SPEAKER_IsPlaying(), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    RUN_TEST(test_pwm_reload_rounds_to_nearest);
+    RUN_TEST(test_frequency_table);
+    RUN_TEST(test_note_boundaries_follow_durations);
+    RUN_TEST(test_tempo_change_applies_from_next_note);
+    RUN_TEST(test_fade_out_ends_on_time);
+    RUN_TEST(test_calls_keep_interrupts_masked);
+    RUN_TEST(test_rtttl_sharp_b_carries_into_next_octave);
+    RUN_TEST(test_rtttl_clamps_very_long_notes);
+    RUN_TEST(test_dds_frequency);
+    RUN_TEST(test_dds_full_chord_stays_in_range);
+    RUN_TEST(test_dds_calls_keep_interrupts_masked);
+    RUN_TEST(test_dds_synthesis_throughput);
+    test_dds_render_wav(argc > 1 ? argv[1] : NULL);
+    return TEST_EXIT();
+}
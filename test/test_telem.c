@@ -0,0 +1,168 @@
+/*
+ * test_telem.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * telem: 타이머 폭에 맞는 주기, 임계 구역 안에서의 호출, 115200bps에서 보낼 수 있는 레코드 수
+ * 인자로 파일 경로를 주면 마지막 테스트의 UART 출력을 저장함 (telemetry_decode_check.cmake가 디코더로 확인)
+ */
+
+#include <stdio.h>
+#include "host_test.h"
+#include "telem.h"
+#include "usart2console.h"
+
+static volatile int16_t temp;
+static volatile uint16_t adc[2];
+static volatile float gain;
+static volatile uint32_t words[4];
+
+static void setup(TIM_HandleTypeDef *htim)
+{
+    U2C_init();
+    TELEM_Init(htim);
+}
+
+// 1ms마다 TELEM_Task와 U2C_process를 호출하며 진행
+static void run_ms(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        HOST_Advance_us(1000);
+        TELEM_Task();
+        U2C_process();
+    }
+}
+
+// 다음 테스트가 UART 핸들을 초기화하기 전에 송신을 끝냄
+static void stop_and_drain(void)
+{
+    TELEM_Stop();
+    for (int i = 0; i < 1000 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+    {
+        run_ms(1);
+    }
+}
+
+static void test_start_rejects_period_over_timer_width(void)
+{
+    // 16비트 타이머: 1MHz / 16Hz - 1 = 62499까지 가능, 15Hz는 66665라서 ARR에 들어가지 않음
+    setup(&htim10);
+    CHECK_EQ(TELEM_Start(15), HAL_ERROR);
+    CHECK_EQ(TELEM_Start(16), HAL_OK);
+    CHECK_EQ(htim10.Instance->ARR, 62499);
+    CHECK_EQ(TELEM_Start(0), HAL_ERROR);
+    CHECK_EQ(TELEM_Start(10001), HAL_ERROR);
+    stop_and_drain();
+
+    // 32비트 타이머는 1Hz도 가능
+    setup(&htim2);
+    CHECK_EQ(TELEM_Start(1), HAL_OK);
+    CHECK_EQ(htim2.Instance->ARR, 999999);
+    stop_and_drain();
+}
+
+static void test_calls_keep_interrupts_masked(void)
+{
+    TELEM_Stats stats;
+
+    setup(&htim10);
+    CHECK_EQ(TELEM_Register("temp", &temp, TELEM_I16, 1), HAL_OK);
+
+    // 임계 구역 안에서 호출해도 인터럽트를 다시 켜면 안 됨
+    __disable_irq();
+    CHECK_EQ(TELEM_Start(100), HAL_OK);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    TELEM_Task();  // 변수 목록
+    CHECK_EQ(__get_PRIMASK(), 1);
+    TELEM_TIM_Callback();
+    TELEM_Task();  // 레코드
+    CHECK_EQ(__get_PRIMASK(), 1);
+    TELEM_GetStats(&stats);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+
+    CHECK_EQ(stats.samples, 1);
+    CHECK_EQ(stats.sent, 1);
+    stop_and_drain();
+}
+
+static void test_throughput_at_115200(void)
+{
+    TELEM_Stats stats;
+    TELEM_Stats before;
+
+    // 24바이트 레코드 (머리 8 + 16) = 프레임 30바이트, 115200bps는 초당 11520바이트라서 최대 384Hz
+    setup(&htim10);
+    CHECK_EQ(TELEM_Register("words", words, TELEM_U32, 4), HAL_OK);
+    CHECK_EQ(huart2.Init.BaudRate, 115200);
+
+    // 350Hz: 잃는 레코드 없음
+    CHECK_EQ(TELEM_Start(350), HAL_OK);
+    run_ms(1000);
+    TELEM_GetStats(&stats);
+    CHECK(stats.samples >= 349 && stats.samples <= 351);
+    CHECK_EQ(stats.overruns, 0);
+    CHECK(stats.sent + 1 >= stats.samples);
+    stop_and_drain();
+
+    // 500Hz: UART가 병목, 송신 링 버퍼가 찬 뒤에는 초당 보낸 레코드 수가 약 380개에서 멈춤
+    CHECK_EQ(TELEM_Start(500), HAL_OK);
+    run_ms(1000);
+    TELEM_GetStats(&before);
+    run_ms(1000);
+    TELEM_GetStats(&stats);
+    uint32_t sent = stats.sent - before.sent;
+    printf("115200bps, 24-byte record: %lu of %lu records sent in 1 s\n",
+           (unsigned long)sent, (unsigned long)(stats.samples - before.samples));
+    CHECK(sent >= 375 && sent <= 390);
+    CHECK(stats.overruns > before.overruns);
+    CHECK(stats.sent + stats.overruns + 1 >= stats.samples);
+    stop_and_drain();
+}
+
+static void test_decoder_capture(void)
+{
+    // 콘솔 텍스트와 섞인 레코드 5개 (telemetry_decode_check.cmake가 이 값을 확인)
+    setup(&htim10);
+    temp = -5;
+    adc[0] = 1000;
+    adc[1] = 2000;
+    gain = 1.5f;
+    CHECK_EQ(TELEM_Register("temp", &temp, TELEM_I16, 1), HAL_OK);
+    CHECK_EQ(TELEM_Register("adc", adc, TELEM_U16, 2), HAL_OK);
+    CHECK_EQ(TELEM_Register("gain", &gain, TELEM_F32, 1), HAL_OK);
+
+    U2C_printf("console before" NEWLINE_CHARACTER);
+    CHECK_EQ(TELEM_Start(200), HAL_OK);
+    run_ms(12);
+    U2C_printf("console between" NEWLINE_CHARACTER);
+    run_ms(13);
+    stop_and_drain();
+
+    TELEM_Stats stats;
+    TELEM_GetStats(&stats);
+    CHECK_EQ(stats.samples, 5);
+    CHECK_EQ(stats.sent, 5);
+}
+
+int main(int argc, char *argv[])
+{
+    RUN_TEST(test_start_rejects_period_over_timer_width);
+    RUN_TEST(test_calls_keep_interrupts_masked);
+    RUN_TEST(test_throughput_at_115200);
+    RUN_TEST(test_decoder_capture);
+
+    if (argc > 1)
+    {
+        FILE *f = fopen(argv[1], "wb");
+        CHECK(f != NULL);
+        if (f != NULL)
+        {
+            fwrite(host_uart_capture, 1, host_uart_capture_len, f);
+            fclose(f);
+        }
+    }
+    return TEST_EXIT();
+}
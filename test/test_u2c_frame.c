@@ -0,0 +1,169 @@
+/*
+ * test_u2c_frame.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * usart2console 바이너리 프레임: U2C_send_frame 출력을 테스트 쪽 COBS/CRC로 풀고, 같은 바이트를 다시 수신해 봄
+ */
+
+#include <string.h>
+#include "host_test.h"
+#include "usart2console.h"
+
+static void drain(void)
+{
+    for (int i = 0; i < 1000 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+    {
+        HOST_Advance_us(1000);
+        U2C_process();
+    }
+}
+
+// CRC-16/CCITT-FALSE (usart2console.h의 프레임 설명과 같은 정의)
+static uint16_t crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// 0x00 구분자 사이의 COBS 블록을 풀어 `out`에 쓰고 길이를 반환 (형식 오류면 -1)
+static int cobs_decode(const uint8_t *in, size_t length, uint8_t *out)
+{
+    size_t i = 0;
+    int n = 0;
+    while (i < length)
+    {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > length)
+        {
+            return -1;
+        }
+        for (uint8_t k = 1; k < code; k++)
+        {
+            out[n++] = in[i++];
+        }
+        if (code != 0xFF && i < length)
+        {
+            out[n++] = 0x00;
+        }
+    }
+    return n;
+}
+
+// 캡처의 첫 프레임을 풀어 msg_id+payload를 `out`에 쓰고 길이를 반환 (CRC 오류면 -1)
+static int decode_captured_frame(uint8_t *out)
+{
+    CHECK(host_uart_capture_len >= 2);
+    CHECK_EQ(host_uart_capture[0], 0x00);
+    size_t end = 1;
+    while (end < host_uart_capture_len && host_uart_capture[end] != 0x00)
+    {
+        end++;
+    }
+    CHECK_EQ(end, host_uart_capture_len - 1);
+
+    int n = cobs_decode(&host_uart_capture[1], end - 1, out);
+    if (n < 3 || crc16(out, n - 2) != (uint16_t)(out[n - 2] << 8 | out[n - 1]))
+    {
+        return -1;
+    }
+    return n - 2;
+}
+
+static void test_frame_with_zeros_round_trips(void)
+{
+    const uint8_t payload[] = {0x00, 0x11, 0x00, 0x00, 0x22, 0xFF, 0x00};
+    uint8_t decoded[600];
+
+    U2C_init();
+    CHECK_EQ(U2C_send_frame(0x42, payload, sizeof(payload)), HAL_OK);
+    drain();
+
+    CHECK(memchr(&host_uart_capture[1], 0x00, host_uart_capture_len - 2) == NULL);  // 구분자 외에는 0x00 없음
+    CHECK_EQ(decode_captured_frame(decoded), 1 + sizeof(payload));
+    CHECK_EQ(decoded[0], 0x42);
+    CHECK(memcmp(&decoded[1], payload, sizeof(payload)) == 0);
+}
+
+static void test_long_frame_splits_cobs_blocks(void)
+{
+    // 0x00이 없는 254바이트 이상 데이터는 0xFF 블록으로 나뉨
+    static uint8_t payload[300];
+    uint8_t decoded[600];
+
+    for (size_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = (uint8_t)(1 + i % 200);
+    }
+    U2C_init();
+    CHECK_EQ(U2C_send_frame(0x07, payload, sizeof(payload)), HAL_OK);
+    drain();
+
+    CHECK_EQ(host_uart_capture[1], 0xFF);
+    CHECK_EQ(decode_captured_frame(decoded), 1 + sizeof(payload));
+    CHECK(memcmp(&decoded[1], payload, sizeof(payload)) == 0);
+}
+
+static uint8_t rx_msg_id;
+static uint8_t rx_payload[U2C_FRAME_MAX_PAYLOAD];
+static uint16_t rx_length;
+static int rx_count;
+
+static void on_frame(uint8_t msg_id, const uint8_t *payload, uint16_t length)
+{
+    rx_msg_id = msg_id;
+    rx_length = length;
+    memcpy(rx_payload, payload, length);
+    rx_count++;
+}
+
+static void test_sent_frame_is_received_back(void)
+{
+    const uint8_t payload[] = {0x10, 0x00, 0x20, 0x00};
+    static uint8_t wire[64];
+    U2C_RxStats stats;
+
+    U2C_init();
+    U2C_register_frame_handler(on_frame);
+    CHECK_EQ(U2C_send_frame(0x31, payload, sizeof(payload)), HAL_OK);
+    drain();
+    uint32_t wire_length = host_uart_capture_len;
+    memcpy(wire, host_uart_capture, wire_length);
+
+    U2C_set_mode(U2C_MODE_BINARY);
+    HOST_UART_Receive(&huart2, wire, (uint16_t)wire_length);
+    U2C_process();
+
+    CHECK_EQ(rx_count, 1);
+    CHECK_EQ(rx_msg_id, 0x31);
+    CHECK_EQ(rx_length, sizeof(payload));
+    CHECK(memcmp(rx_payload, payload, sizeof(payload)) == 0);
+
+    // 한 바이트가 깨진 프레임은 CRC 오류로 버려짐
+    wire[3] ^= 0x01;
+    HOST_UART_Receive(&huart2, wire, (uint16_t)wire_length);
+    U2C_process();
+    U2C_get_rx_stats(&stats);
+    CHECK_EQ(rx_count, 1);
+    CHECK_EQ(stats.frame_errors, 1);
+
+    U2C_set_mode(U2C_MODE_TEXT);
+    drain();
+}
+
+int main(void)
+{
+    RUN_TEST(test_frame_with_zeros_round_trips);
+    RUN_TEST(test_long_frame_splits_cobs_blocks);
+    RUN_TEST(test_sent_frame_is_received_back);
+    return TEST_EXIT();
+}
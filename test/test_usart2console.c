@@ -0,0 +1,776 @@
+/*
+ * test_usart2console.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: UOS
+ *
+ * usart2console: 송신 링 버퍼, 텍스트 커맨드, 수신 방식(1바이트 IT / U2C_RX_USE_DMA)별 인터럽트 수와 손실
+ * (드라이버 상태는 테스트끼리 이어지므로 각 테스트는 송신이 끝날 때까지 drain()으로 기다림)
+ * test_usart2console_dma, test_usart2console_deferred는 같은 파일을 U2C_RX_USE_DMA, U2C_LOG_DEFERRED로 빌드한 것
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_test.h"
+#include "usart2console.h"
+
+// 송신 링 버퍼가 빌 때까지 시간을 진행하고 U2C_process를 호출
+// (U2C_LOG_DEFERRED에서는 큐의 로그가 U2C_process에서 포맷되므로 먼저 한 번 호출)
+static void drain(void)
+{
+    U2C_process();
+    for (int i = 0; i < 1000 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+    {
+        HOST_Advance_us(1000);
+        U2C_process();
+    }
+}
+
+// 지금까지 송신된 바이트가 `expected`와 같은지
+static int captured(const char *expected)
+{
+    size_t length = strlen(expected);
+    return host_uart_capture_len == length && memcmp(host_uart_capture, expected, length) == 0;
+}
+
+static void test_print_is_sent_in_order(void)
+{
+    U2C_init();
+    CHECK_EQ(U2C_print((uint8_t *)"abc", 3), HAL_OK);
+    CHECK_EQ(U2C_println((uint8_t *)"de", 2), HAL_OK);
+    drain();
+    CHECK(captured("abcde\r\n"));
+}
+
+static void test_full_buffer_drops_whole_message(void)
+{
+    static uint8_t block[U2C_TX_BUFFER_SIZE];
+    U2C_TxStats before;
+    U2C_TxStats after;
+
+    memset(block, 'x', sizeof(block));
+    U2C_init();
+    U2C_get_tx_stats(&before);
+
+    CHECK_EQ(U2C_print(block, U2C_TX_BUFFER_SIZE - 1), HAL_OK);
+    CHECK_EQ(U2C_get_tx_free(), 0);  // DMA가 시작됐어도 전송이 끝나야 공간이 돌아옴
+    CHECK_EQ(U2C_print((uint8_t *)"yz", 2), HAL_BUSY);
+
+    U2C_get_tx_stats(&after);
+    CHECK_EQ(after.bytes_dropped - before.bytes_dropped, 2);
+    CHECK_EQ(after.high_water, U2C_TX_BUFFER_SIZE - 1);
+
+    drain();
+    CHECK_EQ(host_uart_capture_len, U2C_TX_BUFFER_SIZE - 1);
+    CHECK(memchr(host_uart_capture, 'y', host_uart_capture_len) == NULL);
+}
+
+// 3바이트 메시지 i번 (순서 확인용으로 메시지마다 다름)
+static void stress_message(int i, char *line)
+{
+    line[0] = (char)('A' + i % 26);
+    line[1] = (char)('0' + i % 10);
+    line[2] = (char)('a' + i % 7);
+}
+
+static void test_wraparound_keeps_byte_order(void)
+{
+    // 10000개 메시지(30000바이트)로 링 버퍼를 수십 바퀴 돌림: 공간이 생길 때까지 기다리며 연속으로 넣으면 잃는 바이트 없음
+    enum { MESSAGES = 10000 };
+    static char expected[MESSAGES * 3];
+    size_t expected_length = 0;
+    char line[3];
+    U2C_TxStats before;
+    U2C_TxStats stats;
+
+    U2C_init();
+    U2C_get_tx_stats(&before);
+    uint64_t start = HOST_Now_us();
+    for (int i = 0; i < MESSAGES; i++)
+    {
+        stress_message(i, line);
+        while (U2C_get_tx_free() < 3)
+        {
+            HOST_Advance_us(10);
+        }
+        CHECK_EQ(U2C_print((uint8_t *)line, 3), HAL_OK);
+        memcpy(&expected[expected_length], line, 3);
+        expected_length += 3;
+    }
+    drain();
+    uint64_t elapsed = HOST_Now_us() - start;
+    U2C_get_tx_stats(&stats);
+
+    printf("back-to-back: %d messages, %lu bytes in %.3f s = %.0f B/s (line %lu B/s), %lu dropped, high water %u/%u\n",
+           MESSAGES, (unsigned long)host_uart_capture_len, elapsed / 1e6, host_uart_capture_len * 1e6 / elapsed,
+           (unsigned long)(huart2.Init.BaudRate / 10), (unsigned long)(stats.bytes_dropped - before.bytes_dropped),
+           stats.high_water, U2C_TX_BUFFER_SIZE - 1);
+    CHECK_EQ(host_uart_capture_len, expected_length);
+    CHECK(memcmp(host_uart_capture, expected, expected_length) == 0);
+    CHECK_EQ(stats.bytes_dropped, before.bytes_dropped);
+    CHECK(host_uart_capture_len * 1000000ull / elapsed >= huart2.Init.BaudRate / 10 * 95 / 100);  // 선로 속도의 95% 이상
+
+    // 기다리지 않고 50us마다 넣으면 (선로 속도의 약 5배) 넘친 메시지는 통째로 버려지고, 들어간 메시지는 순서대로 나감
+    host_uart_capture_len = 0;
+    expected_length = 0;
+    before = stats;
+    int accepted = 0;
+    for (int i = 0; i < MESSAGES; i++)
+    {
+        stress_message(i, line);
+        if (U2C_print((uint8_t *)line, 3) == HAL_OK)
+        {
+            memcpy(&expected[expected_length], line, 3);
+            expected_length += 3;
+            accepted++;
+        }
+        HOST_Advance_us(50);
+    }
+    drain();
+    U2C_get_tx_stats(&stats);
+
+    printf("every 50 us: %d of %d messages sent, %lu bytes dropped\n", accepted, MESSAGES,
+           (unsigned long)(stats.bytes_dropped - before.bytes_dropped));
+    CHECK_EQ(host_uart_capture_len, expected_length);
+    CHECK(memcmp(host_uart_capture, expected, expected_length) == 0);
+    CHECK_EQ(stats.bytes_dropped - before.bytes_dropped, (uint32_t)(MESSAGES - accepted) * 3);
+    CHECK(accepted > MESSAGES / 6 && accepted < MESSAGES / 4);
+}
+
+static void test_print_keeps_interrupts_masked(void)
+{
+    // 임계 구역 안에서 출력해도 tx_commit이 인터럽트를 다시 켜면 안 됨
+    U2C_init();
+    __disable_irq();
+    CHECK_EQ(U2C_print((uint8_t *)"ab", 2), HAL_OK);
+    CHECK_EQ(__get_PRIMASK(), 1);
+    __enable_irq();
+    drain();
+    CHECK(captured("ab"));
+}
+
+static void test_logf_prefix_at_tick_zero(void)
+{
+    // tick 0에서도 "[0] "이 붙어야 함 (BOARD_Init 직후 uwTick == 0)
+    U2C_init();
+    CHECK_EQ(HAL_GetTick(), 0);
+    CHECK_EQ(U2C_logf("boot %d", 7), HAL_OK);
+    drain();
+    CHECK(captured("[0] boot 7\r\n"));
+}
+
+static void test_printf_too_long_counts_dropped_bytes(void)
+{
+    static uint8_t block[U2C_TX_BUFFER_SIZE];
+    U2C_TxStats before;
+    U2C_TxStats after;
+
+    memset(block, 'x', sizeof(block));
+    U2C_init();
+    CHECK_EQ(U2C_print(block, U2C_TX_BUFFER_SIZE - 1 - 4), HAL_OK);
+    U2C_get_tx_stats(&before);
+    CHECK_EQ(U2C_printf("%s-%u", "abcd", 123u), HAL_BUSY);  // 8바이트, 공간은 4바이트
+    U2C_get_tx_stats(&after);
+    CHECK_EQ(after.bytes_dropped - before.bytes_dropped, 8);
+    drain();
+    CHECK_EQ(host_uart_capture_len, U2C_TX_BUFFER_SIZE - 1 - 4);
+}
+
+static int echo_argc = 0;
+static int echo_calls = 0;
+static char echo_arg1[16];
+
+static void cmd_echo(int argc, char *argv[])
+{
+    echo_argc = argc;
+    echo_calls++;
+    if (argc > 1)
+    {
+        strncpy(echo_arg1, argv[1], sizeof(echo_arg1) - 1);
+    }
+}
+
+static void test_text_command_is_dispatched(void)
+{
+    U2C_init();
+    CHECK_EQ(U2C_register_command("echo", cmd_echo, "test"), HAL_OK);
+
+    HOST_UART_Receive(&huart2, (const uint8_t *)"echo hi 2\r", 10);
+    U2C_process();
+    drain();
+
+    CHECK_EQ(echo_argc, 3);
+    CHECK(strcmp(echo_arg1, "hi") == 0);
+    CHECK(host_uart_capture_len >= 9 && memcmp(host_uart_capture, "echo hi 2", 9) == 0);  // 에코
+}
+
+#ifdef U2C_RX_USE_DMA
+#define RX_MODE "DMA"
+#else
+#define RX_MODE "IT"
+#endif
+
+static int rx_hook_calls = 0;
+
+static void count_rx_hook(void)
+{
+    rx_hook_calls++;
+}
+
+static void test_rx_hook_per_burst(void)
+{
+    // IT 수신은 바이트마다, DMA 수신은 짧은 입력이 끝나고 IDLE 라인이 될 때 한 번
+    U2C_init();
+    U2C_set_rx_hook(count_rx_hook);
+    rx_hook_calls = 0;
+    uint32_t irqs = host_uart_rx_irqs;
+
+    HOST_UART_Feed(&huart2, (const uint8_t *)"echo x\r", 7);
+    HOST_Advance_us(7 * 87 + 10);  // 마지막 바이트 도착 직후 (IDLE 전)
+#ifdef U2C_RX_USE_DMA
+    CHECK_EQ(rx_hook_calls, 0);
+    CHECK_EQ(__HAL_DMA_GET_COUNTER(huart2.hdmarx), U2C_RX_BUFFER_SIZE - 7);
+#else
+    CHECK_EQ(rx_hook_calls, 7);
+#endif
+    HOST_Advance_us(200);
+#ifdef U2C_RX_USE_DMA
+    CHECK_EQ(rx_hook_calls, 1);
+#else
+    CHECK_EQ(rx_hook_calls, 7);
+#endif
+    CHECK_EQ(host_uart_rx_irqs - irqs, rx_hook_calls);
+
+    U2C_process();
+    drain();
+    CHECK_EQ(echo_argc, 2);
+    CHECK(strcmp(echo_arg1, "x") == 0);
+    U2C_set_rx_hook(NULL);
+}
+
+#ifdef U2C_RX_USE_DMA
+// 한 줄을 받고 처리한 뒤, 에코가 다 나갈 때까지 기다림
+static void receive_line(const char *line)
+{
+    HOST_UART_Receive(&huart2, (const uint8_t *)line, (uint16_t)strlen(line));
+    U2C_process();
+    drain();
+}
+
+static void test_dma_wraparound(void)
+{
+    // 9바이트 줄 20개 = 180바이트: circular 버퍼(64바이트)를 몇 바퀴 돌아도 줄이 그대로 처리됨
+    char line[16];
+    U2C_RxStats stats;
+
+    U2C_init();
+    int calls = echo_calls;
+    for (int i = 0; i < 20; i++)
+    {
+        snprintf(line, sizeof(line), "echo a%02d\r", i);
+        receive_line(line);
+        CHECK_EQ(echo_calls, calls + i + 1);
+        CHECK(strncmp(echo_arg1, line + 5, 3) == 0 && echo_arg1[3] == '\0');
+    }
+    U2C_get_rx_stats(&stats);
+    CHECK_EQ(stats.bytes_dropped, 0);
+    CHECK_EQ(stats.errors, 0);
+    CHECK_EQ(host_uart_rx_lost, 0);
+    CHECK_EQ(__HAL_DMA_GET_COUNTER(huart2.hdmarx), U2C_RX_BUFFER_SIZE - 180 % U2C_RX_BUFFER_SIZE);
+}
+
+static void test_dma_ring_overflow_resyncs(void)
+{
+    static uint8_t burst[100];
+    U2C_RxStats before;
+    U2C_RxStats after;
+
+    U2C_init();
+    U2C_get_rx_stats(&before);
+    int calls = echo_calls;
+
+    // U2C_process 없이 100바이트: 버퍼 끝 이벤트에서 읽지 않은 64바이트가 덮어써진 것을 감지하고 건너뜀
+    memset(burst, 'x', sizeof(burst));
+    HOST_UART_Receive(&huart2, burst, sizeof(burst));
+    U2C_get_rx_stats(&after);
+    CHECK_EQ(after.bytes_dropped - before.bytes_dropped, 64);
+
+    receive_line("\recho ov\r");
+    CHECK_EQ(echo_calls, calls + 1);
+    CHECK(strcmp(echo_arg1, "ov") == 0);
+}
+
+static void test_dma_framing_error_keeps_dma_position(void)
+{
+    U2C_RxStats before;
+    U2C_RxStats after;
+
+    U2C_init();
+    U2C_get_rx_stats(&before);
+    receive_line("echo q1\r");
+    int calls = echo_calls;
+
+    // 줄 중간에 framing 에러: HAL은 circular DMA를 멈추지 않음 (RxState는 BUSY_RX)
+    HOST_UART_Receive(&huart2, (const uint8_t *)"echo zz", 7);
+    U2C_process();
+    HOST_UART_RxError(&huart2, HAL_UART_ERROR_FE);
+    CHECK_EQ(huart2.RxState, HAL_UART_STATE_BUSY_RX);
+    CHECK_EQ(__HAL_DMA_GET_COUNTER(huart2.hdmarx), U2C_RX_BUFFER_SIZE - 15);
+
+    // 깨진 줄은 버리고 다음 줄부터: 버퍼 처음부터 다시 읽으면 "echo q1"이 한 번 더 실행됨
+    receive_line("\recho q2\r");
+    CHECK_EQ(echo_calls, calls + 1);
+    CHECK(strcmp(echo_arg1, "q2") == 0);
+    CHECK_EQ(__HAL_DMA_GET_COUNTER(huart2.hdmarx), U2C_RX_BUFFER_SIZE - 24);
+
+    U2C_get_rx_stats(&after);
+    CHECK_EQ(after.errors - before.errors, 1);
+}
+
+static void test_dma_overrun_restarts_reception(void)
+{
+    U2C_RxStats before;
+    U2C_RxStats after;
+
+    U2C_init();
+    U2C_get_rx_stats(&before);
+    receive_line("echo r1\r");
+    int calls = echo_calls;
+
+    // overrun: HAL이 수신을 중단하므로 버퍼 처음부터 다시 시작
+    HOST_UART_RxError(&huart2, HAL_UART_ERROR_ORE);
+    CHECK_EQ(huart2.RxState, HAL_UART_STATE_BUSY_RX);
+    CHECK_EQ(__HAL_DMA_GET_COUNTER(huart2.hdmarx), U2C_RX_BUFFER_SIZE);
+
+    receive_line("echo r2\r");
+    CHECK_EQ(echo_calls, calls + 1);
+    CHECK(strcmp(echo_arg1, "r2") == 0);
+
+    U2C_get_rx_stats(&after);
+    CHECK_EQ(after.errors - before.errors, 1);
+    CHECK_EQ(after.bytes_dropped, before.bytes_dropped);
+}
+#endif
+
+static int frames_ok = 0;
+
+static void count_frame(uint8_t msg_id, const uint8_t *payload, uint16_t length)
+{
+    frames_ok++;
+}
+
+// 프레임 150개(16바이트 payload)를 연속으로 받으며 메인 루프를 흉내냄:
+// 500us마다 U2C_process, 그 사이 20us 동안 인터럽트 차단 (다른 드라이버의 임계 구역)
+static void rx_load(uint32_t baud)
+{
+    enum { FRAMES = 150 };
+    static uint8_t wire[FRAMES * 24];
+    uint8_t payload[16];
+    U2C_RxStats before;
+    U2C_RxStats after;
+
+    huart2.Init.BaudRate = baud;
+    U2C_init();
+    U2C_register_frame_handler(count_frame);
+
+    // U2C_send_frame 출력을 그대로 수신할 바이트로 사용
+    for (int i = 0; i < FRAMES; i++)
+    {
+        for (int k = 0; k < 16; k++)
+        {
+            payload[k] = (uint8_t)(i + k);
+        }
+        CHECK_EQ(U2C_send_frame(0x10, payload, sizeof(payload)), HAL_OK);
+        drain();
+    }
+    uint32_t length = host_uart_capture_len;
+    CHECK(length <= sizeof(wire));
+    memcpy(wire, host_uart_capture, length);
+
+    U2C_set_mode(U2C_MODE_BINARY);
+    U2C_get_rx_stats(&before);
+    frames_ok = 0;
+    uint32_t irqs = host_uart_rx_irqs;
+    uint32_t lost = host_uart_rx_lost;
+
+    HOST_UART_Feed(&huart2, wire, (uint16_t)length);
+    uint32_t loops = (uint32_t)((uint64_t)length * 10u * 1000000u / baud / 500u) + 4;
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        U2C_process();
+        __disable_irq();
+        HOST_Advance_us(20);
+        __enable_irq();
+        HOST_Advance_us(480);
+    }
+    U2C_process();
+
+    U2C_get_rx_stats(&after);
+    irqs = host_uart_rx_irqs - irqs;
+    lost = host_uart_rx_lost - lost;
+    printf("%-3s %6lu bps: %lu bytes, %lu rx irqs (%.2f/byte), %lu lost on line, %lu dropped in ring, "
+           "%lu errors, %d/%d frames\n",
+           RX_MODE, (unsigned long)baud, (unsigned long)length, (unsigned long)irqs, (double)irqs / length,
+           (unsigned long)lost, (unsigned long)(after.bytes_dropped - before.bytes_dropped),
+           (unsigned long)(after.errors - before.errors), frames_ok, FRAMES);
+
+#ifdef U2C_RX_USE_DMA
+    // DMA가 바이트를 옮기므로 인터럽트 차단 중에도 잃지 않고, 인터럽트는 버퍼 절반/IDLE마다
+    CHECK_EQ(lost, 0);
+    CHECK_EQ(frames_ok, FRAMES);
+    CHECK(irqs <= length / (U2C_RX_BUFFER_SIZE / 2) + 2);
+#else
+    // 바이트마다 인터럽트, 차단 시간(20us)보다 바이트 시간이 짧으면 overrun으로 잃음
+    CHECK(irqs >= length);
+    if (baud <= 460800)
+    {
+        CHECK_EQ(lost, 0);
+        CHECK_EQ(frames_ok, FRAMES);
+    }
+    else
+    {
+        CHECK(lost > 0);
+        CHECK(frames_ok < FRAMES);
+        CHECK(after.errors > before.errors);
+    }
+#endif
+
+    U2C_set_mode(U2C_MODE_TEXT);
+    U2C_register_frame_handler(NULL);
+    drain();
+}
+
+static void test_rx_load_115200(void)
+{
+    rx_load(115200);
+}
+
+static void test_rx_load_460800(void)
+{
+    rx_load(460800);
+}
+
+static void test_rx_load_921600(void)
+{
+    rx_load(921600);
+}
+
+// strcmp 호출 수 (CMakeLists.txt에서 -Wl,--wrap=strcmp로 링크하여 드라이버의 호출도 셈)
+static uint32_t strcmp_calls = 0;
+
+int __real_strcmp(const char *a, const char *b);
+
+int __wrap_strcmp(const char *a, const char *b)
+{
+    strcmp_calls++;
+    return __real_strcmp(a, b);
+}
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int bench_calls = 0;
+
+static void cmd_bench(int argc, char *argv[])
+{
+    bench_calls++;
+}
+
+// 비교 대상: 등록 순서대로 strcmp를 잇는 if/else 체인
+static const char *chain_names[U2C_MAX_COMMANDS];
+static int chain_count = 0;
+
+static int chain_find(const char *name)
+{
+    for (int i = 0; i < chain_count; i++)
+    {
+        if (strcmp(name, chain_names[i]) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void test_dispatch_binary_search_vs_strcmp_chain(void)
+{
+    // 커맨드 테이블을 U2C_MAX_COMMANDS(64)개까지 채움 (내장 help, binmode와 앞 테스트의 echo 포함)
+    enum { REPEAT = 20 };
+    static char names[U2C_MAX_COMMANDS][12];
+    char line[12];
+
+    huart2.Init.BaudRate = 921600;  // 에코가 다음 줄 전에 나가도록
+    U2C_init();
+    chain_names[chain_count++] = "help";
+    chain_names[chain_count++] = "binmode";
+    chain_names[chain_count++] = "echo";
+    for (int i = 0; chain_count < U2C_MAX_COMMANDS; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "c%02d", i);
+        CHECK_EQ(U2C_register_command(names[i], cmd_bench, NULL), HAL_OK);
+        chain_names[chain_count++] = names[i];
+    }
+    CHECK_EQ(U2C_register_command("full", cmd_bench, NULL), HAL_ERROR);
+
+    // help/binmode는 출력/모드가 바뀌므로 echo와 cNN만 실행
+    uint32_t bsearch_max = 0;
+    uint64_t bsearch_total = 0;
+    uint64_t chain_total = 0;
+    uint64_t process_ns = 0;
+    uint64_t chain_ns;
+    int lines = 0;
+    for (int k = 2; k < chain_count; k++)
+    {
+        const char *name = chain_names[k];
+        int length = snprintf(line, sizeof(line), "%s\r", name);
+        for (int r = 0; r < REPEAT; r++)
+        {
+            HOST_UART_Receive(&huart2, (const uint8_t *)line, (uint16_t)length);
+            uint32_t before = strcmp_calls;
+            uint64_t t0 = wall_ns();
+            U2C_process();
+            process_ns += wall_ns() - t0;
+            uint32_t compares = strcmp_calls - before;
+            bsearch_total += compares;
+            bsearch_max = compares > bsearch_max ? compares : bsearch_max;
+            HOST_Advance_us(200);
+
+            before = strcmp_calls;
+            CHECK_EQ(chain_find(name), k);
+            chain_total += strcmp_calls - before;
+            lines++;
+        }
+    }
+    drain();
+
+    // 체인은 한 번이 시계 해상도보다 짧으므로 여러 번 반복해 평균
+    uint64_t t0 = wall_ns();
+    for (int r = 0; r < 1000; r++)
+    {
+        for (int k = 2; k < chain_count; k++)
+        {
+            CHECK(chain_find(chain_names[k]) == k);
+        }
+    }
+    chain_ns = wall_ns() - t0;
+
+    printf("%d commands: binary search %.1f strcmp/dispatch (max %lu), strcmp chain %.1f (max %d)\n",
+           chain_count, (double)bsearch_total / lines, (unsigned long)bsearch_max, (double)chain_total / lines,
+           chain_count);
+    printf("host: U2C_process (echo + tokenize + binary search) %.0f ns/line, strcmp chain lookup alone %.0f ns\n",
+           (double)process_ns / lines, (double)chain_ns / (1000.0 * (chain_count - 2)));
+    CHECK_EQ(bench_calls + REPEAT, lines);  // echo 외에는 모두 cmd_bench
+    CHECK(bsearch_max <= 7);                 // log2(64) + 1
+    CHECK(chain_total > bsearch_total * 4);
+}
+
+#ifdef U2C_LOG_DEFERRED
+static void test_deferred_log_queue_overflow(void)
+{
+    // 큐 16칸 중 15칸까지 (한 칸은 비워 둠): 넘친 호출은 HAL_BUSY와 logs_dropped, 들어간 로그는 순서대로
+    U2C_TxStats before;
+    U2C_TxStats after;
+    char expected[512];
+    size_t length = 0;
+
+    U2C_init();
+    U2C_get_tx_stats(&before);
+    for (int i = 0; i < 20; i++)
+    {
+        HAL_StatusTypeDef status = U2C_logf("n=%d", i);
+        CHECK_EQ(status, i < U2C_LOG_QUEUE_SIZE - 1 ? HAL_OK : HAL_BUSY);
+        if (status == HAL_OK)
+        {
+            length += snprintf(&expected[length], sizeof(expected) - length, "[0] n=%d\r\n", i);
+        }
+    }
+    CHECK_EQ(host_uart_capture_len, 0);  // U2C_process 전에는 포맷하지 않음
+    U2C_get_tx_stats(&after);
+    CHECK_EQ(after.logs_dropped - before.logs_dropped, 20 - (U2C_LOG_QUEUE_SIZE - 1));
+
+    drain();
+    CHECK(captured(expected));
+    CHECK_EQ(U2C_logf("again"), HAL_OK);
+    drain();
+}
+
+static uint32_t isr_logs = 0;
+static uint32_t isr_logs_ok = 0;
+static uint8_t isr_touched_tx = 0;
+
+// 수신 인터럽트 안에서 로그 (rx hook)
+static void log_from_isr(void)
+{
+    uint16_t free_before = U2C_get_tx_free();
+    if (U2C_logf("isr %lu", (unsigned long)isr_logs++) == HAL_OK)
+    {
+        isr_logs_ok++;
+    }
+    isr_touched_tx |= (U2C_get_tx_free() != free_before);
+}
+
+// 줄 `line`이 "[tick] <prefix> <n>" 형식이면 n을, 아니면 -1을 반환
+static long parse_log_line(const char *line, const char *prefix)
+{
+    const char *p = strchr(line, ']');
+    size_t n = strlen(prefix);
+    if (line[0] != '[' || p == NULL || p[1] != ' ' || strncmp(p + 2, prefix, n) != 0 || p[2 + n] != ' ')
+    {
+        return -1;
+    }
+    return strtol(p + 3 + n, NULL, 10);
+}
+
+static void test_deferred_log_from_isr_keeps_order(void)
+{
+    // 메인 루프의 로그와 수신 인터럽트의 로그가 섞여도 줄이 깨지지 않고, 각자의 순서가 유지됨
+    static uint8_t burst[40];
+    static char text[4096];
+    uint32_t main_logs_ok = 0;
+
+    U2C_init();
+    U2C_set_mode(U2C_MODE_BINARY);  // 받은 바이트는 에코 없이 버려짐
+    U2C_set_rx_hook(log_from_isr);
+    memset(burst, 0x55, sizeof(burst));
+    HOST_UART_Feed(&huart2, burst, sizeof(burst));
+
+    for (uint32_t i = 0; i < 60; i++)
+    {
+        if (U2C_logf("main %lu", (unsigned long)i) == HAL_OK)
+        {
+            main_logs_ok++;
+        }
+        HOST_Advance_us(60);
+        U2C_process();
+    }
+    for (int i = 0; i < 1000 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+    {
+        HOST_Advance_us(1000);
+        U2C_process();
+    }
+    U2C_set_rx_hook(NULL);
+    U2C_set_mode(U2C_MODE_TEXT);
+
+    CHECK_EQ(isr_logs, sizeof(burst));
+    CHECK_EQ(isr_touched_tx, 0);  // 인터럽트 안에서는 송신 링 버퍼를 건드리지 않음
+    CHECK(host_uart_capture_len < sizeof(text));
+    memcpy(text, host_uart_capture, host_uart_capture_len);
+    text[host_uart_capture_len] = '\0';
+
+    long next_main = 0;
+    long next_isr = 0;
+    uint32_t main_lines = 0;
+    uint32_t isr_lines = 0;
+    for (char *line = strtok(text, "\r\n"); line != NULL; line = strtok(NULL, "\r\n"))
+    {
+        long n;
+        if ((n = parse_log_line(line, "main")) >= 0)
+        {
+            CHECK(n >= next_main);
+            next_main = n + 1;
+            main_lines++;
+        }
+        else if ((n = parse_log_line(line, "isr")) >= 0)
+        {
+            CHECK(n >= next_isr);
+            next_isr = n + 1;
+            isr_lines++;
+        }
+        else
+        {
+            CHECK(!"broken log line");
+        }
+    }
+    CHECK_EQ(main_lines, main_logs_ok);
+    CHECK_EQ(isr_lines, isr_logs_ok);
+    CHECK(isr_lines > 0 && main_lines > 0);
+}
+
+static void test_deferred_log_cost_vs_snprintf(void)
+{
+    // 호출한 쪽의 시간: 큐에 넣기만 하는 U2C_logf와 snprintf로 포맷
+    // (PC에서 측정하므로 보드와 절대값은 다르고, U2C_logf에는 시뮬레이션 PRIMASK 처리 시간도 들어감)
+    enum { ROUNDS = 2000, BATCH = 8 };  // 한 번의 U2C_process로 송신 링 버퍼에 모두 들어가는 양
+    char buf[96];
+    uint64_t logf_ns = 0;
+    uint64_t flush_ns = 0;
+    uint64_t snprintf_ns = 0;
+
+    U2C_TxStats before;
+    U2C_TxStats after;
+
+    huart2.Init.BaudRate = 921600;
+    U2C_init();
+    U2C_get_tx_stats(&before);
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        uint64_t t0 = wall_ns();
+        for (int i = 0; i < BATCH; i++)
+        {
+            U2C_logf("adc %u temp %d state %s err %x", (unsigned)(r + i), -r, "run", (unsigned)i);
+        }
+        logf_ns += wall_ns() - t0;
+
+        t0 = wall_ns();
+        for (int i = 0; i < BATCH; i++)
+        {
+            snprintf(buf, sizeof(buf), "[%lu] adc %u temp %d state %s err %x\r\n", (unsigned long)HAL_GetTick(),
+                     (unsigned)(r + i), -r, "run", (unsigned)i);
+        }
+        snprintf_ns += wall_ns() - t0;
+
+        // 포맷은 U2C_process에서 (송신 링 버퍼가 넘치지 않도록 매번 비움)
+        t0 = wall_ns();
+        U2C_process();
+        flush_ns += wall_ns() - t0;
+        host_uart_capture_len = 0;
+        for (int i = 0; i < 100 && U2C_get_tx_free() < U2C_TX_BUFFER_SIZE - 1; i++)
+        {
+            HOST_Advance_us(100);
+        }
+    }
+    double calls = (double)ROUNDS * BATCH;
+    printf("per log call: U2C_logf (deferred enqueue) %.0f ns, snprintf %.0f ns, "
+           "later formatted in U2C_process %.0f ns\n",
+           logf_ns / calls, snprintf_ns / calls, flush_ns / calls);
+
+    // 시간은 PC 부하에 따라 달라지므로 출력만 하고, 모든 로그가 포맷됐는지만 확인
+    U2C_get_tx_stats(&after);
+    CHECK_EQ(after.logs_dropped, before.logs_dropped);
+    CHECK_EQ(after.bytes_dropped, before.bytes_dropped);
+}
+#endif
+
+int main(void)
+{
+    RUN_TEST(test_print_is_sent_in_order);
+    RUN_TEST(test_full_buffer_drops_whole_message);
+    RUN_TEST(test_wraparound_keeps_byte_order);
+    RUN_TEST(test_print_keeps_interrupts_masked);
+    RUN_TEST(test_logf_prefix_at_tick_zero);
+    RUN_TEST(test_printf_too_long_counts_dropped_bytes);
+    RUN_TEST(test_text_command_is_dispatched);
+    RUN_TEST(test_rx_hook_per_burst);
+#ifdef U2C_RX_USE_DMA
+    RUN_TEST(test_dma_wraparound);
+    RUN_TEST(test_dma_ring_overflow_resyncs);
+    RUN_TEST(test_dma_framing_error_keeps_dma_position);
+    RUN_TEST(test_dma_overrun_restarts_reception);
+#endif
+    RUN_TEST(test_rx_load_115200);
+    RUN_TEST(test_rx_load_460800);
+    RUN_TEST(test_rx_load_921600);
+    RUN_TEST(test_dispatch_binary_search_vs_strcmp_chain);
+#ifdef U2C_LOG_DEFERRED
+    RUN_TEST(test_deferred_log_queue_overflow);
+    RUN_TEST(test_deferred_log_from_isr_keeps_order);
+    RUN_TEST(test_deferred_log_cost_vs_snprintf);
+#endif
+    return TEST_EXIT();
+}
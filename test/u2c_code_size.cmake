@@ -0,0 +1,55 @@
+# u2c_code_size.cmake
+#   usart2console의 자체 포맷 함수 크기와 snprintf를 링크했을 때 늘어나는 크기를 비교
+#   cmake -DNM=<nm> -DSIZE=<size> -DTEST_EXE=<test_usart2console_deferred> -DLIBC=<libc.a> -P u2c_code_size.cmake
+#   (PC(x86-64, glibc, 최적화 없음) 크기이므로 보드(newlib-nano)와 절대값은 다르고, 비교용)
+
+set(format_symbols
+    parse_format_spec capture_format_args format_putc format_padded format_unsigned format_to_tx
+    U2C_printf U2C_logf flush_log_queue)
+
+execute_process(COMMAND ${NM} -S --defined-only ${TEST_EXE} OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "nm failed: ${result}")
+endif()
+
+set(format_total 0)
+string(REPLACE "\n" ";" lines "${symbols}")
+foreach(name ${format_symbols})
+    set(found 0)
+    foreach(line ${lines})
+        if(line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [tT] ${name}$")
+            math(EXPR bytes "0x${CMAKE_MATCH_1}")
+            math(EXPR format_total "${format_total} + ${bytes}")
+            set(found 1)
+        endif()
+    endforeach()
+    if(NOT found)
+        message(FATAL_ERROR "symbol ${name} not found in ${TEST_EXE}")
+    endif()
+endforeach()
+
+# snprintf가 끌어오는 libc.a 오브젝트 (size 출력: text data bss dec hex filename)
+set(snprintf_members snprintf.o vsnprintf.o vfprintf-internal.o printf_fp.o printf_fphex.o printf-parsemb.o)
+execute_process(COMMAND ${SIZE} ${LIBC} OUTPUT_VARIABLE sizes ERROR_QUIET RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "size failed for ${LIBC}")
+endif()
+set(snprintf_total 0)
+string(REPLACE "\n" ";" lines "${sizes}")
+foreach(member ${snprintf_members})
+    foreach(line ${lines})
+        if(line MATCHES "^[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+[0-9]+[ \t]+[0-9]+[ \t]+[0-9a-f]+[ \t]+${member} ")
+            math(EXPR snprintf_total "${snprintf_total} + ${CMAKE_MATCH_1} + ${CMAKE_MATCH_2}")
+        endif()
+    endforeach()
+endforeach()
+
+message("usart2console formatter (U2C_printf/U2C_logf + deferred queue): ${format_total} bytes")
+string(REPLACE ";" " " members "${snprintf_members}")
+message("snprintf from ${LIBC} (${members}): ${snprintf_total} bytes")
+if(snprintf_total EQUAL 0)
+    message(FATAL_ERROR "no snprintf objects found in ${LIBC}")
+endif()
+if(NOT format_total LESS snprintf_total)
+    message(FATAL_ERROR "formatter is not smaller than snprintf")
+endif()